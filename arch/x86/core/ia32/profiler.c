@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <kernel_internal.h>
+
+/* Layout of the interrupted thread's stack left by _interrupt_enter: the
+ * registers pushed by the stub followed by what the CPU pushed on entry.
+ */
+struct profiler_isf {
+	uint32_t edi;
+	uint32_t ecx;
+	uint32_t edx;
+	uint32_t eax;
+	uint32_t eip;
+	uint32_t cs;
+	uint32_t eflags;
+};
+
+static inline bool on_irq_stack(struct _cpu *cpu, uintptr_t addr)
+{
+	uintptr_t top = (uintptr_t)cpu->irq_stack;
+
+	return (addr < top) && (addr >= (top - CONFIG_ISR_STACK_SIZE));
+}
+
+size_t arch_profiler_backtrace(uintptr_t *pcs, size_t depth)
+{
+	struct _cpu *cpu = arch_curr_cpu();
+	struct profiler_isf *isf;
+	uint32_t *fp;
+	size_t n = 0;
+
+	/* Only the outermost interrupt switches stacks and leaves the
+	 * interrupted stack pointer at the base of the interrupt stack.
+	 */
+	if ((depth == 0) || (cpu->nested != 1)) {
+		return 0;
+	}
+
+	isf = *((struct profiler_isf **)cpu->irq_stack - 1);
+	pcs[n++] = isf->eip;
+
+	/* The stub leaves EBP untouched, so the first frame pointer that is
+	 * not on the interrupt stack belongs to the interrupted function.
+	 */
+	fp = __builtin_frame_address(0);
+	while ((fp != NULL) && on_irq_stack(cpu, (uintptr_t)fp)) {
+		fp = (uint32_t *)fp[0];
+	}
+
+	while ((n < depth) && (fp != NULL)) {
+		uint32_t *next = (uint32_t *)fp[0];
+
+		if (fp[1] == 0U) {
+			break;
+		}
+
+		pcs[n++] = fp[1];
+
+		/* Frames must move up the stack, anything else means the
+		 * chain is broken (or the code has no frame pointers).
+		 */
+		if (next <= fp) {
+			break;
+		}
+
+		fp = next;
+	}
+
+	return n;
+}
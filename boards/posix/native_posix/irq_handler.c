@@ -28,6 +28,13 @@ static isr_table_entry_t irq_vector_table[N_IRQS] = { { 0 } };
 
 static int currently_running_irq = -1;
 
+#ifdef CONFIG_PROFILER
+/* Frame of the outermost posix_irq_handler() call, which runs on the stack
+ * of the interrupted thread.
+ */
+static void **irq_entry_frame;
+#endif
+
 static inline void vector_to_irq(int irq_nbr, int *may_swap)
 {
 	sys_trace_isr_enter();
@@ -78,6 +85,9 @@ void posix_irq_handler(void)
 
 	if (_kernel.cpus[0].nested == 0) {
 		may_swap = 0;
+#ifdef CONFIG_PROFILER
+		irq_entry_frame = __builtin_frame_address(0);
+#endif
 	}
 
 	_kernel.cpus[0].nested++;
@@ -111,6 +121,37 @@ void posix_irq_handler(void)
 	}
 }
 
+#ifdef CONFIG_PROFILER
+/**
+ * Interrupts are only ever taken when the running thread calls into the HW
+ * models, so the interrupted code is found by walking the frame pointer
+ * chain from the outermost posix_irq_handler() call.
+ */
+size_t arch_profiler_backtrace(uintptr_t *pcs, size_t depth)
+{
+	void **fp = irq_entry_frame;
+	size_t n = 0;
+
+	if (_kernel.cpus[0].nested != 1) {
+		return 0;
+	}
+
+	while ((n < depth) && (fp != NULL) && (fp[1] != NULL)) {
+		void **next = (void **)fp[0];
+
+		pcs[n++] = (uintptr_t)fp[1];
+
+		if (next <= fp) {
+			break;
+		}
+
+		fp = next;
+	}
+
+	return n;
+}
+#endif
+
 /**
  * Thru this function the IRQ controller can raise an immediate  interrupt which
  * will interrupt the SW itself
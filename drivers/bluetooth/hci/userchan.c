@@ -244,6 +244,7 @@ static const struct bt_hci_driver drv = {
 	.bus		= BT_HCI_DRIVER_BUS_UART,
 	.open		= uc_open,
 	.send		= uc_send,
+	.quirks		= BT_QUIRK_TX_DATA_COPIED,
 };
 
 static int bt_uc_init(const struct device *unused)
@@ -97,9 +97,16 @@ static const struct disk_operations ram_disk_ops = {
 	.ioctl = disk_ram_access_ioctl,
 };
 
+#if defined(CONFIG_DISK_ACCESS_RTIO)
+DISK_RTIO_IODEV_DEFINE(ram_disk_rtio);
+#endif
+
 static struct disk_info ram_disk = {
 	.name = CONFIG_DISK_RAM_VOLUME_NAME,
 	.ops = &ram_disk_ops,
+#if defined(CONFIG_DISK_ACCESS_RTIO)
+	.rtio = &ram_disk_rtio,
+#endif
 };
 
 static int disk_ram_init(const struct device *dev)
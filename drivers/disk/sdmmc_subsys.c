@@ -105,8 +105,15 @@ static const struct disk_operations sdmmc_disk_ops = {
 	.ioctl = disk_sdmmc_access_ioctl,
 };
 
+#if defined(CONFIG_DISK_ACCESS_RTIO)
+DISK_RTIO_IODEV_DEFINE(sdmmc_disk_rtio);
+#endif
+
 static struct disk_info sdmmc_disk = {
 	.ops = &sdmmc_disk_ops,
+#if defined(CONFIG_DISK_ACCESS_RTIO)
+	.rtio = &sdmmc_disk_rtio,
+#endif
 };
 
 static int disk_sdmmc_init(const struct device *dev)
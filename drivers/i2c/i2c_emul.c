@@ -98,6 +98,28 @@ static int i2c_emul_transfer(const struct device *dev, struct i2c_msg *msgs,
 	return 0;
 }
 
+#ifdef CONFIG_I2C_RTIO
+/* The emulated transfer completes immediately, in the submitting context */
+static void i2c_emul_iodev_submit(const struct device *dev,
+				  const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct i2c_iodev *iodev = (const struct i2c_iodev *)sqe->iodev;
+	struct i2c_msg msgs[CONFIG_I2C_RTIO_TRANSACTION_MAX];
+	int rc;
+
+	rc = i2c_rtio_msgs(r, sqe, msgs, ARRAY_SIZE(msgs));
+	if (rc > 0) {
+		rc = i2c_emul_transfer(dev, msgs, rc, iodev->spec.addr);
+	}
+
+	if (rc < 0) {
+		rtio_sqe_err(r, sqe, rc);
+	} else {
+		rtio_sqe_ok(r, sqe, 0);
+	}
+}
+#endif
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -137,6 +159,9 @@ static struct i2c_driver_api i2c_emul_api = {
 	.configure = i2c_emul_configure,
 	.get_config = i2c_emul_get_config,
 	.transfer = i2c_emul_transfer,
+#ifdef CONFIG_I2C_RTIO
+	.iodev_submit = i2c_emul_iodev_submit,
+#endif
 };
 
 #define EMUL_LINK_AND_COMMA(node_id) {		\
@@ -0,0 +1,91 @@
+/*
+ * I2C targets as RTIO devices
+ *
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/rtio/rtio.h>
+
+int i2c_rtio_msgs(struct rtio *r, const struct rtio_sqe *sqe,
+		  struct i2c_msg *msgs, uint8_t num_msgs)
+{
+	uint8_t n = 0;
+
+	for (; sqe != NULL; sqe = rtio_txn_next(r, sqe)) {
+		uint8_t flags;
+
+		switch (sqe->op) {
+		case RTIO_OP_NOP:
+			continue;
+		case RTIO_OP_TX:
+			flags = I2C_MSG_WRITE;
+			break;
+		case RTIO_OP_RX:
+			flags = I2C_MSG_READ;
+			break;
+		default:
+			return -ENOTSUP;
+		}
+
+		if (n == num_msgs) {
+			return -ENOMEM;
+		}
+
+		/* Changing direction within the transaction */
+		if ((n > 0) && ((msgs[n - 1].flags & I2C_MSG_RW_MASK) != flags)) {
+			flags |= I2C_MSG_RESTART;
+		}
+
+		msgs[n].buf = sqe->buf;
+		msgs[n].len = sqe->buf_len;
+		msgs[n].flags = flags;
+		n++;
+	}
+
+	if (n > 0) {
+		msgs[n - 1].flags |= I2C_MSG_STOP;
+	}
+
+	return n;
+}
+
+void i2c_iodev_submit_fallback(const struct device *dev,
+			       const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct i2c_iodev *iodev = (const struct i2c_iodev *)sqe->iodev;
+	struct i2c_msg msgs[CONFIG_I2C_RTIO_TRANSACTION_MAX];
+	int rc;
+
+	rc = i2c_rtio_msgs(r, sqe, msgs, ARRAY_SIZE(msgs));
+	if (rc > 0) {
+		rc = i2c_transfer(dev, msgs, rc, iodev->spec.addr);
+	}
+
+	if (rc < 0) {
+		rtio_sqe_err(r, sqe, rc);
+	} else {
+		rtio_sqe_ok(r, sqe, 0);
+	}
+}
+
+static void i2c_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct i2c_iodev *iodev = (const struct i2c_iodev *)sqe->iodev;
+	const struct device *dev = iodev->spec.bus;
+	const struct i2c_driver_api *api =
+		(const struct i2c_driver_api *)dev->api;
+
+	if (api->iodev_submit != NULL) {
+		api->iodev_submit(dev, sqe, r);
+	} else {
+		i2c_iodev_submit_fallback(dev, sqe, r);
+	}
+}
+
+const struct rtio_iodev_api i2c_iodev_api = {
+	.submit = i2c_iodev_submit,
+};
@@ -84,6 +84,32 @@ static int spi_emul_io(const struct device *dev,
 	return api->io(emul, config, tx_bufs, rx_bufs);
 }
 
+#ifdef CONFIG_SPI_RTIO
+/* The emulated transfer completes immediately, in the submitting context */
+static void spi_emul_iodev_submit(const struct device *dev,
+				  const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_iodev *iodev = (const struct spi_iodev *)sqe->iodev;
+	struct spi_buf tx[CONFIG_SPI_RTIO_TRANSACTION_MAX];
+	struct spi_buf rx[CONFIG_SPI_RTIO_TRANSACTION_MAX];
+	int rc;
+
+	rc = spi_rtio_bufs(r, sqe, tx, rx, ARRAY_SIZE(tx));
+	if (rc > 0) {
+		const struct spi_buf_set tx_set = { .buffers = tx, .count = rc };
+		const struct spi_buf_set rx_set = { .buffers = rx, .count = rc };
+
+		rc = spi_emul_io(dev, &iodev->spec.config, &tx_set, &rx_set);
+	}
+
+	if (rc < 0) {
+		rtio_sqe_err(r, sqe, rc);
+	} else {
+		rtio_sqe_ok(r, sqe, 0);
+	}
+}
+#endif
+
 /**
  * Set up a new emulator and add it to the list
  *
@@ -115,6 +141,9 @@ int spi_emul_register(const struct device *dev, const char *name,
 
 static struct spi_driver_api spi_emul_api = {
 	.transceive = spi_emul_io,
+#ifdef CONFIG_SPI_RTIO
+	.iodev_submit = spi_emul_iodev_submit,
+#endif
 };
 
 #define EMUL_LINK_AND_COMMA(node_id) {		\
@@ -0,0 +1,94 @@
+/*
+ * SPI peripherals as RTIO devices
+ *
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+
+int spi_rtio_bufs(struct rtio *r, const struct rtio_sqe *sqe,
+		  struct spi_buf *tx_bufs, struct spi_buf *rx_bufs,
+		  size_t num_bufs)
+{
+	size_t n = 0;
+
+	for (; sqe != NULL; sqe = rtio_txn_next(r, sqe)) {
+		if (sqe->op == RTIO_OP_NOP) {
+			continue;
+		}
+
+		if (n == num_bufs) {
+			return -ENOMEM;
+		}
+
+		switch (sqe->op) {
+		case RTIO_OP_TX:
+			tx_bufs[n].buf = sqe->buf;
+			rx_bufs[n].buf = NULL;
+			tx_bufs[n].len = sqe->buf_len;
+			break;
+		case RTIO_OP_RX:
+			tx_bufs[n].buf = NULL;
+			rx_bufs[n].buf = sqe->buf;
+			tx_bufs[n].len = sqe->buf_len;
+			break;
+		case RTIO_OP_TXRX:
+			tx_bufs[n].buf = sqe->tx_buf;
+			rx_bufs[n].buf = sqe->rx_buf;
+			tx_bufs[n].len = sqe->txrx_buf_len;
+			break;
+		default:
+			return -ENOTSUP;
+		}
+
+		rx_bufs[n].len = tx_bufs[n].len;
+		n++;
+	}
+
+	return n;
+}
+
+void spi_iodev_submit_fallback(const struct device *dev,
+			       const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_iodev *iodev = (const struct spi_iodev *)sqe->iodev;
+	struct spi_buf tx[CONFIG_SPI_RTIO_TRANSACTION_MAX];
+	struct spi_buf rx[CONFIG_SPI_RTIO_TRANSACTION_MAX];
+	int rc;
+
+	rc = spi_rtio_bufs(r, sqe, tx, rx, ARRAY_SIZE(tx));
+	if (rc > 0) {
+		const struct spi_buf_set tx_set = { .buffers = tx, .count = rc };
+		const struct spi_buf_set rx_set = { .buffers = rx, .count = rc };
+
+		rc = spi_transceive(dev, &iodev->spec.config, &tx_set, &rx_set);
+	}
+
+	if (rc < 0) {
+		rtio_sqe_err(r, sqe, rc);
+	} else {
+		rtio_sqe_ok(r, sqe, 0);
+	}
+}
+
+static void spi_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	const struct spi_iodev *iodev = (const struct spi_iodev *)sqe->iodev;
+	const struct device *dev = iodev->spec.bus;
+	const struct spi_driver_api *api =
+		(const struct spi_driver_api *)dev->api;
+
+	if (api->iodev_submit != NULL) {
+		api->iodev_submit(dev, sqe, r);
+	} else {
+		spi_iodev_submit_fallback(dev, sqe, r);
+	}
+}
+
+const struct rtio_iodev_api spi_iodev_api = {
+	.submit = spi_iodev_submit,
+};
@@ -1011,6 +1011,10 @@ int bt_gatt_notify_cb(struct bt_conn *conn,
  *
  *  This function works in the same way as @ref bt_gatt_notify_cb.
  *
+ *  For clients that support the Multiple Handle Value Notification the
+ *  values are packed into as few PDUs as the ATT MTU allows, which are sent
+ *  once all of the values have been queued.
+ *
  *  @param conn Connection object.
  *  @param num_params Number of notification parameters.
  *  @param params Array of notification parameters.
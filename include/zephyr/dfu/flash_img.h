@@ -28,8 +28,15 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_IMG_BACKGROUND_WRITE
+#define FLASH_IMG_BUF_SIZE \
+	(CONFIG_IMG_BLOCK_BUF_SIZE * CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS)
+#else
+#define FLASH_IMG_BUF_SIZE CONFIG_IMG_BLOCK_BUF_SIZE
+#endif
+
 struct flash_img_context {
-	uint8_t buf[CONFIG_IMG_BLOCK_BUF_SIZE];
+	uint8_t buf[FLASH_IMG_BUF_SIZE];
 	const struct flash_area *flash_area;
 	struct stream_flash_ctx stream;
 };
@@ -93,6 +100,45 @@ size_t flash_img_bytes_written(struct flash_img_context *ctx);
 int flash_img_buffered_write(struct flash_img_context *ctx, const uint8_t *data,
 		    size_t len, bool flush);
 
+/**
+ * @brief Start erasing the rest of the image slot in the background.
+ *
+ * Pages of the image slot past the data written so far are erased from a
+ * low priority thread, so that later writes do not wait for the erase.
+ * The pre-erase is stopped by the final flush write.
+ *
+ * The function is enabled via CONFIG_STREAM_FLASH_PRE_ERASE Kconfig option.
+ *
+ * @param ctx context
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_pre_erase_start(struct flash_img_context *ctx);
+
+/**
+ * @brief Stop erasing the image slot in the background.
+ *
+ * The function is enabled via CONFIG_STREAM_FLASH_PRE_ERASE Kconfig option.
+ *
+ * @param ctx context
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_pre_erase_stop(struct flash_img_context *ctx);
+
+/**
+ * @brief Get the progress and statistics of the background erase.
+ *
+ * The function is enabled via CONFIG_STREAM_FLASH_PRE_ERASE Kconfig option.
+ *
+ * @param[in] ctx context.
+ * @param[out] stats current progress and statistics.
+ *
+ * @return  0 on success, negative errno code on fail
+ */
+int flash_img_pre_erase_stats_get(struct flash_img_context *ctx,
+				  struct stream_flash_pre_erase_stats *stats);
+
 /**
  * @brief  Verify flash memory length bytes integrity from a flash area. The
  * start point is indicated by an offset value.
@@ -35,6 +35,12 @@ enum {
 	 * default data length parameters. Therefore the host should initiate
 	 * the DLE procedure after connection establishment. */
 	BT_QUIRK_NO_AUTO_DLE = BIT(1),
+	/* The driver is done with the data of a buffer once send() returns,
+	 * e.g. because it copies it to controller memory. The host then sends
+	 * ACL fragments directly from the original buffer instead of copying
+	 * each of them to a fragment buffer.
+	 */
+	BT_QUIRK_TX_DATA_COPIED = BIT(2),
 };
 
 #define IS_BT_QUIRK_NO_AUTO_DLE(bt_dev) ((bt_dev)->drv->quirks & BT_QUIRK_NO_AUTO_DLE)
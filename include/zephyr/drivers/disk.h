@@ -27,6 +27,9 @@
 #include <zephyr/kernel.h>
 #include <zephyr/types.h>
 #include <zephyr/sys/dlist.h>
+#if defined(CONFIG_DISK_ACCESS_RTIO)
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -62,6 +65,45 @@ extern "C" {
 
 struct disk_operations;
 
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+/**
+ * @brief RTIO device of a disk
+ *
+ * Queues read and write requests submitted through RTIO and performs them
+ * with the disk operations from a work queue thread. Consecutive requests
+ * for adjacent sectors and adjacent buffers are merged into one driver call.
+ * Disk drivers supporting asynchronous access define one with
+ * DISK_RTIO_IODEV_DEFINE() and point disk_info::rtio at it.
+ */
+struct disk_rtio_iodev {
+	/** RTIO device, must be the first member */
+	struct rtio_iodev iodev;
+	/** Disk the requests are performed on, set on registration */
+	struct disk_info *disk;
+	/** Sector size, 0 until the first request */
+	uint32_t sector_size;
+	/** Serializes producers of the pending request queue */
+	struct k_spinlock lock;
+	/** Work item processing the pending requests */
+	struct k_work work;
+};
+
+/**
+ * @brief Statically define a disk RTIO device
+ *
+ * @param name Name of the disk RTIO device
+ */
+#define DISK_RTIO_IODEV_DEFINE(name)						\
+	static RTIO_SPSC_DEFINE(_disk_rtio_sq_##name, struct rtio_iodev_sqe,	\
+				CONFIG_DISK_ACCESS_RTIO_QUEUE_SIZE);		\
+	static struct disk_rtio_iodev name = {					\
+		.iodev = {							\
+			.iodev_sq =						\
+				(struct rtio_iodev_sq *)&_disk_rtio_sq_##name,	\
+		},								\
+	}
+#endif
+
 /**
  * @brief Disk info
  */
@@ -74,6 +116,18 @@ struct disk_info {
 	const struct disk_operations *ops;
 	/** Device associated to this disk */
 	const struct device *dev;
+#if defined(CONFIG_DISK_ACCESS_CACHE) || defined(__DOXYGEN__)
+	/** Internally used by the sector cache, 0 until first access */
+	uint32_t cache_sector_size;
+	/** Internally used by the sector cache */
+	uint32_t cache_sector_count;
+	/** Internally used by the sector cache to detect sequential reads */
+	uint32_t cache_next_sector;
+#endif
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+	/** RTIO device of the disk, NULL if asynchronous access is not supported */
+	struct disk_rtio_iodev *rtio;
+#endif
 };
 
 /**
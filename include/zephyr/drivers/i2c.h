@@ -21,6 +21,9 @@
 
 #include <zephyr/types.h>
 #include <zephyr/device.h>
+#if defined(CONFIG_I2C_RTIO)
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -180,6 +183,11 @@ typedef int (*i2c_api_target_register_t)(const struct device *dev,
 typedef int (*i2c_api_target_unregister_t)(const struct device *dev,
 					  struct i2c_target_config *cfg);
 typedef int (*i2c_api_recover_bus_t)(const struct device *dev);
+#ifdef CONFIG_I2C_RTIO
+typedef void (*i2c_api_iodev_submit_t)(const struct device *dev,
+				       const struct rtio_sqe *sqe,
+				       struct rtio *r);
+#endif /* CONFIG_I2C_RTIO */
 
 __subsystem struct i2c_driver_api {
 	i2c_api_configure_t configure;
@@ -188,6 +196,9 @@ __subsystem struct i2c_driver_api {
 	i2c_api_target_register_t target_register;
 	i2c_api_target_unregister_t target_unregister;
 	i2c_api_recover_bus_t recover_bus;
+#ifdef CONFIG_I2C_RTIO
+	i2c_api_iodev_submit_t iodev_submit;
+#endif /* CONFIG_I2C_RTIO */
 };
 
 typedef int (*i2c_target_api_register_t)(const struct device *dev);
@@ -621,6 +632,78 @@ static inline int i2c_transfer_dt(const struct i2c_dt_spec *spec,
 	return i2c_transfer(spec->bus, msgs, num_msgs, spec->addr);
 }
 
+#if defined(CONFIG_I2C_RTIO) || defined(__DOXYGEN__)
+/**
+ * @brief RTIO device of an I2C target
+ *
+ * Requests submitted to it are performed on the target as I2C messages: a
+ * read (RTIO_OP_RX) or a write (RTIO_OP_TX) each. Requests flagged with
+ * RTIO_SQE_TRANSACTION form a single transfer, with a repeated start when
+ * the direction changes and a stop after the last one, so a register read
+ * is a write of the register address followed by a read in one
+ * transaction. Controller drivers may perform the requests themselves,
+ * otherwise they are performed with i2c_transfer() from the context that
+ * submits them. Define one with I2C_DT_IODEV_DEFINE().
+ */
+struct i2c_iodev {
+	/** RTIO device, must be the first member */
+	struct rtio_iodev iodev;
+	/** Bus and address of the target */
+	struct i2c_dt_spec spec;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+extern const struct rtio_iodev_api i2c_iodev_api;
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Statically define the RTIO device of an I2C target
+ *
+ * @param name Name of the I2C RTIO device
+ * @param node_id Devicetree node identifier for the I2C target
+ */
+#define I2C_DT_IODEV_DEFINE(name, node_id)				\
+	static struct i2c_iodev name = {				\
+		.iodev = {						\
+			.api = &i2c_iodev_api,				\
+		},							\
+		.spec = I2C_DT_SPEC_GET(node_id),			\
+	}
+
+/**
+ * @brief Convert an RTIO transaction into I2C messages
+ *
+ * For use by controller drivers performing RTIO requests.
+ *
+ * @param r RTIO context of the requests
+ * @param sqe First request of the transaction
+ * @param msgs Array of messages to fill
+ * @param num_msgs Size of @p msgs
+ *
+ * @return Number of messages filled in, or a negative error code if a
+ *         request is not supported or the transaction does not fit
+ */
+int i2c_rtio_msgs(struct rtio *r, const struct rtio_sqe *sqe,
+		  struct i2c_msg *msgs, uint8_t num_msgs);
+
+/**
+ * @brief Perform an RTIO transaction with i2c_transfer()
+ *
+ * Used for controller drivers not performing RTIO requests themselves. The
+ * transfer is done synchronously from the calling context.
+ *
+ * @param dev I2C controller
+ * @param sqe First request of the transaction
+ * @param r RTIO context of the requests
+ */
+void i2c_iodev_submit_fallback(const struct device *dev,
+			       const struct rtio_sqe *sqe, struct rtio *r);
+#endif /* CONFIG_I2C_RTIO */
+
 /**
  * @brief Recover the I2C bus
  *
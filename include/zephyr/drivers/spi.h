@@ -24,6 +24,9 @@
 #include <zephyr/device.h>
 #include <zephyr/dt-bindings/spi/spi.h>
 #include <zephyr/drivers/gpio.h>
+#if defined(CONFIG_SPI_RTIO)
+#include <zephyr/rtio/rtio.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -485,6 +488,16 @@ typedef int (*spi_api_io_async)(const struct device *dev,
 typedef int (*spi_api_release)(const struct device *dev,
 			       const struct spi_config *config);
 
+#ifdef CONFIG_SPI_RTIO
+/**
+ * @typedef spi_api_iodev_submit
+ * @brief Callback API for performing RTIO requests
+ * See spi_iodev_submit_fallback() for argument descriptions
+ */
+typedef void (*spi_api_iodev_submit)(const struct device *dev,
+				     const struct rtio_sqe *sqe,
+				     struct rtio *r);
+#endif /* CONFIG_SPI_RTIO */
 
 /**
  * @brief SPI driver API
@@ -496,6 +509,9 @@ __subsystem struct spi_driver_api {
 	spi_api_io_async transceive_async;
 #endif /* CONFIG_SPI_ASYNC */
 	spi_api_release release;
+#ifdef CONFIG_SPI_RTIO
+	spi_api_iodev_submit iodev_submit;
+#endif /* CONFIG_SPI_RTIO */
 };
 
 /**
@@ -809,6 +825,85 @@ static inline int spi_release_dt(const struct spi_dt_spec *spec)
 	return spi_release(spec->bus, &spec->config);
 }
 
+#if defined(CONFIG_SPI_RTIO) || defined(__DOXYGEN__)
+/**
+ * @brief RTIO device of a SPI peripheral
+ *
+ * Requests submitted to it are performed on the peripheral: a read
+ * (RTIO_OP_RX), a write (RTIO_OP_TX) or a full duplex transfer
+ * (RTIO_OP_TXRX) each. Requests flagged with RTIO_SQE_TRANSACTION form a
+ * single transfer with the chip select kept asserted, so a register read is
+ * a write of the register address followed by a read in one transaction.
+ * Controller drivers may perform the requests themselves, otherwise they are
+ * performed with spi_transceive() from the context that submits them. Define
+ * one with SPI_DT_IODEV_DEFINE().
+ */
+struct spi_iodev {
+	/** RTIO device, must be the first member */
+	struct rtio_iodev iodev;
+	/** Bus and configuration of the peripheral */
+	struct spi_dt_spec spec;
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+extern const struct rtio_iodev_api spi_iodev_api;
+/**
+ * @endcond
+ */
+
+/**
+ * @brief Statically define the RTIO device of a SPI peripheral
+ *
+ * @param name Name of the SPI RTIO device
+ * @param node_id Devicetree node identifier for the SPI peripheral
+ * @param operation_ the desired @p operation field in the struct spi_config
+ * @param delay_ the desired @p delay field in the struct spi_config's
+ *	spi_cs_control, if there is one
+ */
+#define SPI_DT_IODEV_DEFINE(name, node_id, operation_, delay_)		\
+	static struct spi_iodev name = {				\
+		.iodev = {						\
+			.api = &spi_iodev_api,				\
+		},							\
+		.spec = SPI_DT_SPEC_GET(node_id, operation_, delay_),	\
+	}
+
+/**
+ * @brief Convert an RTIO transaction into SPI buffers
+ *
+ * For use by controller drivers performing RTIO requests. Each request of
+ * the transaction fills the same entry of both arrays, with a NULL buffer in
+ * the direction it does not use.
+ *
+ * @param r RTIO context of the requests
+ * @param sqe First request of the transaction
+ * @param tx_bufs Array of buffers to transmit to fill
+ * @param rx_bufs Array of buffers to receive into to fill
+ * @param num_bufs Size of both arrays
+ *
+ * @return Number of buffers filled in each array, or a negative error code
+ *         if a request is not supported or the transaction does not fit
+ */
+int spi_rtio_bufs(struct rtio *r, const struct rtio_sqe *sqe,
+		  struct spi_buf *tx_bufs, struct spi_buf *rx_bufs,
+		  size_t num_bufs);
+
+/**
+ * @brief Perform an RTIO transaction with spi_transceive()
+ *
+ * Used for controller drivers not performing RTIO requests themselves. The
+ * transfer is done synchronously from the calling context.
+ *
+ * @param dev SPI controller
+ * @param sqe First request of the transaction
+ * @param r RTIO context of the requests
+ */
+void spi_iodev_submit_fallback(const struct device *dev,
+			       const struct rtio_sqe *sqe, struct rtio *r);
+#endif /* CONFIG_SPI_RTIO */
+
 #ifdef __cplusplus
 }
 #endif
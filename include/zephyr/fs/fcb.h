@@ -76,6 +76,20 @@ struct fcb_entry_ctx {
 	/**< Flash area where the entry is placed */
 };
 
+/**
+ * @brief FCB batch structure
+ *
+ * Entries added to a batch are packed into the buffer in the same format
+ * as they take in flash, then written to the FCB together by
+ * @ref fcb_batch_commit.
+ */
+struct fcb_batch {
+	uint8_t *fb_buf; /**< Buffer where the entries are packed */
+	size_t fb_size; /**< Size of the buffer */
+	size_t fb_len; /**< Number of bytes packed in the buffer */
+	uint16_t fb_cnt; /**< Number of entries packed in the buffer */
+};
+
 /**
  * @brief FCB instance structure
  *
@@ -179,6 +193,48 @@ int fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *loc);
  */
 int fcb_append_finish(struct fcb *fcb, struct fcb_entry *append_loc);
 
+/**
+ * Initialize a batch of entries.
+ *
+ * @param[out] batch Batch structure.
+ * @param[in] buf    Buffer where the entries are packed.
+ * @param[in] size   Size of the buffer.
+ */
+void fcb_batch_init(struct fcb_batch *batch, uint8_t *buf, size_t size);
+
+/**
+ * Add an entry to a batch.
+ *
+ * The entry is packed into the batch buffer, together with its length and
+ * checksum, and is written to flash by fcb_batch_commit(). Entries are read
+ * back like the ones appended with fcb_append().
+ *
+ * @param[in] fcb       FCB instance structure.
+ * @param[in,out] batch Batch structure.
+ * @param[in] data      Entry payload.
+ * @param[in] len       Length of the entry payload.
+ *
+ * @return 0 on success, -ENOMEM if the batch buffer is full, other non-zero
+ *         on failure.
+ */
+int fcb_batch_add(struct fcb *fcb, struct fcb_batch *batch, const void *data,
+		  uint16_t len);
+
+/**
+ * Append the entries of a batch to circular buffer.
+ *
+ * All entries which fit in the active sector are written with a single
+ * flash write. The batch is emptied of the entries which were written,
+ * so on -ENOSPC you can call fcb_rotate() and then commit the rest of the
+ * batch.
+ *
+ * @param[in] fcb       FCB instance structure.
+ * @param[in,out] batch Batch structure.
+ *
+ * @return 0 on success, non-zero on failure.
+ */
+int fcb_batch_commit(struct fcb *fcb, struct fcb_batch *batch);
+
 /**
  * FCB Walk callback function type.
  *
@@ -44,6 +44,12 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param gc_addr Address of the next ate to check by incremental gc
+ * @param gc_stop_addr Address of the last ate to check by incremental gc
+ * @param gc_sector Sector being collected by incremental gc
+ * @param gc_wra_sector Write sector when incremental gc started collecting
+ * @param gc_state Incremental gc state
+ * @param gc_erase_sem Taken while incremental gc erases a sector
  */
 struct nvs_fs {
 	off_t offset;
@@ -58,6 +64,14 @@ struct nvs_fs {
 #if CONFIG_NVS_LOOKUP_CACHE
 	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
 #endif
+#if CONFIG_NVS_GC_INCREMENTAL
+	uint32_t gc_addr;
+	uint32_t gc_stop_addr;
+	uint16_t gc_sector;
+	uint16_t gc_wra_sector;
+	uint8_t gc_state;
+	struct k_sem gc_erase_sem;
+#endif
 };
 
 /**
@@ -168,6 +182,34 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Perform a step of incremental garbage collection. While fewer than
+ * CONFIG_NVS_GC_RESERVE_SECTORS sectors are kept empty in addition to the
+ * one NVS always keeps empty, the valid entries of the oldest sector are
+ * moved to the write sector, then the oldest sector is erased. A step moves
+ * entries until @p budget_us has elapsed, checking at least one entry. The
+ * erase of the sector is a step of its own and does not hold the file system
+ * lock, so writes proceed while it is in progress. The sector is named in the
+ * write sector before it is erased, and nvs_mount() redoes the erase if it
+ * was interrupted.
+ *
+ * The function is meant to be called repeatedly, for instance from a work
+ * item, until it returns 0. It must not be called concurrently with itself,
+ * nvs_mount() or nvs_clear() on the same file system.
+ *
+ * The function is enabled via CONFIG_NVS_GC_INCREMENTAL Kconfig option.
+ *
+ * @param fs Pointer to file system
+ * @param budget_us Time budget of the step in microseconds
+ *
+ * @return 0 if the free sectors are kept or if the write sector has no room
+ * left for the moved entries, positive if more steps are needed, negative
+ * value of errno.h defined error codes on error.
+ */
+int nvs_gc_step(struct nvs_fs *fs, uint32_t budget_us);
+
 /**
  * @brief nvs_init
  *
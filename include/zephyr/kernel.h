@@ -5816,6 +5816,165 @@ extern void k_sys_runtime_stats_enable(void);
  */
 extern void k_sys_runtime_stats_disable(void);
 
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+/**
+ * @brief Get the scheduling histograms of a thread
+ *
+ * Copies the log2 histograms of ready -> running latency and of execution
+ * window length (both in cycles) gathered for the specified thread.
+ *
+ * @param thread ID of thread.
+ * @param hist Pointer to struct to copy histograms into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_sched_hist_get(k_tid_t thread, struct k_thread_sched_hist *hist);
+
+/**
+ * @brief Clear the scheduling histograms of a thread
+ *
+ * @param thread ID of thread.
+ * @return -EINVAL if invalid thread ID, otherwise 0
+ */
+int k_thread_sched_hist_reset(k_tid_t thread);
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+void z_waitq_stats_get(_wait_q_t *wait_q, struct k_obj_stats *stats);
+void z_waitq_stats_reset(_wait_q_t *wait_q);
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Get the contention statistics of a semaphore
+ *
+ * Wait times are in cycles.
+ *
+ * @param sem Address of the semaphore.
+ * @param stats Pointer to struct to copy statistics into.
+ */
+static inline void k_sem_stats_get(struct k_sem *sem,
+				   struct k_obj_stats *stats)
+{
+	z_waitq_stats_get(&sem->wait_q, stats);
+}
+
+/**
+ * @brief Clear the contention statistics of a semaphore
+ *
+ * @param sem Address of the semaphore.
+ */
+static inline void k_sem_stats_reset(struct k_sem *sem)
+{
+	z_waitq_stats_reset(&sem->wait_q);
+}
+
+/**
+ * @brief Get the contention statistics of a mutex
+ *
+ * Wait times are in cycles.
+ *
+ * @param mutex Address of the mutex.
+ * @param stats Pointer to struct to copy statistics into.
+ */
+static inline void k_mutex_stats_get(struct k_mutex *mutex,
+				     struct k_obj_stats *stats)
+{
+	z_waitq_stats_get(&mutex->wait_q, stats);
+}
+
+/**
+ * @brief Clear the contention statistics of a mutex
+ *
+ * @param mutex Address of the mutex.
+ */
+static inline void k_mutex_stats_reset(struct k_mutex *mutex)
+{
+	z_waitq_stats_reset(&mutex->wait_q);
+}
+
+/**
+ * @brief Get the contention statistics of a message queue
+ *
+ * Puts and gets share the statistics, as they pend on the same wait queue.
+ * Wait times are in cycles.
+ *
+ * @param msgq Address of the message queue.
+ * @param stats Pointer to struct to copy statistics into.
+ */
+static inline void k_msgq_stats_get(struct k_msgq *msgq,
+				    struct k_obj_stats *stats)
+{
+	z_waitq_stats_get(&msgq->wait_q, stats);
+}
+
+/**
+ * @brief Clear the contention statistics of a message queue
+ *
+ * @param msgq Address of the message queue.
+ */
+static inline void k_msgq_stats_reset(struct k_msgq *msgq)
+{
+	z_waitq_stats_reset(&msgq->wait_q);
+}
+
+/**
+ * @brief Get the contention statistics of a queue
+ *
+ * This also covers the FIFOs and LIFOs built on the queue. Wait times are
+ * in cycles.
+ *
+ * @param queue Address of the queue.
+ * @param stats Pointer to struct to copy statistics into.
+ */
+static inline void k_queue_stats_get(struct k_queue *queue,
+				     struct k_obj_stats *stats)
+{
+	z_waitq_stats_get(&queue->wait_q, stats);
+}
+
+/**
+ * @brief Clear the contention statistics of a queue
+ *
+ * @param queue Address of the queue.
+ */
+static inline void k_queue_stats_reset(struct k_queue *queue)
+{
+	z_waitq_stats_reset(&queue->wait_q);
+}
+
+/**
+ * @brief Get the contention statistics of a pipe
+ *
+ * Readers and writers have separate statistics. Wait times are in cycles.
+ *
+ * @param pipe Address of the pipe.
+ * @param readers Pointer to struct to copy the statistics of gets into.
+ * @param writers Pointer to struct to copy the statistics of puts into.
+ */
+static inline void k_pipe_stats_get(struct k_pipe *pipe,
+				    struct k_obj_stats *readers,
+				    struct k_obj_stats *writers)
+{
+	z_waitq_stats_get(&pipe->wait_q.readers, readers);
+	z_waitq_stats_get(&pipe->wait_q.writers, writers);
+}
+
+/**
+ * @brief Clear the contention statistics of a pipe
+ *
+ * @param pipe Address of the pipe.
+ */
+static inline void k_pipe_stats_reset(struct k_pipe *pipe)
+{
+	z_waitq_stats_reset(&pipe->wait_q.readers);
+	z_waitq_stats_reset(&pipe->wait_q.writers);
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
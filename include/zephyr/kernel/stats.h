@@ -24,4 +24,38 @@ struct k_cycle_stats {
 	bool      track_usage;  /* true if gathering usage stats */
 };
 
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+/*
+ * [k_thread_sched_hist] holds log2 histograms of a thread's scheduling
+ * behaviour. Bucket 0 counts zero-cycle samples, bucket [n] counts samples
+ * in the range [2^(n-1), 2^n) cycles and the last bucket also collects all
+ * samples that would fall beyond it.
+ */
+
+struct k_thread_sched_hist {
+	/* ready -> running latency */
+	uint32_t  wait[CONFIG_SCHED_THREAD_HISTOGRAM_BUCKETS];
+	/* length of each execution window (switch in -> switch out) */
+	uint32_t  run[CONFIG_SCHED_THREAD_HISTOGRAM_BUCKETS];
+	uint32_t  wait_max;     /* longest ready -> running latency */
+	uint32_t  run_max;      /* longest execution window */
+};
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS
+/*
+ * [k_obj_stats] tracks contention on the wait queue of a kernel object.
+ * Wait times are in cycles.
+ */
+
+struct k_obj_stats {
+	uint32_t  acquisitions; /* successful take/lock/get operations */
+	uint32_t  contended;    /* operations that had to pend */
+	uint32_t  waiters;      /* threads currently pending */
+	uint32_t  max_waiters;  /* most threads ever pending at once */
+	uint64_t  wait_total;   /* total cycles spent pending */
+	uint32_t  wait_max;     /* longest single pend */
+};
+#endif
+
 #endif
@@ -126,6 +126,16 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	struct k_cycle_stats  usage;   /* Track thread usage statistics */
 #endif
+
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+	uint32_t hist_ready;           /* timestamp of last ready transition */
+	uint32_t hist_run;             /* timestamp of last switch in */
+	struct k_thread_sched_hist  hist;
+#endif
+
+#ifdef CONFIG_KERNEL_OBJ_STATS
+	uint32_t pend_start;           /* timestamp of last pend */
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
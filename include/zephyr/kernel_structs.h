@@ -220,6 +220,9 @@ bool z_smp_cpu_mobile(void);
 
 typedef struct {
 	struct _priq_rb waitq;
+#ifdef CONFIG_KERNEL_OBJ_STATS
+	struct k_obj_stats stats;
+#endif
 } _wait_q_t;
 
 extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
@@ -230,6 +233,9 @@ extern bool z_priq_rb_lessthan(struct rbnode *a, struct rbnode *b);
 
 typedef struct {
 	sys_dlist_t waitq;
+#ifdef CONFIG_KERNEL_OBJ_STATS
+	struct k_obj_stats stats;
+#endif
 } _wait_q_t;
 
 #define Z_WAIT_Q_INIT(wait_q) { SYS_DLIST_STATIC_INIT(&(wait_q)->waitq) }
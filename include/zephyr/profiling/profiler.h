@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Sampling profiler header file
+ *
+ * The sampling profiler periodically captures the program counter (and
+ * optionally a short backtrace) of the code interrupted by the system
+ * timer. Identical samples are aggregated in a fixed size hash table which
+ * can be exported and turned into a flame graph on the host with
+ * scripts/profiling/profiler_collapse.py.
+ */
+
+#ifndef ZEPHYR_INCLUDE_PROFILING_PROFILER_H_
+#define ZEPHYR_INCLUDE_PROFILING_PROFILER_H_
+
+#include <zephyr/types.h>
+#include <zephyr/kernel.h>
+
+/**
+ * @brief Sampling profiler APIs
+ * @defgroup profiler_api Sampling profiler APIs
+ * @ingroup subsystem
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Sampling profiler statistics. */
+struct profiler_stats {
+	/** Samples aggregated in the table. */
+	uint32_t samples;
+	/** Samples dropped because the table was full. */
+	uint32_t dropped;
+	/** Timer expiries that did not interrupt thread context. */
+	uint32_t missed;
+	/** Number of distinct backtraces in the table. */
+	uint32_t buckets;
+};
+
+/**
+ * @brief Callback used to iterate over the aggregated samples.
+ *
+ * @param pcs Backtrace of the sample, innermost program counter first.
+ * @param depth Number of entries in @a pcs.
+ * @param count Number of times this backtrace was sampled.
+ * @param user_data User data passed to profiler_foreach().
+ */
+typedef void (*profiler_sample_cb_t)(const uintptr_t *pcs, size_t depth,
+				     uint32_t count, void *user_data);
+
+/**
+ * @brief Start sampling.
+ *
+ * The sampling period is rounded to system ticks, so rates above
+ * CONFIG_SYS_CLOCK_TICKS_PER_SEC are effectively capped to it.
+ *
+ * @param rate_hz Sampling rate in Hz.
+ *
+ * @retval 0 If successful.
+ * @retval -EINVAL If @a rate_hz is 0.
+ * @retval -EALREADY If the profiler is already running.
+ */
+int profiler_start(uint32_t rate_hz);
+
+/**
+ * @brief Stop sampling.
+ *
+ * Aggregated samples are kept until profiler_reset() is called.
+ *
+ * @retval 0 If successful.
+ * @retval -EALREADY If the profiler is not running.
+ */
+int profiler_stop(void);
+
+/**
+ * @brief Discard all aggregated samples and statistics.
+ */
+void profiler_reset(void);
+
+/**
+ * @brief Get the profiler statistics.
+ *
+ * @param stats Pointer to struct to copy statistics into.
+ */
+void profiler_stats_get(struct profiler_stats *stats);
+
+/**
+ * @brief Iterate over the aggregated samples.
+ *
+ * The callback runs in the caller's context. Samples taken while iterating
+ * may or may not be reported.
+ *
+ * @param cb Callback called for every distinct backtrace.
+ * @param user_data User data passed to @a cb.
+ */
+void profiler_foreach(profiler_sample_cb_t cb, void *user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_INCLUDE_PROFILING_PROFILER_H_ */
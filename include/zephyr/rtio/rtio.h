@@ -33,8 +33,10 @@
 #define ZEPHYR_INCLUDE_RTIO_RTIO_H_
 
 #include <zephyr/rtio/rtio_spsc.h>
+#include <zephyr/rtio/rtio_mpmc.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/sys/atomic.h>
+#include <zephyr/sys/mem_blocks.h>
 #include <zephyr/device.h>
 #include <zephyr/kernel.h>
 
@@ -99,6 +101,55 @@ struct rtio_iodev;
  */
 #define RTIO_SQE_CHAINED BIT(0)
 
+/**
+ * @brief The next request in the queue is part of the same transaction.
+ *
+ * All requests of a transaction are performed together by their iodev, as a
+ * single bus transaction (e.g. a register address write followed by a read
+ * with a repeated start, or with the chip select kept asserted). Only the
+ * first request is submitted to the iodev, which finds the others with
+ * rtio_txn_next() and reports the result of the whole transaction once on the
+ * first request. Each request of the transaction gets a completion with that
+ * result. All requests of the transaction must use the same iodev and be in
+ * the queue when the first one is submitted. The last request of a transaction
+ * may be chained.
+ */
+#define RTIO_SQE_TRANSACTION BIT(1)
+
+/**
+ * @brief The read buffer is taken from the memory pool of the RTIO context.
+ *
+ * The buffer is only allocated when the iodev has data to store, with
+ * rtio_sqe_rx_buf(). The completion carries the buffer, which the consumer
+ * must give back with rtio_release_buffer() once done with it, whatever the
+ * result of the request.
+ *
+ * Requires CONFIG_RTIO_SYS_MEM_BLOCKS.
+ */
+#define RTIO_SQE_MEMPOOL_BUFFER BIT(2)
+
+/**
+ * @brief The request stays armed and completes once per event.
+ *
+ * After each successful completion the executor submits the request to its
+ * iodev again instead of retiring it, so a stream of events produces a stream
+ * of completions from a single request. The request is retired once it fails
+ * or after rtio_sqe_multishot_stop(). It may not be chained or part of a
+ * transaction, and its iodev must complete it asynchronously, from the event.
+ *
+ * The request keeps its executor busy: the simple executor runs nothing else,
+ * the concurrent executor keeps one task for it and releases the requests
+ * queued after it only once it is retired.
+ */
+#define RTIO_SQE_MULTISHOT BIT(3)
+
+/**
+ * @brief The multishot request is re-armed by a timer.
+ *
+ * Set by rtio_periodic_start(), see struct rtio_periodic.
+ */
+#define RTIO_SQE_PERIODIC BIT(4)
+
 /**
  * @}
  */
@@ -129,6 +180,21 @@ struct rtio_sqe {
 			uint32_t buf_len; /**< Length of buffer */
 
 			uint8_t *buf; /**< Buffer to use*/
+
+			/**
+			 * Position of the transfer on the device, in units
+			 * defined by the iodev (e.g. disk sectors)
+			 */
+			uint32_t offset;
+		};
+
+		/** Buffers of a transceive operation */
+		struct {
+			uint32_t txrx_buf_len; /**< Length of both buffers */
+
+			uint8_t *tx_buf; /**< Buffer to transmit */
+
+			uint8_t *rx_buf; /**< Buffer to receive into */
 		};
 	};
 };
@@ -144,12 +210,31 @@ struct rtio_sq {
 	struct rtio_sqe buffer[];
 };
 
+/**
+ * @brief Multiple producer submission queue
+ *
+ * Requests prepared by several threads or ISRs, to be moved to the
+ * submission queue of an RTIO context with rtio_sqe_move_from_mpmc().
+ */
+struct rtio_mpmc_sq {
+	struct rtio_mpmc _mpmc;
+	struct rtio_sqe buffer[];
+};
+
 /**
  * @brief A completion queue event
  */
 struct rtio_cqe {
 	int32_t result; /**< Result from operation */
 	void *userdata; /**< Associated userdata with operation */
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	/**
+	 * Buffer taken from the memory pool of the RTIO context, NULL unless
+	 * the request was flagged with RTIO_SQE_MEMPOOL_BUFFER and got one
+	 */
+	uint8_t *buf;
+	uint32_t buf_len; /**< Length of the memory pool buffer */
+#endif
 };
 
 /**
@@ -245,6 +330,11 @@ struct rtio {
 	struct k_sem *consume_sem;
 #endif
 
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	/* Memory pool of the read buffers of RTIO_SQE_MEMPOOL_BUFFER requests */
+	struct sys_mem_blocks *block_pool;
+#endif
+
 	/* Number of completions that were unable to be submitted with results
 	 * due to the cq spsc being full
 	 */
@@ -271,19 +361,52 @@ struct rtio_iodev_api {
 	void (*submit)(const struct rtio_sqe *sqe,
 		       struct rtio *r);
 
-	/**
-	 * TODO some form of transactional piece is missing here
-	 * where we wish to "transact" on an iodev with multiple requests
-	 * over a chain.
-	 *
-	 * Only once explicitly released or the chain fails do we want
-	 * to release. Once released any pending iodevs in the queue
-	 * should be done.
-	 *
-	 * Something akin to a lock/unlock pair.
+	/*
+	 * Requests flagged with RTIO_SQE_TRANSACTION are not submitted on
+	 * their own, the iodev is given the first request of the transaction
+	 * and walks the rest with rtio_txn_next().
 	 */
 };
 
+/**
+ * @brief A multishot request submitted to its iodev on each timer period
+ *
+ * The executor parks the request after each completion, the timer expiry
+ * function queues a work item on the system work queue which submits it to
+ * its iodev again. Iodevs that block in their submit call, such as the I2C
+ * and SPI fallbacks, can then be used. Nothing runs in the application thread
+ * between samples. A period ending while the request is still in progress is
+ * counted as an overrun and skipped.
+ *
+ * While the request is armed its userdata points to this struct, the
+ * completions carry the userdata it was prepared with.
+ */
+struct rtio_periodic {
+	/* Timer queuing the submission */
+	struct k_timer timer;
+
+	/* Work item submitting the request */
+	struct k_work work;
+
+	/* Serializes stopping and retiring the request */
+	struct k_spinlock lock;
+
+	/* RTIO context of the request */
+	struct rtio *r;
+
+	/* Request submitted on each period, NULL once retired */
+	struct rtio_sqe *sqe;
+
+	/* Userdata the request was prepared with */
+	void *userdata;
+
+	/* Set while the request is in progress */
+	atomic_t busy;
+
+	/* Number of periods skipped as the request was still in progress */
+	uint32_t overruns;
+};
+
 /* IO device submission queue entry */
 struct rtio_iodev_sqe {
 	const struct rtio_sqe *sqe;
@@ -325,6 +448,9 @@ struct rtio_iodev {
 /** An operation that transmits (writes) */
 #define RTIO_OP_TX 2
 
+/** An operation that transmits and receives at the same time (full duplex) */
+#define RTIO_OP_TXRX 3
+
 /**
  * @brief Prepare a nop (no op) submission
  */
@@ -352,9 +478,28 @@ static inline void rtio_sqe_prep_read(struct rtio_sqe *sqe,
 	sqe->iodev = iodev;
 	sqe->buf_len = len;
 	sqe->buf = buf;
+	sqe->offset = 0;
 	sqe->userdata = userdata;
 }
 
+/**
+ * @brief Prepare a read op submission with a buffer from the memory pool
+ *
+ * The buffer is allocated from the memory pool of the RTIO context when the
+ * iodev performs the read, and handed over with the completion. Sets the
+ * flags of the request, further flags must be or'ed in.
+ *
+ * @see RTIO_SQE_MEMPOOL_BUFFER
+ */
+static inline void rtio_sqe_prep_read_with_pool(struct rtio_sqe *sqe,
+						struct rtio_iodev *iodev,
+						int8_t prio,
+						void *userdata)
+{
+	rtio_sqe_prep_read(sqe, iodev, prio, NULL, 0, userdata);
+	sqe->flags = RTIO_SQE_MEMPOOL_BUFFER;
+}
+
 /**
  * @brief Prepare a write op submission
  */
@@ -370,6 +515,30 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 	sqe->iodev = iodev;
 	sqe->buf_len = len;
 	sqe->buf = buf;
+	sqe->offset = 0;
+	sqe->userdata = userdata;
+}
+
+/**
+ * @brief Prepare a transceive op submission
+ *
+ * The two buffers have the same length, @p tx_buf is transmitted while
+ * @p rx_buf is received into.
+ */
+static inline void rtio_sqe_prep_transceive(struct rtio_sqe *sqe,
+					    struct rtio_iodev *iodev,
+					    int8_t prio,
+					    uint8_t *tx_buf,
+					    uint8_t *rx_buf,
+					    uint32_t len,
+					    void *userdata)
+{
+	sqe->op = RTIO_OP_TXRX;
+	sqe->prio = prio;
+	sqe->iodev = iodev;
+	sqe->txrx_buf_len = len;
+	sqe->tx_buf = tx_buf;
+	sqe->rx_buf = rx_buf;
 	sqe->userdata = userdata;
 }
 
@@ -392,14 +561,17 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 	static RTIO_SPSC_DEFINE(name, struct rtio_cqe, len)
 
 /**
- * @brief Statically define and initialize an RTIO context
+ * @brief Statically define and initialize a fixed length multiple producer
+ * submission queue.
  *
- * @param name Name of the RTIO
- * @param exec Symbol for rtio_executor (pointer)
- * @param sq_sz Size of the submission queue, must be power of 2
- * @param cq_sz Size of the completion queue, must be power of 2
+ * @param name Name of the submission queue.
+ * @param len Queue length, power of 2 required (2, 4, 8).
  */
-#define RTIO_DEFINE(name, exec, sq_sz, cq_sz)							   \
+#define RTIO_MPMC_SQ_DEFINE(name, len)			\
+	static RTIO_MPMC_DEFINE(name, struct rtio_sqe, len)
+
+/** @cond INTERNAL_HIDDEN */
+#define Z_RTIO_DEFINE(name, exec, sq_sz, cq_sz, pool)						   \
 	IF_ENABLED(CONFIG_RTIO_SUBMIT_SEM, (K_SEM_DEFINE(_submit_sem_##name, 0, K_SEM_MAX_LIMIT))) \
 	IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (K_SEM_DEFINE(_consume_sem_##name, 0, 1)))		   \
 	RTIO_SQ_DEFINE(_sq_##name, sq_sz);							   \
@@ -412,7 +584,39 @@ static inline void rtio_sqe_prep_write(struct rtio_sqe *sqe,
 		IF_ENABLED(CONFIG_RTIO_CONSUME_SEM, (.consume_sem = &_consume_sem_##name,))	   \
 		.sq = (struct rtio_sq *const)&_sq_##name,					   \
 		.cq = (struct rtio_cq *const)&_cq_##name,					   \
+		IF_ENABLED(CONFIG_RTIO_SYS_MEM_BLOCKS, (.block_pool = (pool),))			   \
 	}
+/** @endcond */
+
+/**
+ * @brief Statically define and initialize an RTIO context
+ *
+ * @param name Name of the RTIO
+ * @param exec Symbol for rtio_executor (pointer)
+ * @param sq_sz Size of the submission queue, must be power of 2
+ * @param cq_sz Size of the completion queue, must be power of 2
+ */
+#define RTIO_DEFINE(name, exec, sq_sz, cq_sz)	\
+	Z_RTIO_DEFINE(name, exec, sq_sz, cq_sz, NULL)
+
+/**
+ * @brief Statically define and initialize an RTIO context with a memory pool
+ *
+ * Read requests flagged with RTIO_SQE_MEMPOOL_BUFFER get their buffer from the
+ * memory pool. A buffer is made of one or more contiguous blocks. Requires
+ * CONFIG_RTIO_SYS_MEM_BLOCKS.
+ *
+ * @param name Name of the RTIO
+ * @param exec Symbol for rtio_executor (pointer)
+ * @param sq_sz Size of the submission queue, must be power of 2
+ * @param cq_sz Size of the completion queue, must be power of 2
+ * @param num_blks Number of blocks in the memory pool
+ * @param blk_size Size of a block, must be power of 2
+ * @param balign Alignment of the memory pool, must be power of 2
+ */
+#define RTIO_DEFINE_WITH_MEMPOOL(name, exec, sq_sz, cq_sz, num_blks, blk_size, balign)	\
+	SYS_MEM_BLOCKS_DEFINE_STATIC(_block_pool_##name, blk_size, num_blks, balign);	\
+	Z_RTIO_DEFINE(name, exec, sq_sz, cq_sz, &_block_pool_##name)
 
 /**
  * @brief Set the executor of the rtio context
@@ -433,6 +637,141 @@ static inline void rtio_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
 	sqe->iodev->api->submit(sqe, r);
 }
 
+/**
+ * @brief Arm a completed multishot request again
+ *
+ * Called by the executor once the completion of a successful multishot
+ * request is submitted. A periodic request is parked until the next timer
+ * period, others are submitted to their iodev right away.
+ *
+ * @param r RTIO context
+ * @param sqe Multishot request
+ */
+static inline void rtio_sqe_multishot_rearm(struct rtio *r, const struct rtio_sqe *sqe)
+{
+	/* The request belongs to the executor until it is retired */
+	struct rtio_sqe *msqe = (struct rtio_sqe *)sqe;
+
+	__ASSERT((sqe->flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION)) == 0,
+		 "multishot requests may not be chained");
+
+	if (sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) {
+		/* Each completion hands over its own buffer */
+		msqe->buf = NULL;
+		msqe->buf_len = 0;
+	}
+
+	if (sqe->flags & RTIO_SQE_PERIODIC) {
+		atomic_clear(&((struct rtio_periodic *)sqe->userdata)->busy);
+	} else {
+		rtio_iodev_submit(sqe, r);
+	}
+}
+
+/**
+ * @brief Stop a multishot request
+ *
+ * The request is retired with its next completion, which may still be
+ * successful.
+ *
+ * @param sqe Multishot request, as acquired from the submission queue
+ */
+static inline void rtio_sqe_multishot_stop(struct rtio_sqe *sqe)
+{
+	sqe->flags &= ~RTIO_SQE_MULTISHOT;
+}
+
+/**
+ * @brief Start submitting a request periodically
+ *
+ * The prepared request is made a periodic multishot request and submitted,
+ * along with any other prepared requests. It is then submitted again on each
+ * @p period.
+ *
+ * @param p Periodic submission, must stay valid until stopped
+ * @param r RTIO context
+ * @param sqe Prepared request, acquired from the submission queue of @p r
+ * @param period Period of the submissions
+ *
+ * @retval 0 On success
+ */
+int rtio_periodic_start(struct rtio_periodic *p, struct rtio *r,
+			struct rtio_sqe *sqe, k_timeout_t period);
+
+/**
+ * @brief Stop submitting a request periodically
+ *
+ * The request is retired with its next completion. If it is not in progress
+ * it is retired right away with -ECANCELED. Does nothing if the request was
+ * already retired after a failure.
+ *
+ * @param p Periodic submission
+ */
+void rtio_periodic_stop(struct rtio_periodic *p);
+
+/**
+ * @brief Retire a periodic request
+ *
+ * Called by the executor once the request completes for the last time, after
+ * a failure or once stopped. Stops the timer, the request slot may be reused
+ * right after.
+ *
+ * @param p Periodic submission
+ */
+void rtio_periodic_retire(struct rtio_periodic *p);
+
+/**
+ * @brief Get the next request of a transaction
+ *
+ * Used by iodevs to walk the requests of a transaction they were submitted.
+ *
+ * @param r RTIO context
+ * @param sqe Request of the transaction
+ *
+ * @return The request following @p sqe in its transaction, or NULL if
+ *         @p sqe is the last one
+ */
+static inline const struct rtio_sqe *rtio_txn_next(const struct rtio *r,
+						   const struct rtio_sqe *sqe)
+{
+	if ((sqe->flags & RTIO_SQE_TRANSACTION) == 0) {
+		return NULL;
+	}
+
+	return rtio_spsc_next(r->sq, sqe);
+}
+
+/**
+ * @brief Move requests from a multiple producer submission queue
+ *
+ * Requests may be prepared in a multiple producer submission queue by any
+ * number of threads and ISRs, while the submission queue of an RTIO context
+ * has a single producer. The owner of the context moves them, in the order
+ * they were produced, before calling rtio_submit(). Requests of several
+ * producers interleave, chained requests and transactions may not be
+ * prepared this way.
+ *
+ * @param r RTIO context
+ * @param mq Multiple producer submission queue, from RTIO_MPMC_SQ_DEFINE()
+ *
+ * @return Number of requests moved, less than available if the submission
+ *         queue of @p r is full
+ */
+static inline uint32_t rtio_sqe_move_from_mpmc(struct rtio *r, struct rtio_mpmc_sq *mq)
+{
+	uint32_t avail = rtio_spsc_acquirable(r->sq);
+	uint32_t count = 0;
+	struct rtio_sqe *msqe;
+
+	while ((count < avail) && ((msqe = rtio_mpmc_consume(mq)) != NULL)) {
+		*rtio_spsc_acquire(r->sq) = *msqe;
+		rtio_mpmc_release(mq, msqe);
+		count++;
+	}
+
+	return count;
+}
+
 /**
  * @brief Submit I/O requests to the underlying executor
  *
@@ -579,24 +918,113 @@ static inline void rtio_sqe_err(struct rtio *r, const struct rtio_sqe *sqe, int
 }
 
 /**
- * Submit a completion queue event with a given result and userdata
+ * @brief Get the read buffer of a request
+ *
+ * Requests flagged with RTIO_SQE_MEMPOOL_BUFFER get a buffer of at least
+ * @p min_buf_len bytes from the memory pool of the RTIO context, as large as
+ * possible up to @p max_buf_len bytes. The buffer is recorded in the request,
+ * the iodev must call this on the request it later completes. Other requests
+ * return their own buffer if it holds at least @p min_buf_len bytes.
+ *
+ * @param r RTIO context
+ * @param sqe Read request
+ * @param min_buf_len Minimum length of the buffer
+ * @param max_buf_len Length of the buffer the iodev could fill
+ * @param buf Set to the buffer
+ * @param buf_len Set to the length of the buffer
+ *
+ * @retval 0 On success
+ * @retval -ENOMEM No large enough buffer available
+ */
+static inline int rtio_sqe_rx_buf(struct rtio *r, const struct rtio_sqe *sqe,
+				  uint32_t min_buf_len, uint32_t max_buf_len,
+				  uint8_t **buf, uint32_t *buf_len)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if ((sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) && (sqe->buf == NULL)) {
+		/* The request belongs to the executor until it completes */
+		struct rtio_sqe *pool_sqe = (struct rtio_sqe *)sqe;
+		uint32_t blk_size;
+		size_t min_blks;
+		void *block;
+
+		__ASSERT(r->block_pool != NULL, "RTIO context has no memory pool");
+
+		blk_size = BIT(r->block_pool->blk_sz_shift);
+		min_blks = MAX(DIV_ROUND_UP(min_buf_len, blk_size), 1);
+
+		for (size_t n = DIV_ROUND_UP(max_buf_len, blk_size); n >= min_blks; n--) {
+			if (sys_mem_blocks_alloc_contiguous(r->block_pool, n, &block) == 0) {
+				pool_sqe->buf = block;
+				pool_sqe->buf_len = MIN(n * blk_size, max_buf_len);
+				break;
+			}
+		}
+
+		if (sqe->buf == NULL) {
+			return -ENOMEM;
+		}
+	}
+#endif
+
+	if (sqe->buf_len < min_buf_len) {
+		return -ENOMEM;
+	}
+
+	*buf = sqe->buf;
+	*buf_len = sqe->buf_len;
+
+	return 0;
+}
+
+/**
+ * @brief Give back a buffer taken from the memory pool of an RTIO context
+ *
+ * @param r RTIO context
+ * @param buf Buffer of a completion queue event, may be NULL
+ * @param buf_len Length of the buffer
+ */
+static inline void rtio_release_buffer(struct rtio *r, void *buf, uint32_t buf_len)
+{
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+	if (buf != NULL) {
+		uint32_t blk_size = BIT(r->block_pool->blk_sz_shift);
+
+		sys_mem_blocks_free_contiguous(r->block_pool, buf,
+					       DIV_ROUND_UP(buf_len, blk_size));
+	}
+#endif
+}
+
+/**
+ * Submit a completion queue event with a given result, userdata and buffer
  *
  * Called by the executor to produce a completion queue event, no inherent
  * locking is performed and this is not safe to do from multiple callers.
+ * When the completion queue is full the buffer is given back to the memory
+ * pool.
  *
  * @param r RTIO context
  * @param result Integer result code (could be -errno)
  * @param userdata Userdata to pass along to completion
+ * @param buf Memory pool buffer to pass along to completion, may be NULL
+ * @param buf_len Length of the memory pool buffer
  */
-static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata)
+static inline void rtio_cqe_submit_buf(struct rtio *r, int result, void *userdata,
+				       uint8_t *buf, uint32_t buf_len)
 {
 	struct rtio_cqe *cqe = rtio_spsc_acquire(r->cq);
 
 	if (cqe == NULL) {
 		atomic_inc(&r->xcqcnt);
+		rtio_release_buffer(r, buf, buf_len);
 	} else {
 		cqe->result = result;
 		cqe->userdata = userdata;
+#ifdef CONFIG_RTIO_SYS_MEM_BLOCKS
+		cqe->buf = buf;
+		cqe->buf_len = buf_len;
+#endif
 		rtio_spsc_produce(r->cq);
 	}
 #ifdef CONFIG_RTIO_SUBMIT_SEM
@@ -612,6 +1040,47 @@ static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata)
 #endif
 }
 
+/**
+ * Submit a completion queue event with a given result and userdata
+ *
+ * @see rtio_cqe_submit_buf()
+ *
+ * @param r RTIO context
+ * @param result Integer result code (could be -errno)
+ * @param userdata Userdata to pass along to completion
+ */
+static inline void rtio_cqe_submit(struct rtio *r, int result, void *userdata)
+{
+	rtio_cqe_submit_buf(r, result, userdata, NULL, 0);
+}
+
+/**
+ * Submit the completion queue event of a request
+ *
+ * Passes along the memory pool buffer the request got, if any.
+ *
+ * @see rtio_cqe_submit_buf()
+ *
+ * @param r RTIO context
+ * @param result Integer result code (could be -errno)
+ * @param sqe Completed request
+ */
+static inline void rtio_cqe_submit_sqe(struct rtio *r, int result,
+				       const struct rtio_sqe *sqe)
+{
+	void *userdata = sqe->userdata;
+
+	if (sqe->flags & RTIO_SQE_PERIODIC) {
+		userdata = ((struct rtio_periodic *)userdata)->userdata;
+	}
+
+	if (sqe->flags & RTIO_SQE_MEMPOOL_BUFFER) {
+		rtio_cqe_submit_buf(r, result, userdata, sqe->buf, sqe->buf_len);
+	} else {
+		rtio_cqe_submit(r, result, userdata);
+	}
+}
+
 /* TODO add rtio_sqe_suspend() for suspending a submission chain that must
  * wait on other in progress submissions or submission chains.
  */
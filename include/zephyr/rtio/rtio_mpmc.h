@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+
+#ifndef ZEPHYR_RTIO_MPMC_H_
+#define ZEPHYR_RTIO_MPMC_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <zephyr/sys/atomic.h>
+
+/**
+ * @brief RTIO Multiple Producer Multiple Consumer (MPMC) Queue API
+ * @defgroup rtio_mpmc RTIO MPMC API
+ * @ingroup rtio
+ * @{
+ */
+
+/**
+ * @file rtio_mpmc.h
+ *
+ * @brief A lock-free and type safe power of 2 fixed sized multiple producer
+ * multiple consumer (MPMC) queue using a ringbuffer and atomics to ensure
+ * coherency.
+ *
+ * The MPMC queue follows the API of the SPSC queue, an element is acquired,
+ * filled and produced, then consumed, read and released. Any number of
+ * execution contexts (ISRs and threads, on any CPU) may produce and consume
+ * concurrently, and each may hold several acquired or consumed elements.
+ * Producing and releasing therefore take the element.
+ *
+ * Every slot of the ring has a turn counter telling whether it is free for
+ * the producers of a lap of the ring or holds an element for its consumers.
+ * Producers and consumers claim a slot with a compare and swap of the
+ * position of their side of the ring, then own it until it is produced or
+ * released. Slots are handed to consumers in the order they were acquired: an
+ * element produced while an older one is still being filled is only
+ * consumable once the older one is produced.
+ *
+ * Claiming may loop on contention, but never waits on another context: a
+ * full or empty queue is reported right away.
+ */
+
+/**
+ * @private
+ * @brief Common MPMC attributes
+ *
+ * @warning Not to be manipulated without the macros!
+ */
+struct rtio_mpmc {
+	/* position of the next element to acquire */
+	atomic_t in;
+
+	/* position of the next element to consume */
+	atomic_t out;
+
+	/* mask used to automatically wrap values */
+	const unsigned long mask;
+
+	/* turn counter of each slot, zero initialized */
+	atomic_t *const turns;
+};
+
+/**
+ * @brief Statically initialize an rtio_mpmc
+ *
+ * @param name Name of the mpmc symbol to be provided
+ * @param type Type stored in the mpmc
+ * @param sz Size of the mpmc, must be power of 2 of at least 2 (ex: 2, 4, 8)
+ */
+#define RTIO_MPMC_INITIALIZER(name, type, sz)	  \
+	{ ._mpmc = {				  \
+		  .in = ATOMIC_INIT(0),		  \
+		  .out = ATOMIC_INIT(0),	  \
+		  .mask = sz - 1,		  \
+		  .turns = name._turns,		  \
+	  },					  \
+	  ._turns = { 0 },			  \
+	}
+
+/**
+ * @brief Declare an anonymous struct type for an rtio_mpmc
+ *
+ * @param name Name of the mpmc symbol to be provided
+ * @param type Type stored in the mpmc
+ * @param sz Size of the mpmc, must be power of 2 of at least 2 (ex: 2, 4, 8)
+ */
+#define RTIO_MPMC_DECLARE(name, type, sz) \
+	struct rtio_mpmc_ ## name {	  \
+		struct rtio_mpmc _mpmc;	  \
+		type buffer[sz];	  \
+		atomic_t _turns[sz];	  \
+	}
+
+/**
+ * @brief Define an rtio_mpmc with a fixed size
+ *
+ * @param name Name of the mpmc symbol to be provided
+ * @param type Type stored in the mpmc
+ * @param sz Size of the mpmc, must be power of 2 of at least 2 (ex: 2, 4, 8)
+ */
+#define RTIO_MPMC_DEFINE(name, type, sz)                                                           \
+	RTIO_MPMC_DECLARE(name, type, sz) name = RTIO_MPMC_INITIALIZER(name, type, sz);
+
+/**
+ * @brief Size of the MPMC queue
+ *
+ * @param mpmc MPMC reference
+ */
+#define rtio_mpmc_size(mpmc) ((mpmc)->_mpmc.mask + 1)
+
+/**
+ * @private
+ * @brief Claim the slot at the position of one side of the ring
+ *
+ * A slot is claimed once its turn counter, relative to the lap of the
+ * position, reaches @p turn: 0 for producers, 1 for consumers.
+ *
+ * @return Index of the claimed slot or -1 if the ring is full (producers) or
+ *         empty (consumers)
+ */
+static inline long z_rtio_mpmc_claim(struct rtio_mpmc *mpmc, atomic_t *pos,
+				     unsigned long turn)
+{
+	unsigned long p = atomic_get(pos);
+
+	for (;;) {
+		unsigned long idx = p & mpmc->mask;
+		long dif = (long)(atomic_get(&mpmc->turns[idx]) - ((p & ~mpmc->mask) + turn));
+
+		if (dif == 0) {
+			if (atomic_cas(pos, p, p + 1)) {
+				return idx;
+			}
+		} else if (dif < 0) {
+			/* The slot is still owned by the previous lap */
+			return -1;
+		}
+
+		/* Another context claimed the slot first */
+		p = atomic_get(pos);
+	}
+}
+
+/**
+ * @brief Initialize/reset a mpmc such that its empty
+ *
+ * Note that this is not safe to do while being used in a producer/consumer
+ * situation with multiple calling contexts (isrs/threads).
+ *
+ * @param mpmc MPMC to initialize/reset
+ */
+#define rtio_mpmc_reset(mpmc)                                                                      \
+	({                                                                                         \
+		atomic_set(&(mpmc)->_mpmc.in, 0);                                                  \
+		atomic_set(&(mpmc)->_mpmc.out, 0);                                                 \
+		for (unsigned long _i = 0; _i < rtio_mpmc_size(mpmc); _i++) {                      \
+			atomic_set(&(mpmc)->_mpmc.turns[_i], 0);                                   \
+		}                                                                                  \
+	})
+
+/**
+ * @brief Acquire an element to produce from the MPMC
+ *
+ * @param mpmc MPMC to acquire an element from for producing
+ *
+ * @return A pointer to the acquired element or null if the mpmc is full
+ */
+#define rtio_mpmc_acquire(mpmc)                                                                    \
+	({                                                                                         \
+		long idx = z_rtio_mpmc_claim(&(mpmc)->_mpmc, &(mpmc)->_mpmc.in, 0);                \
+		idx >= 0 ? &((mpmc)->buffer[idx]) : NULL;                                          \
+	})
+
+/**
+ * @brief Produce a previously acquired element to the MPMC
+ *
+ * This makes the element available to the consumers once all elements
+ * acquired before it are produced as well
+ *
+ * @param mpmc MPMC to produce the element to
+ * @param item Acquired element
+ */
+#define rtio_mpmc_produce(mpmc, item)                                                              \
+	({                                                                                         \
+		atomic_inc(&(mpmc)->_mpmc.turns[(item) - (mpmc)->buffer]);                         \
+	})
+
+/**
+ * @brief Consume an element from the mpmc
+ *
+ * @param mpmc MPMC to consume from
+ *
+ * @return Pointer to element or null if no consumable elements left
+ */
+#define rtio_mpmc_consume(mpmc)                                                                    \
+	({                                                                                         \
+		long idx = z_rtio_mpmc_claim(&(mpmc)->_mpmc, &(mpmc)->_mpmc.out, 1);               \
+		idx >= 0 ? &((mpmc)->buffer[idx]) : NULL;                                          \
+	})
+
+/**
+ * @brief Release a consumed element
+ *
+ * The slot of the element is handed to the producers of the next lap.
+ *
+ * @param mpmc MPMC to release the element to
+ * @param item Consumed element
+ */
+#define rtio_mpmc_release(mpmc, item)                                                              \
+	({                                                                                         \
+		atomic_add(&(mpmc)->_mpmc.turns[(item) - (mpmc)->buffer],                          \
+			   (mpmc)->_mpmc.mask);                                                    \
+	})
+
+/**
+ * @brief Count of elements acquired and not yet consumed in mpmc
+ *
+ * The count is only a snapshot when other contexts use the mpmc, it includes
+ * elements still being filled.
+ *
+ * @param mpmc MPMC to get item count for
+ */
+#define rtio_mpmc_consumable(mpmc)                                                                 \
+	({ (unsigned long)(atomic_get(&(mpmc)->_mpmc.in) - atomic_get(&(mpmc)->_mpmc.out)); })
+
+/**
+ * @}
+ */
+
+#endif /* ZEPHYR_RTIO_MPMC_H_ */
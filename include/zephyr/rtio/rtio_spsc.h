@@ -231,6 +231,14 @@ struct rtio_spsc {
 #define rtio_spsc_consumable(spsc)                                                                 \
 	({ (spsc)->_spsc.in - (spsc)->_spsc.out - (spsc)->_spsc.consume; })
 
+/**
+ * @brief Count of elements that can be acquired from spsc
+ *
+ * @param spsc SPSC to get free element count for
+ */
+#define rtio_spsc_acquirable(spsc)                                                                 \
+	({ rtio_spsc_size(spsc) - ((spsc)->_spsc.in + (spsc)->_spsc.acquire - (spsc)->_spsc.out); })
+
 /**
  * @brief Peek at the first available item in queue
  *
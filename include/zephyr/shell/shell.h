@@ -735,6 +735,8 @@ struct shell_backend_ctx_flags {
 	uint32_t cmd_ctx      :1; /*!< Shell is executing command */
 	uint32_t print_noinit :1; /*!< Print request from not initialized shell */
 	uint32_t sync_mode    :1; /*!< Shell in synchronous mode */
+	uint32_t batch        :1; /*!< Shell in batch mode */
+	uint32_t batch_ovf    :1; /*!< Batch mode line exceeded buffer */
 };
 
 BUILD_ASSERT((sizeof(struct shell_backend_ctx_flags) == sizeof(uint32_t)),
@@ -1190,6 +1192,25 @@ int shell_use_colors_set(const struct shell *shell, bool val);
  */
 int shell_echo_set(const struct shell *shell, bool val);
 
+/**
+ * @brief Allow application to switch the shell to batch mode.
+ * Value is modified atomically and the previous value is returned.
+ *
+ * In batch mode input is not echoed, history, completion, colors and VT100
+ * handling are disabled and the prompt is not printed. Every received line is
+ * executed as is and followed by a status line: "OK" if the command
+ * returned 0, "ERR <ret>" otherwise. This is intended for feeding scripts
+ * to the shell from a host.
+ *
+ * @param[in] shell	Pointer to the shell instance.
+ * @param[in] val	Batch mode.
+ *
+ * @retval 0 or 1: previous value
+ * @retval -EINVAL if shell is NULL.
+ * @retval -ENOTSUP if batch mode is not enabled.
+ */
+int shell_batch_mode_set(const struct shell *shell, bool val);
+
 /**
  * @brief Allow application to control whether user input is obscured with
  * asterisks -- useful for implementing passwords.
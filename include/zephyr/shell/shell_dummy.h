@@ -25,6 +25,20 @@ struct shell_dummy {
 
 	/** output buffer to collect shell output */
 	char buf[CONFIG_SHELL_BACKEND_DUMMY_BUF_SIZE];
+
+	/** handler and context used to notify the shell about input */
+	shell_transport_handler_t evt_handler;
+	void *context;
+
+	/** protects the input buffer */
+	struct k_spinlock lock;
+
+	/** number of bytes in input buffer and number of bytes already read */
+	size_t in_len;
+	size_t in_pos;
+
+	/** input buffer with data pushed to the shell */
+	char in_buf[CONFIG_SHELL_BACKEND_DUMMY_BUF_SIZE];
 };
 
 #define SHELL_DUMMY_DEFINE(_name)					\
@@ -64,6 +78,22 @@ const char *shell_backend_dummy_get_output(const struct shell *shell,
  */
 void shell_backend_dummy_clear_output(const struct shell *shell);
 
+/**
+ * @brief Sends data to the shell as if it was received by the backend.
+ *
+ * The data is processed by the shell thread, like characters typed on a
+ * terminal.
+ *
+ * @param shell	Shell pointer
+ * @param data	Data to send
+ * @param len	Length of data
+ *
+ * @returns number of bytes accepted, lower than @p len if the input buffer
+ *	    is full
+ */
+size_t shell_backend_dummy_push_input(const struct shell *shell,
+				      const char *data, size_t len);
+
 #ifdef __cplusplus
 }
 #endif
@@ -92,6 +92,69 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
  */
 int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buff);
 
+#if defined(CONFIG_DISK_ACCESS_RTIO) || defined(__DOXYGEN__)
+/**
+ * @brief Get the RTIO device of a disk
+ *
+ * Requests prepared with disk_access_rtio_prep_read() and
+ * disk_access_rtio_prep_write() on the returned device are queued and
+ * performed asynchronously. Their completions are reported on the completion
+ * queue of the RTIO context they were submitted with, with a result of 0 on
+ * success or a negative errno code. The disk must be initialized with
+ * disk_access_init() first.
+ *
+ * @param[in] pdrv          Disk name
+ *
+ * @return RTIO device, or NULL if the disk does not exist or does not support
+ *         asynchronous access
+ */
+struct rtio_iodev *disk_access_rtio_iodev(const char *pdrv);
+
+/**
+ * @brief Prepare an asynchronous read of disk sectors
+ *
+ * @param[out] sqe          Submission queue entry to prepare
+ * @param[in] iodev         RTIO device of the disk
+ * @param[in] data_buf      Pointer to the memory buffer to put data.
+ * @param[in] start_sector  Start disk sector to read from
+ * @param[in] len           Number of bytes to read, a multiple of the
+ *                          sector size
+ * @param[in] userdata      Value reported in the completion queue event
+ */
+static inline void disk_access_rtio_prep_read(struct rtio_sqe *sqe,
+					      struct rtio_iodev *iodev,
+					      uint8_t *data_buf,
+					      uint32_t start_sector,
+					      uint32_t len, void *userdata)
+{
+	rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, data_buf, len, userdata);
+	sqe->offset = start_sector;
+}
+
+/**
+ * @brief Prepare an asynchronous write of disk sectors
+ *
+ * @param[out] sqe          Submission queue entry to prepare
+ * @param[in] iodev         RTIO device of the disk
+ * @param[in] data_buf      Pointer to the memory buffer, which must stay
+ *                          valid until completion
+ * @param[in] start_sector  Start disk sector to write to
+ * @param[in] len           Number of bytes to write, a multiple of the
+ *                          sector size
+ * @param[in] userdata      Value reported in the completion queue event
+ */
+static inline void disk_access_rtio_prep_write(struct rtio_sqe *sqe,
+					       struct rtio_iodev *iodev,
+					       const uint8_t *data_buf,
+					       uint32_t start_sector,
+					       uint32_t len, void *userdata)
+{
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, (uint8_t *)data_buf,
+			    len, userdata);
+	sqe->offset = start_sector;
+}
+#endif
+
 #ifdef __cplusplus
 }
 #endif
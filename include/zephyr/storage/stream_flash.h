@@ -22,6 +22,10 @@
 
 #include <stdbool.h>
 #include <zephyr/drivers/flash.h>
+#if defined(CONFIG_STREAM_FLASH_BACKGROUND) || \
+	defined(CONFIG_STREAM_FLASH_PRE_ERASE)
+#include <zephyr/kernel.h>
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -44,6 +48,18 @@ extern "C" {
  */
 typedef int (*stream_flash_callback_t)(uint8_t *buf, size_t len, size_t offset);
 
+/**
+ * @brief Progress and statistics of the background pre-erase.
+ */
+struct stream_flash_pre_erase_stats {
+	size_t erased; /* Bytes of the pre-erase range erased so far */
+	size_t total; /* Size of the pre-erase range */
+	uint32_t hits; /* Pages written that were already erased ahead */
+	uint32_t misses; /* Pages the writes had to erase themselves */
+	int error; /* Error which stopped the pre-erase, 0 if none */
+	bool active; /* Pre-erase is running */
+};
+
 /**
  * @brief Structure for stream flash context
  *
@@ -62,6 +78,27 @@ struct stream_flash_ctx {
 #ifdef CONFIG_STREAM_FLASH_ERASE
 	off_t last_erased_page_start_offset; /* Last erased offset */
 #endif
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+	/* Buffer split into slots, NULL if not in background mode */
+	uint8_t *slots;
+	/* Number of bytes queued in each slot */
+	size_t slot_bytes[CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS];
+	uint8_t fill_slot; /* Slot being filled by the caller */
+	uint8_t write_slot; /* Next slot to be programmed */
+	atomic_t queued; /* Number of slots waiting to be programmed */
+	struct k_sem free_slots; /* Slots available to the caller */
+	struct k_work work; /* Background writer work item */
+	size_t bytes_queued; /* Bytes handed to the writer since init */
+	int error; /* First error of the background writer */
+#endif
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+	struct k_work_delayable pre_erase_work; /* Pre-erase work item */
+	struct k_mutex pre_erase_lock; /* Serializes page erases */
+	off_t pre_erase_start; /* First page erased ahead */
+	off_t pre_erase_next; /* Next page to be erased ahead */
+	off_t pre_erase_end; /* End of the write area */
+	struct stream_flash_pre_erase_stats pre_erase_stats;
+#endif
 };
 
 /**
@@ -83,6 +120,42 @@ struct stream_flash_ctx {
 int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		      uint8_t *buf, size_t buf_len, size_t offset, size_t size,
 		      stream_flash_callback_t cb);
+/**
+ * @brief Initialize context for stream writes to flash in the background.
+ *
+ * Same as @ref stream_flash_init, but the write buffer is split into
+ * CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS slots of equal size. Whenever a slot
+ * is full it is programmed from a background thread, while
+ * @ref stream_flash_buffered_write returns and the caller fills the next
+ * slot. The callback, if any, is invoked from the background thread.
+ *
+ * Data is only guaranteed to be in the flash after a flush write returned.
+ * Until then, @ref stream_flash_bytes_written may lag behind the amount of
+ * data passed in, and @ref stream_flash_erase_page must not be used.
+ *
+ * Initializing the context again drops the slots not yet programmed, after
+ * waiting for the one being programmed, if any.
+ *
+ * @param ctx context to be initialized
+ * @param fdev Flash device to operate on
+ * @param buf Write buffer
+ * @param buf_len Length of write buffer. Each slot (buf_len divided by
+ *                CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS) can not be larger
+ *                than the page size and must be multiple of the flash device
+ *                write-block-size.
+ * @param offset Offset within flash device to start writing to
+ * @param size Number of bytes available for performing buffered write.
+ *             If this is '0', the size will be set to the total size
+ *             of the flash device minus the offset.
+ * @param cb Callback to be invoked on completed flash write operations.
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_init_background(struct stream_flash_ctx *ctx,
+				 const struct device *fdev, uint8_t *buf,
+				 size_t buf_len, size_t offset, size_t size,
+				 stream_flash_callback_t cb);
+
 /**
  * @brief Read number of bytes written to the flash.
  *
@@ -108,8 +181,12 @@ size_t stream_flash_bytes_written(struct stream_flash_ctx *ctx);
  *        A flush write should be the last write operation in a sequence of
  *        write operations for given context (although this is not mandatory
  *        if the total data size is a multiple of the buffer size).
+ *        For a context in background mode, a flush write also waits until
+ *        all queued data is programmed.
  *
- * @return non-negative on success, negative errno code on fail
+ * @return non-negative on success, negative errno code on fail. In
+ *         background mode, the error of a failed background write is
+ *         returned by the next call.
  */
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush);
@@ -128,6 +205,48 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
  */
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off);
 
+/**
+ * @brief Start erasing the rest of the write area in the background.
+ *
+ * Pages from the current write position to the end of the write area are
+ * erased in order from a low priority thread, waiting
+ * CONFIG_STREAM_FLASH_PRE_ERASE_INTERVAL_MS after each one. Writes to pages
+ * erased ahead do not erase them again, so they do not wait for the erase.
+ * A write that catches up with the thread erases the page itself.
+ *
+ * The pre-erase is stopped by a flush write. It must also be stopped before
+ * the context is initialized again.
+ *
+ * @param ctx context
+ *
+ * @return non-negative on success, -EALREADY if the pre-erase is already
+ *         running, negative errno code on other failures
+ */
+int stream_flash_pre_erase_start(struct stream_flash_ctx *ctx);
+
+/**
+ * @brief Stop the background pre-erase.
+ *
+ * Waits for the page erase in progress, if any. Pages already erased ahead
+ * are still not erased again by later writes.
+ *
+ * @param ctx context
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_pre_erase_stop(struct stream_flash_ctx *ctx);
+
+/**
+ * @brief Get the progress and statistics of the background pre-erase.
+ *
+ * @param ctx context
+ * @param stats structure filled with the current progress and statistics
+ *
+ * @return non-negative on success, negative errno code on fail
+ */
+int stream_flash_pre_erase_stats_get(struct stream_flash_ctx *ctx,
+				     struct stream_flash_pre_erase_stats *stats);
+
 /**
  * @brief Load persistent stream write progress stored with key
  *        @p settings_key .
@@ -1223,6 +1223,34 @@ uint32_t arch_timing_freq_get_mhz(void);
 
 #endif /* CONFIG_TIMING_FUNCTIONS */
 
+#ifdef CONFIG_PROFILER
+
+/**
+ * @defgroup arch-profiler Architecture-specific profiler APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+/**
+ * @brief Capture the code interrupted by the current interrupt
+ *
+ * Must be called from the handler of an interrupt that preempted thread
+ * context. The first entry written is the interrupted program counter, the
+ * following ones are the return addresses found by walking the frame
+ * pointer chain of the interrupted code, innermost first.
+ *
+ * @param pcs Array to fill with program counters
+ * @param depth Size of @a pcs
+ *
+ * @return Number of entries written into @a pcs, 0 if the interrupted
+ *         context could not be determined (e.g. nested interrupt)
+ */
+size_t arch_profiler_backtrace(uintptr_t *pcs, size_t depth);
+
+/** @} */
+
+#endif /* CONFIG_PROFILER */
+
 #ifdef CONFIG_PCIE_MSI_MULTI_VECTOR
 
 struct msi_vector;
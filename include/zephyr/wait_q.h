@@ -31,6 +31,9 @@ static inline void z_waitq_init(_wait_q_t *w)
 			.lessthan_fn = z_priq_rb_lessthan
 		}
 	};
+#ifdef CONFIG_KERNEL_OBJ_STATS
+	w->stats = (struct k_obj_stats) {};
+#endif
 }
 
 static inline struct k_thread *z_waitq_head(_wait_q_t *w)
@@ -47,6 +50,9 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 static inline void z_waitq_init(_wait_q_t *w)
 {
 	sys_dlist_init(&w->waitq);
+#ifdef CONFIG_KERNEL_OBJ_STATS
+	w->stats = (struct k_obj_stats) {};
+#endif
 }
 
 static inline struct k_thread *z_waitq_head(_wait_q_t *w)
@@ -56,6 +62,18 @@ static inline struct k_thread *z_waitq_head(_wait_q_t *w)
 
 #endif /* !CONFIG_WAITQ_SCALABLE */
 
+#ifdef CONFIG_KERNEL_OBJ_STATS
+/* Account one successful take/lock/get of the object owning the wait
+ * queue, must be called with the object lock held.
+ */
+static inline void z_waitq_stats_acquired(_wait_q_t *w)
+{
+	w->stats.acquisitions++;
+}
+#else
+#define z_waitq_stats_acquired(w) do { } while (false)
+#endif
+
 #ifdef __cplusplus
 }
 #endif
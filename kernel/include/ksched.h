@@ -396,9 +396,46 @@ void z_sched_cpu_usage(uint8_t core_id, struct k_thread_runtime_stats *stats);
 void z_sched_thread_usage(struct k_thread *thread,
 			  struct k_thread_runtime_stats *stats);
 
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+/**
+ * @brief Record that a thread has been made ready to run
+ *
+ * Starts the ready -> running latency measurement for @a thread. Called
+ * with the scheduler lock held when the thread is added to the run queue.
+ */
+void z_sched_hist_ready(struct k_thread *thread);
+
+/**
+ * @brief Close the execution window of the current thread
+ *
+ * Called on context switch alongside z_sched_usage_stop().
+ */
+void z_sched_hist_stop(void);
+
+/**
+ * @brief Open an execution window for a thread being switched in
+ *
+ * Called on context switch alongside z_sched_usage_start().
+ */
+void z_sched_hist_start(struct k_thread *thread);
+#else
+#define z_sched_hist_ready(thread) do { } while (false)
+#define z_sched_hist_stop()        do { } while (false)
+#define z_sched_hist_start(thread) do { } while (false)
+#endif
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+	/* The uniprocessor switch path may "switch" to the current thread,
+	 * which must not split its execution window in the histograms.
+	 */
+	if (thread != _current) {
+		z_sched_hist_stop();
+		z_sched_hist_start(thread);
+	}
+#endif
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
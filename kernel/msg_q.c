@@ -134,6 +134,7 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 			/* give message to waiting thread */
 			(void)memcpy(pending_thread->base.swap_data, data,
 			       msgq->msg_size);
+			z_waitq_stats_acquired(&msgq->wait_q);
 			/* wake up waiting thread */
 			arch_thread_return_value_set(pending_thread, 0);
 			z_ready_thread(pending_thread);
@@ -223,6 +224,7 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 			msgq->read_ptr = msgq->buffer_start;
 		}
 		msgq->used_msgs--;
+		z_waitq_stats_acquired(&msgq->wait_q);
 
 		/* handle first thread waiting to write (if any) */
 		pending_thread = z_unpend_first_thread(&msgq->wait_q);
@@ -112,6 +112,7 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 		mutex->lock_count++;
 		mutex->owner = _current;
+		z_waitq_stats_acquired(&mutex->wait_q);
 
 		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
 			_current, mutex, mutex->lock_count,
@@ -252,6 +253,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * adjust its priority
 		 */
 		mutex->owner_orig_prio = new_owner->base.prio;
+		z_waitq_stats_acquired(&mutex->wait_q);
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
 		z_reschedule(&lock, key);
@@ -392,6 +392,26 @@ static int pipe_return_code(size_t min_xfer, size_t bytes_remaining,
 	return -EAGAIN;
 }
 
+#ifdef CONFIG_KERNEL_OBJ_STATS
+/*
+ * Account a put or get which transferred data, including the ones completed
+ * by another thread while the caller was pending. Called without the pipe
+ * lock held, once the outcome is known.
+ */
+static void pipe_stats_update(struct k_pipe *pipe, _wait_q_t *wait_q,
+			      int ret, size_t bytes)
+{
+	if ((ret == 0) && (bytes > 0U)) {
+		k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+		z_waitq_stats_acquired(wait_q);
+		k_spin_unlock(&pipe->lock, key);
+	}
+}
+#else
+#define pipe_stats_update(pipe, wait_q, ret, bytes) do { } while (false)
+#endif
+
 int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 		     size_t *bytes_written, size_t min_xfer,
 		      k_timeout_t timeout)
@@ -490,6 +510,8 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	if (num_bytes_written == bytes_to_write) {
 		*bytes_written = num_bytes_written;
 		k_sched_unlock();
+		pipe_stats_update(pipe, &pipe->wait_q.writers, 0,
+				  num_bytes_written);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, 0);
 
@@ -501,6 +523,8 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 	    && min_xfer > 0U) {
 		*bytes_written = num_bytes_written;
 		k_sched_unlock();
+		pipe_stats_update(pipe, &pipe->wait_q.writers, 0,
+				  num_bytes_written);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, 0);
 
@@ -532,6 +556,7 @@ int z_impl_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 
 	int ret = pipe_return_code(min_xfer, pipe_desc.bytes_to_xfer,
 				   bytes_to_write);
+	pipe_stats_update(pipe, &pipe->wait_q.writers, ret, *bytes_written);
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, ret);
 	return ret;
 }
@@ -738,6 +763,8 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 	int ret = pipe_get_internal(key, pipe, data, bytes_to_read, bytes_read,
 				    min_xfer, timeout);
 
+	pipe_stats_update(pipe, &pipe->wait_q.readers, ret, *bytes_read);
+
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, ret);
 
 	return ret;
@@ -133,6 +133,7 @@ static int32_t queue_insert(struct k_queue *queue, void *prev, void *data,
 	if (first_pending_thread != NULL) {
 		SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_queue, queue_insert, queue, alloc, K_FOREVER);
 
+		z_waitq_stats_acquired(&queue->wait_q);
 		prepare_thread_to_run(first_pending_thread, data);
 		z_reschedule(&queue->lock, key);
 
@@ -260,6 +261,7 @@ int k_queue_append_list(struct k_queue *queue, void *head, void *tail)
 	}
 
 	while ((head != NULL) && (thread != NULL)) {
+		z_waitq_stats_acquired(&queue->wait_q);
 		prepare_thread_to_run(thread, head);
 		head = *(void **)head;
 		thread = z_unpend_first_thread(&queue->wait_q);
@@ -323,6 +325,7 @@ void *z_impl_k_queue_get(struct k_queue *queue, k_timeout_t timeout)
 
 		node = sys_sflist_get_not_empty(&queue->data_q);
 		data = z_queue_node_peek(node, true);
+		z_waitq_stats_acquired(&queue->wait_q);
 		k_spin_unlock(&queue->lock, key);
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_queue, get, queue, timeout, data);
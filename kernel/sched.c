@@ -624,6 +624,7 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+		z_sched_hist_ready(thread);
 		queue_thread(thread);
 		update_cache(0);
 		flag_ipi();
@@ -734,6 +735,53 @@ static void unready_thread(struct k_thread *thread)
 	update_cache(thread == _current);
 }
 
+#ifdef CONFIG_KERNEL_OBJ_STATS
+/* sched_spinlock must be held */
+static void waitq_stats_pend(_wait_q_t *wait_q, struct k_thread *thread)
+{
+	struct k_obj_stats *stats = &wait_q->stats;
+
+	stats->contended++;
+	stats->waiters++;
+	stats->max_waiters = MAX(stats->max_waiters, stats->waiters);
+	thread->base.pend_start = k_cycle_get_32();
+}
+
+/* sched_spinlock must be held */
+static void waitq_stats_unpend(_wait_q_t *wait_q, struct k_thread *thread)
+{
+	struct k_obj_stats *stats = &wait_q->stats;
+	uint32_t waited = k_cycle_get_32() - thread->base.pend_start;
+
+	stats->waiters--;
+	stats->wait_total += waited;
+	stats->wait_max = MAX(stats->wait_max, waited);
+}
+
+void z_waitq_stats_get(_wait_q_t *wait_q, struct k_obj_stats *stats)
+{
+	LOCKED(&sched_spinlock) {
+		*stats = wait_q->stats;
+	}
+}
+
+void z_waitq_stats_reset(_wait_q_t *wait_q)
+{
+	LOCKED(&sched_spinlock) {
+		uint32_t waiters = wait_q->stats.waiters;
+
+		/* Threads still pending will be accounted when woken */
+		wait_q->stats = (struct k_obj_stats) {
+			.waiters = waiters,
+			.max_waiters = waiters,
+		};
+	}
+}
+#else
+#define waitq_stats_pend(wait_q, thread) do { } while (false)
+#define waitq_stats_unpend(wait_q, thread) do { } while (false)
+#endif
+
 /* sched_spinlock must be held */
 static void add_to_waitq_locked(struct k_thread *thread, _wait_q_t *wait_q)
 {
@@ -745,6 +793,7 @@ static void add_to_waitq_locked(struct k_thread *thread, _wait_q_t *wait_q)
 	if (wait_q != NULL) {
 		thread->base.pended_on = wait_q;
 		z_priq_wait_add(&wait_q->waitq, thread);
+		waitq_stats_pend(wait_q, thread);
 	}
 }
 
@@ -778,6 +827,7 @@ void z_pend_thread(struct k_thread *thread, _wait_q_t *wait_q,
 
 static inline void unpend_thread_no_timeout(struct k_thread *thread)
 {
+	waitq_stats_unpend(pended_on_thread(thread), thread);
 	_priq_wait_remove(&pended_on_thread(thread)->waitq, thread);
 	z_mark_thread_as_not_pending(thread);
 	thread->base.pended_on = NULL;
@@ -93,6 +93,7 @@ void z_impl_k_sem_give(struct k_sem *sem)
 	thread = z_unpend_first_thread(&sem->wait_q);
 
 	if (thread != NULL) {
+		z_waitq_stats_acquired(&sem->wait_q);
 		arch_thread_return_value_set(thread, 0);
 		z_ready_thread(thread);
 	} else {
@@ -127,6 +128,7 @@ int z_impl_k_sem_take(struct k_sem *sem, k_timeout_t timeout)
 
 	if (likely(sem->count > 0U)) {
 		sem->count--;
+		z_waitq_stats_acquired(&sem->wait_q);
 		k_spin_unlock(&lock, key);
 		ret = 0;
 		goto out;
@@ -632,6 +632,12 @@ char *z_setup_new_thread(struct k_thread *new_thread,
 		CONFIG_SCHED_THREAD_USAGE_AUTO_ENABLE;
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+	new_thread->base.hist_ready = 0;
+	new_thread->base.hist_run = 0;
+	new_thread->base.hist = (struct k_thread_sched_hist) {};
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC(k_thread, create, new_thread);
 
 	return stack_ptr;
@@ -1044,6 +1050,7 @@ void z_thread_mark_switched_in(void)
 {
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
 	z_sched_usage_start(_current);
+	z_sched_hist_start(_current);
 #endif
 
 #ifdef CONFIG_TRACING
@@ -1054,6 +1061,7 @@ void z_thread_mark_switched_in(void)
 void z_thread_mark_switched_out(void)
 {
 #if defined(CONFIG_SCHED_THREAD_USAGE) && !defined(CONFIG_USE_SWITCH)
+	z_sched_hist_stop();
 	z_sched_usage_stop();
 #endif
 
@@ -334,3 +334,94 @@ void k_sys_runtime_stats_disable(void)
 	k_spin_unlock(&usage_lock, key);
 }
 #endif
+
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+static void sched_hist_add(uint32_t *hist, uint32_t *max, uint32_t cycles)
+{
+	unsigned int bucket = find_msb_set(cycles);
+
+	if (bucket >= CONFIG_SCHED_THREAD_HISTOGRAM_BUCKETS) {
+		bucket = CONFIG_SCHED_THREAD_HISTOGRAM_BUCKETS - 1;
+	}
+
+	hist[bucket]++;
+
+	if (*max < cycles) {
+		*max = cycles;
+	}
+}
+
+void z_sched_hist_ready(struct k_thread *thread)
+{
+	thread->base.hist_ready = usage_now();
+}
+
+void z_sched_hist_stop(void)
+{
+	struct k_thread *thread = _current;
+	uint32_t now = usage_now();
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+
+	if (thread->base.hist_run != 0) {
+		sched_hist_add(thread->base.hist.run, &thread->base.hist.run_max,
+			       now - thread->base.hist_run);
+		thread->base.hist_run = 0;
+	}
+
+	/* A preempted thread stays in the run queue without going through
+	 * z_ready_thread(), so its wait for the CPU starts right here.
+	 */
+	if (z_is_thread_ready(thread)) {
+		thread->base.hist_ready = now;
+	}
+
+	k_spin_unlock(&usage_lock, key);
+}
+
+void z_sched_hist_start(struct k_thread *thread)
+{
+	uint32_t now = usage_now();
+	k_spinlock_key_t key = k_spin_lock(&usage_lock);
+
+	if (thread->base.hist_ready != 0) {
+		sched_hist_add(thread->base.hist.wait,
+			       &thread->base.hist.wait_max,
+			       now - thread->base.hist_ready);
+		thread->base.hist_ready = 0;
+	}
+
+	thread->base.hist_run = now;
+
+	k_spin_unlock(&usage_lock, key);
+}
+
+int k_thread_sched_hist_get(k_tid_t thread, struct k_thread_sched_hist *hist)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF((thread == NULL) || (hist == NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	*hist = thread->base.hist;
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+
+int k_thread_sched_hist_reset(k_tid_t thread)
+{
+	k_spinlock_key_t key;
+
+	CHECKIF(thread == NULL) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&usage_lock);
+	thread->base.hist = (struct k_thread_sched_hist) {};
+	k_spin_unlock(&usage_lock, key);
+
+	return 0;
+}
+#endif
@@ -11,20 +11,25 @@
 
 LOG_MODULE_REGISTER(main);
 
-#define N		(8)
-#define M		(N/2)
+#define N		(16)
+#define M		(4)
 #define SQ_SZ		(N)
 #define CQ_SZ		(N)
+#define POOL_BLKS	(2 * M)
 
 #define NODE_ID		DT_INST(0, vnd_sensor)
 #define SAMPLE_PERIOD	DT_PROP(NODE_ID, sample_period)
 #define SAMPLE_SIZE	DT_PROP(NODE_ID, sample_size)
 #define PROCESS_TIME	((M - 1) * SAMPLE_PERIOD)
 
+/* Sample buffers are taken from the memory pool only when the sensor has
+ * data, read requests waiting in the queue do not hold one. The pool only
+ * needs to hold the batch being processed and the samples read meanwhile,
+ * however many read requests are queued.
+ */
 RTIO_EXECUTOR_SIMPLE_DEFINE(simple_exec);
-RTIO_DEFINE(ez_io, (struct rtio_executor *)&simple_exec, SQ_SZ, CQ_SZ);
-
-static uint8_t bufs[N][SAMPLE_SIZE];
+RTIO_DEFINE_WITH_MEMPOOL(ez_io, (struct rtio_executor *)&simple_exec, SQ_SZ,
+			 CQ_SZ, POOL_BLKS, SAMPLE_SIZE, 4);
 
 void main(void)
 {
@@ -35,14 +40,16 @@ void main(void)
 	for (int n = 0; n < N; n++) {
 		struct rtio_sqe *sqe = rtio_spsc_acquire(ez_io.sq);
 
-		rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_HIGH, bufs[n],
-				   SAMPLE_SIZE, bufs[n]);
+		rtio_sqe_prep_read_with_pool(sqe, iodev, RTIO_PRIO_HIGH, NULL);
 		rtio_spsc_produce(ez_io.sq);
 	}
 
+	LOG_INF("%d read requests queued for %d pool blocks", N, POOL_BLKS);
+
 	while (true) {
 		int m = 0;
-		uint8_t *userdata[M];
+		uint8_t *bufs[M];
+		uint32_t buf_lens[M];
 
 		LOG_INF("Submitting %d read requests", M);
 		rtio_submit(&ez_io, M);
@@ -65,7 +72,8 @@ void main(void)
 				LOG_ERR("Operation failed");
 			}
 
-			userdata[m] = cqe->userdata;
+			bufs[m] = cqe->buf;
+			buf_lens[m] = cqe->buf_len;
 			rtio_spsc_release(ez_io.cq);
 			m++;
 		}
@@ -78,20 +86,24 @@ void main(void)
 		 */
 		LOG_INF("Start processing %d samples", M);
 		for (m = 0; m < M; m++) {
-			LOG_HEXDUMP_DBG(userdata[m], SAMPLE_SIZE, "Sample data:");
+			LOG_HEXDUMP_DBG(bufs[m], buf_lens[m], "Sample data:");
 		}
 		k_msleep(PROCESS_TIME);
 		LOG_INF("Finished processing %d samples", M);
 
-		/* Recycle the sensor data buffers and refill the submission
-		 * queue.
+		/* The batch and the samples read while it was processed */
+		LOG_INF("%d of %d pool blocks in use",
+			M + (int)rtio_spsc_consumable(ez_io.cq), POOL_BLKS);
+
+		/* Give the sensor data buffers back to the memory pool and
+		 * refill the submission queue.
 		 */
 		for (m = 0; m < M; m++) {
 			struct rtio_sqe *sqe = rtio_spsc_acquire(ez_io.sq);
 
-			rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_HIGH,
-					   userdata[m], SAMPLE_SIZE,
-					   userdata[m]);
+			rtio_release_buffer(&ez_io, bufs[m], buf_lens[m]);
+			rtio_sqe_prep_read_with_pool(sqe, iodev, RTIO_PRIO_HIGH,
+						     NULL);
 			rtio_spsc_produce(ez_io.sq);
 		}
 	}
@@ -33,13 +33,24 @@ struct vnd_sensor_data {
 	uint32_t sample_number;
 };
 
-static int vnd_sensor_iodev_read(const struct device *dev, uint8_t *buf,
-		uint32_t buf_len)
+static int vnd_sensor_iodev_read(const struct device *dev,
+		const struct rtio_sqe *sqe, struct rtio *r)
 {
 	const struct vnd_sensor_config *config = dev->config;
 	struct vnd_sensor_data *data = dev->data;
 	uint32_t sample_number;
+	uint32_t buf_len;
+	uint8_t *buf;
 	uint32_t key;
+	int rc;
+
+	/* The buffer may only now be taken from the memory pool */
+	rc = rtio_sqe_rx_buf(r, sqe, config->sample_size, config->sample_size,
+			     &buf, &buf_len);
+	if (rc != 0) {
+		LOG_ERR("%s: No buffer for the sample", dev->name);
+		return rc;
+	}
 
 	LOG_DBG("%s: buf_len = %d, buf = %p", dev->name, buf_len, buf);
 
@@ -47,11 +58,6 @@ static int vnd_sensor_iodev_read(const struct device *dev, uint8_t *buf,
 	sample_number = data->sample_number++;
 	irq_unlock(key);
 
-	if (buf_len < config->sample_size) {
-		LOG_ERR("%s: Buffer is too small", dev->name);
-		return -ENOMEM;
-	}
-
 	for (int i = 0; i < MIN(config->sample_size, buf_len); i++) {
 		buf[i] = sample_number * config->sample_size + i;
 	}
@@ -65,7 +71,7 @@ static void vnd_sensor_iodev_execute(const struct device *dev,
 	int result;
 
 	if (sqe->op == RTIO_OP_RX) {
-		result = vnd_sensor_iodev_read(dev, sqe->buf, sqe->buf_len);
+		result = vnd_sensor_iodev_read(dev, sqe, r);
 	} else {
 		LOG_ERR("%s: Invalid op", dev->name);
 		result = -EINVAL;
@@ -0,0 +1,104 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2022 The Zephyr Project Contributors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+"""
+Convert the output of the "profiler dump" shell command into the folded
+stack format understood by flamegraph.pl and speedscope.
+
+Every "prof: <count> <pc>;<pc>;..." line of the input (innermost program
+counter first) is resolved against the function symbols of the ELF image
+and emitted as "<outer>;...;<inner> <count>". Identical stacks are merged.
+"""
+
+import argparse
+import bisect
+import re
+import sys
+from collections import Counter
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+SAMPLE_RE = re.compile(r'prof:\s+(\d+)\s+((?:0x[0-9a-fA-F]+;?)+)')
+
+
+class SymbolResolver:
+    def __init__(self, elf_path):
+        funcs = []
+        with open(elf_path, 'rb') as f:
+            elf = ELFFile(f)
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+                for sym in section.iter_symbols():
+                    if sym['st_info']['type'] != 'STT_FUNC':
+                        continue
+                    # Drop the Thumb bit, it is not part of the address
+                    addr = sym['st_value'] & ~1
+                    funcs.append((addr, sym['st_size'], sym.name))
+
+        funcs.sort()
+        self.addrs = [f[0] for f in funcs]
+        self.funcs = funcs
+
+    def resolve(self, addr):
+        i = bisect.bisect_right(self.addrs, addr) - 1
+        if i >= 0:
+            start, size, name = self.funcs[i]
+            if size == 0 or addr < start + size:
+                return name
+        return hex(addr)
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('elf', help='Zephyr ELF image (zephyr.elf)')
+    parser.add_argument('input', nargs='?', type=argparse.FileType('r'),
+                        default=sys.stdin,
+                        help='captured shell output (default: stdin)')
+    parser.add_argument('-o', '--output', type=argparse.FileType('w'),
+                        default=sys.stdout,
+                        help='folded stacks output (default: stdout)')
+    parser.add_argument('--trim', action='append', default=[],
+                        metavar='SYMBOL',
+                        help='drop this function and every frame inside it '
+                             '(e.g. interrupt entry code), may be repeated')
+    return parser.parse_args()
+
+
+def main():
+    args = parse_args()
+    resolver = SymbolResolver(args.elf)
+    stacks = Counter()
+
+    for line in args.input:
+        match = SAMPLE_RE.search(line)
+        if not match:
+            continue
+
+        count = int(match.group(1))
+        pcs = [int(pc, 16) for pc in match.group(2).split(';') if pc]
+
+        # Every entry but the first is a return address, which points
+        # after the call instruction and possibly past the caller's end.
+        frames = [resolver.resolve(pc if i == 0 else pc - 1)
+                  for i, pc in enumerate(pcs)]
+
+        for sym in args.trim:
+            if sym in frames:
+                frames = frames[frames.index(sym) + 1:]
+
+        if frames:
+            stacks[';'.join(reversed(frames))] += count
+
+    for stack, count in sorted(stacks.items()):
+        args.output.write(f'{stack} {count}\n')
+
+
+if __name__ == '__main__':
+    main()
@@ -788,7 +788,7 @@ static int hci_driver_close(void)
 static const struct bt_hci_driver drv = {
 	.name	= "Controller",
 	.bus	= BT_HCI_DRIVER_BUS_VIRTUAL,
-	.quirks = BT_QUIRK_NO_AUTO_DLE,
+	.quirks = BT_QUIRK_NO_AUTO_DLE | BT_QUIRK_TX_DATA_COPIED,
 	.open	= hci_driver_open,
 	.close	= hci_driver_close,
 	.send	= hci_driver_send,
@@ -625,6 +625,46 @@ static struct net_buf *create_frag(struct bt_conn *conn, struct net_buf *buf)
 	return frag;
 }
 
+#if defined(CONFIG_BT_CONN)
+/*
+ * Send all the fragments from the original buffer. The ACL header of each
+ * fragment is written over the end of the previous one, which the driver
+ * no longer needs once send() has returned.
+ */
+static bool send_buf_in_place(struct bt_conn *conn, struct net_buf *buf)
+{
+	struct bt_conn_tx *tx = tx_data(buf)->tx;
+	uint16_t mtu = conn_mtu(conn);
+	uint8_t flags = FRAG_START;
+
+	while (buf->len > mtu) {
+		uint8_t *next = buf->data + mtu;
+		uint16_t next_len = buf->len - mtu;
+
+		buf->len = mtu;
+
+		/* Fragments never have a TX completion callback, the type set
+		 * by the previous one has also overwritten it.
+		 */
+		tx_data(buf)->tx = NULL;
+
+		/* The driver releases the fragment, keep the buffer */
+		if (!send_frag(conn, net_buf_ref(buf), flags, true)) {
+			tx_data(buf)->tx = tx;
+			return false;
+		}
+
+		buf->data = next;
+		buf->len = next_len;
+		flags = FRAG_CONT;
+	}
+
+	tx_data(buf)->tx = tx;
+
+	return send_frag(conn, buf, FRAG_END, false);
+}
+#endif /* CONFIG_BT_CONN */
+
 static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 {
 	struct net_buf *frag;
@@ -636,6 +676,13 @@ static bool send_buf(struct bt_conn *conn, struct net_buf *buf)
 		return send_frag(conn, buf, FRAG_SINGLE, false);
 	}
 
+#if defined(CONFIG_BT_CONN)
+	if (conn->type != BT_CONN_TYPE_ISO &&
+	    (bt_dev.drv->quirks & BT_QUIRK_TX_DATA_COPIED)) {
+		return send_buf_in_place(conn, buf);
+	}
+#endif /* CONFIG_BT_CONN */
+
 	/* Create & enqueue first fragment */
 	frag = create_frag(conn, buf);
 	if (!frag) {
@@ -83,6 +83,23 @@ static sys_slist_t callback_list;
 static sys_slist_t db;
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+/* Static attributes by handle, starting with handle 0x0001. Only used if
+ * all static attributes fit.
+ */
+static const struct bt_gatt_attr *static_attrs[CONFIG_BT_GATT_ATTR_INDEX_STATIC_SIZE];
+static bool static_attrs_indexed;
+
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+/* Dynamic services in the same ascending handle order as db. Only used if
+ * all dynamic services fit.
+ */
+static struct bt_gatt_service *dyn_svcs[CONFIG_BT_GATT_ATTR_INDEX_DYNAMIC_SIZE];
+static size_t dyn_svcs_count;
+static bool dyn_svcs_indexed;
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static atomic_t init;
 static atomic_t service_init;
 
@@ -1087,6 +1104,26 @@ static void gatt_insert(struct bt_gatt_service *svc, uint16_t last_handle)
 	}
 }
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+static void gatt_index_dyndb(void)
+{
+	struct bt_gatt_service *svc;
+
+	dyn_svcs_count = 0;
+	dyn_svcs_indexed = true;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+		if (dyn_svcs_count == ARRAY_SIZE(dyn_svcs)) {
+			BT_DBG("Too many dynamic services to index");
+			dyn_svcs_indexed = false;
+			return;
+		}
+
+		dyn_svcs[dyn_svcs_count++] = svc;
+	}
+}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
 static int gatt_register(struct bt_gatt_service *svc)
 {
 	struct bt_gatt_service *last;
@@ -1127,6 +1164,10 @@ populate:
 
 	gatt_insert(svc, last_handle);
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_index_dyndb();
+#endif
+
 	return 0;
 }
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
@@ -1288,8 +1329,23 @@ static void bt_gatt_service_init(void)
 	}
 
 	STRUCT_SECTION_FOREACH(bt_gatt_service_static, svc) {
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+		for (size_t i = 0; i < svc->attr_count; i++) {
+			if (last_static_handle + i < ARRAY_SIZE(static_attrs)) {
+				static_attrs[last_static_handle + i] = &svc->attrs[i];
+			}
+		}
+#endif
 		last_static_handle += svc->attr_count;
 	}
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	static_attrs_indexed = last_static_handle <= ARRAY_SIZE(static_attrs);
+	if (!static_attrs_indexed) {
+		BT_WARN("%u static attributes, only %zu can be indexed",
+			last_static_handle, ARRAY_SIZE(static_attrs));
+	}
+#endif
 }
 
 void bt_gatt_init(void)
@@ -1458,6 +1514,10 @@ static int gatt_unregister(struct bt_gatt_service *svc)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	gatt_index_dyndb();
+#endif
+
 	for (uint16_t i = 0; i < svc->attr_count; i++) {
 		struct bt_gatt_attr *attr = &svc->attrs[i];
 
@@ -1775,6 +1835,39 @@ static uint8_t gatt_foreach_iter(const struct bt_gatt_attr *attr,
 	return result;
 }
 
+#if defined(CONFIG_BT_GATT_DYNAMIC_DB)
+/* First dynamic service which may contain start_handle */
+static struct bt_gatt_service *dyndb_first(uint16_t start_handle)
+{
+	struct bt_gatt_service *svc;
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (dyn_svcs_indexed) {
+		size_t lo = 0, hi = dyn_svcs_count;
+
+		if (!dyn_svcs_count) {
+			return NULL;
+		}
+
+		/* Last service starting at or before start_handle, if any */
+		while (hi - lo > 1) {
+			size_t mid = lo + (hi - lo) / 2;
+
+			if (dyn_svcs[mid]->attrs[0].handle <= start_handle) {
+				lo = mid;
+			} else {
+				hi = mid;
+			}
+		}
+
+		return dyn_svcs[lo];
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
+	return SYS_SLIST_PEEK_HEAD_CONTAINER(&db, svc, node);
+}
+#endif /* CONFIG_BT_GATT_DYNAMIC_DB */
+
 static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 				    const struct bt_uuid *uuid,
 				    const void *attr_data, uint16_t num_matches,
@@ -1784,7 +1877,8 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 	size_t i;
 	struct bt_gatt_service *svc;
 
-	SYS_SLIST_FOR_EACH_CONTAINER(&db, svc, node) {
+	for (svc = dyndb_first(start_handle); svc;
+	     svc = SYS_SLIST_PEEK_NEXT_CONTAINER(svc, node)) {
 		struct bt_gatt_service *next;
 
 		next = SYS_SLIST_PEEK_NEXT_CONTAINER(svc, node);
@@ -1812,38 +1906,70 @@ static void foreach_attr_type_dyndb(uint16_t start_handle, uint16_t end_handle,
 #endif /* CONFIG_BT_GATT_DYNAMIC_DB */
 }
 
+static uint8_t foreach_attr_type_static(uint16_t start_handle,
+					uint16_t end_handle,
+					const struct bt_uuid *uuid,
+					const void *attr_data,
+					uint16_t *num_matches,
+					bt_gatt_attr_func_t func,
+					void *user_data)
+{
+	uint16_t handle = 1;
+	size_t i;
+
+#if defined(CONFIG_BT_GATT_ATTR_INDEX)
+	if (static_attrs_indexed) {
+		for (handle = MAX(start_handle, 1U);
+		     handle <= last_static_handle; handle++) {
+			if (gatt_foreach_iter(static_attrs[handle - 1], handle,
+					      start_handle, end_handle, uuid,
+					      attr_data, num_matches, func,
+					      user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return BT_GATT_ITER_STOP;
+			}
+		}
+
+		return BT_GATT_ITER_CONTINUE;
+	}
+#endif /* CONFIG_BT_GATT_ATTR_INDEX */
+
+	STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
+		/* Skip ahead if start is not within service handles */
+		if (handle + static_svc->attr_count < start_handle) {
+			handle += static_svc->attr_count;
+			continue;
+		}
+
+		for (i = 0; i < static_svc->attr_count; i++, handle++) {
+			if (gatt_foreach_iter(&static_svc->attrs[i],
+					      handle, start_handle,
+					      end_handle, uuid,
+					      attr_data, num_matches,
+					      func, user_data) ==
+			    BT_GATT_ITER_STOP) {
+				return BT_GATT_ITER_STOP;
+			}
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
 void bt_gatt_foreach_attr_type(uint16_t start_handle, uint16_t end_handle,
 			       const struct bt_uuid *uuid,
 			       const void *attr_data, uint16_t num_matches,
 			       bt_gatt_attr_func_t func, void *user_data)
 {
-	size_t i;
-
 	if (!num_matches) {
 		num_matches = UINT16_MAX;
 	}
 
-	if (start_handle <= last_static_handle) {
-		uint16_t handle = 1;
-
-		STRUCT_SECTION_FOREACH(bt_gatt_service_static, static_svc) {
-			/* Skip ahead if start is not within service handles */
-			if (handle + static_svc->attr_count < start_handle) {
-				handle += static_svc->attr_count;
-				continue;
-			}
-
-			for (i = 0; i < static_svc->attr_count; i++, handle++) {
-				if (gatt_foreach_iter(&static_svc->attrs[i],
-						      handle, start_handle,
-						      end_handle, uuid,
-						      attr_data, &num_matches,
-						      func, user_data) ==
-				    BT_GATT_ITER_STOP) {
-					return;
-				}
-			}
-		}
+	if ((start_handle <= last_static_handle) &&
+	    (foreach_attr_type_static(start_handle, end_handle, uuid,
+				      attr_data, &num_matches, func,
+				      user_data) == BT_GATT_ITER_STOP)) {
+		return;
 	}
 
 	/* Iterate over dynamic db */
@@ -2074,11 +2200,30 @@ struct notify_data {
 #if defined(CONFIG_BT_GATT_NOTIFY_MULTIPLE)
 
 static struct net_buf *nfy_mult[CONFIG_BT_MAX_CONN];
+/* Number of bt_gatt_notify_multiple() calls currently queueing values, the
+ * pending PDUs are flushed by the last one instead of by the work item.
+ */
+static atomic_t nfy_mult_hold;
 
 static int gatt_notify_mult_send(struct bt_conn *conn, struct net_buf **buf)
 {
+	struct bt_att_notify_mult *nfy;
 	int ret;
 
+	/* The Multiple Handle Value Notification shall contain at least two
+	 * handle value tuples, send a single value as a regular notification
+	 * by dropping the length field of the tuple.
+	 */
+	nfy = (void *)((*buf)->data + sizeof(struct bt_att_hdr));
+	if ((*buf)->len == sizeof(struct bt_att_hdr) + sizeof(*nfy) +
+			   sys_le16_to_cpu(nfy->len)) {
+		struct bt_att_hdr *hdr = (void *)(*buf)->data;
+
+		hdr->code = BT_ATT_OP_NOTIFY;
+		memmove(&nfy->len, nfy->value, sys_le16_to_cpu(nfy->len));
+		(*buf)->len -= sizeof(nfy->len);
+	}
+
 	ret = bt_att_send(conn, *buf);
 	if (ret < 0) {
 		net_buf_unref(*buf);
@@ -2106,7 +2251,7 @@ static void notify_mult_process(struct k_work *work)
 	}
 }
 
-K_WORK_DEFINE(nfy_mult_work, notify_mult_process);
+K_WORK_DELAYABLE_DEFINE(nfy_mult_work, notify_mult_process);
 
 static bool gatt_cf_notify_multi(struct bt_conn *conn)
 {
@@ -2127,9 +2272,11 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	struct bt_att_notify_mult *nfy;
 
 	/* Check if we can fit more data into it, in case it doesn't fit send
-	 * the existing buffer and proceed to create a new one
+	 * the existing buffer and proceed to create a new one. The buffer may
+	 * be larger than the ATT MTU so both limits are checked.
 	 */
 	if (*buf && ((net_buf_tailroom(*buf) < sizeof(*nfy) + params->len) ||
+	    ((*buf)->len + sizeof(*nfy) + params->len > bt_att_get_mtu(conn)) ||
 	    !bt_att_tx_meta_data_match(*buf, params->func, params->user_data))) {
 		int ret;
 
@@ -2158,7 +2305,13 @@ static int gatt_notify_mult(struct bt_conn *conn, uint16_t handle,
 	net_buf_add(*buf, params->len);
 	memcpy(nfy->value, params->data, params->len);
 
-	k_work_submit(&nfy_mult_work);
+	/* The first queued value sets the deadline, later ones only join the
+	 * pending PDU until it is sent.
+	 */
+	if (atomic_get(&nfy_mult_hold) == 0) {
+		k_work_schedule(&nfy_mult_work,
+				K_MSEC(CONFIG_BT_GATT_NOTIFY_MULTIPLE_FLUSH_MS));
+	}
 
 	return 0;
 }
@@ -2558,14 +2711,23 @@ int bt_gatt_notify_multiple(struct bt_conn *conn, uint16_t num_params,
 	__ASSERT(num_params, "invalid parameters\n");
 	__ASSERT(params->attr, "invalid parameters\n");
 
-	for (i = 0; i < num_params; i++) {
+	/* Queue all the values before sending so they are packed into as few
+	 * PDUs as the MTU allows.
+	 */
+	atomic_inc(&nfy_mult_hold);
+
+	for (i = 0, ret = 0; i < num_params; i++) {
 		ret = bt_gatt_notify_cb(conn, &params[i]);
 		if (ret < 0) {
-			return ret;
+			break;
 		}
 	}
 
-	return 0;
+	if (atomic_dec(&nfy_mult_hold) == 1) {
+		k_work_reschedule(&nfy_mult_work, K_NO_WAIT);
+	}
+
+	return ret < 0 ? ret : 0;
 }
 #endif /* CONFIG_BT_GATT_NOTIFY_MULTIPLE */
 
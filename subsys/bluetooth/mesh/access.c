@@ -50,6 +50,22 @@ static const struct bt_mesh_comp *dev_comp;
 static uint16_t dev_primary_addr;
 static void (*msg_cb)(uint32_t opcode, struct bt_mesh_msg_ctx *ctx, struct net_buf_simple *buf);
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+/* Opcode handlers of the composition, sorted by opcode and element. Only
+ * the handler that a walk of the composition would find first is kept for
+ * each element.
+ */
+struct op_entry {
+	uint32_t opcode;
+	struct bt_mesh_model *model;
+	const struct bt_mesh_model_op *op;
+};
+
+static struct op_entry op_table[CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE];
+static size_t op_table_len;
+static bool op_table_valid;
+#endif
+
 void bt_mesh_model_foreach(void (*func)(struct bt_mesh_model *mod,
 					struct bt_mesh_elem *elem,
 					bool vnd, bool primary,
@@ -367,6 +383,113 @@ static void mod_init(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
 	}
 }
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+static void op_table_add(struct bt_mesh_model *mod, struct bt_mesh_elem *elem,
+			 bool vnd, bool primary, void *user_data)
+{
+	bool *full = user_data;
+	const struct bt_mesh_model_op *op;
+
+	for (op = mod->op; op->func; op++) {
+		/* Only looked up in the model list matching the OpCode size */
+		if ((BT_MESH_MODEL_OP_LEN(op->opcode) == 3) != vnd) {
+			continue;
+		}
+
+		/* find_op() skips vendor models of another company */
+		if (vnd && IS_ENABLED(CONFIG_BT_MESH_MODEL_VND_MSG_CID_FORCE) &&
+		    (op->opcode & 0xffff) != mod->vnd.company) {
+			continue;
+		}
+
+		if (op_table_len == ARRAY_SIZE(op_table)) {
+			*full = true;
+			return;
+		}
+
+		op_table[op_table_len].opcode = op->opcode;
+		op_table[op_table_len].model = mod;
+		op_table[op_table_len].op = op;
+		op_table_len++;
+	}
+}
+
+static int op_entry_cmp(const void *a, const void *b)
+{
+	const struct op_entry *ea = a;
+	const struct op_entry *eb = b;
+
+	if (ea->opcode != eb->opcode) {
+		return (ea->opcode < eb->opcode) ? -1 : 1;
+	}
+
+	if (ea->model->elem_idx != eb->model->elem_idx) {
+		return ea->model->elem_idx - eb->model->elem_idx;
+	}
+
+	/* Both models are in the same model list of the element, keep the
+	 * composition order.
+	 */
+	if (ea->model != eb->model) {
+		return (ea->model < eb->model) ? -1 : 1;
+	}
+
+	return (ea->op < eb->op) ? -1 : (ea->op > eb->op);
+}
+
+static void op_table_build(void)
+{
+	bool full = false;
+	size_t i, n;
+
+	op_table_len = 0;
+	op_table_valid = false;
+
+	bt_mesh_model_foreach(op_table_add, &full);
+	if (full) {
+		BT_WARN("Opcode table too small, falling back to linear lookup");
+		op_table_len = 0;
+		return;
+	}
+
+	qsort(op_table, op_table_len, sizeof(op_table[0]), op_entry_cmp);
+
+	for (i = 0, n = 0; i < op_table_len; i++) {
+		if (n > 0 && op_table[n - 1].opcode == op_table[i].opcode &&
+		    op_table[n - 1].model->elem_idx ==
+		    op_table[i].model->elem_idx) {
+			continue;
+		}
+
+		op_table[n++] = op_table[i];
+	}
+
+	BT_DBG("%zu opcode handlers", n);
+
+	op_table_len = n;
+	op_table_valid = true;
+}
+
+/* Index of the first entry for the OpCode, or of the next larger one */
+static size_t op_table_find(uint32_t opcode)
+{
+	size_t lo = 0;
+	size_t hi = op_table_len;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (op_table[mid].opcode < opcode) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+#endif /* CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0 */
+
 int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 {
 	int err;
@@ -381,6 +504,12 @@ int bt_mesh_comp_register(const struct bt_mesh_comp *comp)
 	err = 0;
 	bt_mesh_model_foreach(mod_init, &err);
 
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+	if (!err) {
+		op_table_build();
+	}
+#endif
+
 	return err;
 }
 
@@ -679,6 +808,59 @@ static int get_opcode(struct net_buf_simple *buf, uint32_t *opcode)
 	CODE_UNREACHABLE;
 }
 
+static void model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf,
+		       struct bt_mesh_model *model,
+		       const struct bt_mesh_model_op *op)
+{
+	struct net_buf_simple_state state;
+
+	if (!bt_mesh_model_has_key(model, rx->ctx.app_idx)) {
+		return;
+	}
+
+	if (!model_has_dst(model, rx->ctx.recv_dst)) {
+		return;
+	}
+
+	if ((op->len >= 0) && (buf->len < (size_t)op->len)) {
+		BT_ERR("Too short message for OpCode 0x%08x", op->opcode);
+		return;
+	} else if ((op->len < 0) && (buf->len != (size_t)(-op->len))) {
+		BT_ERR("Invalid message size for OpCode 0x%08x", op->opcode);
+		return;
+	}
+
+	/* The callback will likely parse the buffer, so
+	 * store the parsing state in case multiple models
+	 * receive the message.
+	 */
+	net_buf_simple_save(buf, &state);
+	(void)op->func(model, &rx->ctx, buf);
+	net_buf_simple_restore(buf, &state);
+}
+
+/* Returns true if the message was dispatched through the opcode table */
+static bool op_table_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf,
+			  uint32_t opcode)
+{
+#if CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE > 0
+	size_t i;
+
+	if (!op_table_valid) {
+		return false;
+	}
+
+	for (i = op_table_find(opcode);
+	     i < op_table_len && op_table[i].opcode == opcode; i++) {
+		model_recv(rx, buf, op_table[i].model, op_table[i].op);
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
 void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 {
 	struct bt_mesh_model *model;
@@ -697,39 +879,17 @@ void bt_mesh_model_recv(struct bt_mesh_net_rx *rx, struct net_buf_simple *buf)
 
 	BT_DBG("OpCode 0x%08x", opcode);
 
-	for (i = 0; i < dev_comp->elem_count; i++) {
-		struct net_buf_simple_state state;
-
-		op = find_op(&dev_comp->elem[i], opcode, &model);
-		if (!op) {
-			BT_DBG("No OpCode 0x%08x for elem %d", opcode, i);
-			continue;
-		}
-
-		if (!bt_mesh_model_has_key(model, rx->ctx.app_idx)) {
-			continue;
-		}
-
-		if (!model_has_dst(model, rx->ctx.recv_dst)) {
-			continue;
-		}
+	if (!op_table_recv(rx, buf, opcode)) {
+		for (i = 0; i < dev_comp->elem_count; i++) {
+			op = find_op(&dev_comp->elem[i], opcode, &model);
+			if (!op) {
+				BT_DBG("No OpCode 0x%08x for elem %d", opcode,
+				       i);
+				continue;
+			}
 
-		if ((op->len >= 0) && (buf->len < (size_t)op->len)) {
-			BT_ERR("Too short message for OpCode 0x%08x", opcode);
-			continue;
-		} else if ((op->len < 0) && (buf->len != (size_t)(-op->len))) {
-			BT_ERR("Invalid message size for OpCode 0x%08x",
-			       opcode);
-			continue;
+			model_recv(rx, buf, model, op);
 		}
-
-		/* The callback will likely parse the buffer, so
-		 * store the parsing state in case multiple models
-		 * receive the message.
-		 */
-		net_buf_simple_save(buf, &state);
-		(void)op->func(model, &rx->ctx, buf);
-		net_buf_simple_restore(buf, &state);
 	}
 
 	if (IS_ENABLED(CONFIG_BT_MESH_ACCESS_LAYER_MSG) && msg_cb) {
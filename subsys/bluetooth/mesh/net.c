@@ -77,11 +77,21 @@ struct iv_val {
 	      iv_duration:7;
 } __packed;
 
-static struct {
-	uint32_t src : 15, /* MSb of source is always 0 */
-	      seq : 17;
-} msg_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static uint16_t msg_cache_next;
+/* FIFO of 32 bit keys with a hash index, used for the Network Message Cache
+ * and the duplicate cache. Each bucket chains its entries by index + 1, 0
+ * ends the chain. Zero keys mark empty entries and are not indexed.
+ */
+struct key_cache {
+	uint32_t key[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+	uint16_t chain[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+	uint16_t bucket[CONFIG_BT_MESH_MSG_CACHE_SIZE];
+	uint16_t next;
+};
+
+/* MSb of source is always 0 */
+#define MSG_CACHE_KEY(src, seq) (((uint32_t)(src) << 17) | ((seq) & BIT_MASK(17)))
+
+static struct key_cache msg_cache;
 
 /* Singleton network context (the implementation only supports one) */
 struct bt_mesh_net bt_mesh = {
@@ -108,49 +118,89 @@ K_MEM_SLAB_DEFINE(loopback_buf_pool,
 		  sizeof(struct loopback_buf),
 		  CONFIG_BT_MESH_LOOPBACK_BUFS, __alignof__(struct loopback_buf));
 
-static uint32_t dup_cache[CONFIG_BT_MESH_MSG_CACHE_SIZE];
-static int   dup_cache_next;
+static struct key_cache dup_cache;
 
-static bool check_dup(struct net_buf_simple *data)
+static uint16_t *key_cache_bucket(struct key_cache *cache, uint32_t key)
 {
-	const uint8_t *tail = net_buf_simple_tail(data);
-	uint32_t val;
-	int i;
+	return &cache->bucket[(key ^ (key >> 16)) % ARRAY_SIZE(cache->bucket)];
+}
 
-	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
+static bool key_cache_find(struct key_cache *cache, uint32_t key)
+{
+	uint16_t i;
 
-	for (i = 0; i < ARRAY_SIZE(dup_cache); i++) {
-		if (dup_cache[i] == val) {
+	for (i = *key_cache_bucket(cache, key); i; i = cache->chain[i - 1]) {
+		if (cache->key[i - 1] == key) {
 			return true;
 		}
 	}
 
-	dup_cache[dup_cache_next++] = val;
-	dup_cache_next %= ARRAY_SIZE(dup_cache);
-
 	return false;
 }
 
-static bool msg_cache_match(struct net_buf_simple *pdu)
+static void key_cache_remove(struct key_cache *cache, uint16_t idx)
 {
-	uint16_t i;
+	uint16_t *link;
 
-	for (i = 0U; i < ARRAY_SIZE(msg_cache); i++) {
-		if (msg_cache[i].src == SRC(pdu->data) &&
-		    msg_cache[i].seq == (SEQ(pdu->data) & BIT_MASK(17))) {
-			return true;
-		}
+	if (!cache->key[idx]) {
+		return;
+	}
+
+	link = key_cache_bucket(cache, cache->key[idx]);
+	while (*link != idx + 1) {
+		link = &cache->chain[*link - 1];
+	}
+
+	*link = cache->chain[idx];
+	cache->key[idx] = 0U;
+}
+
+/* Replaces the oldest entry, returns the index of the new one */
+static uint16_t key_cache_add(struct key_cache *cache, uint32_t key)
+{
+	uint16_t idx = cache->next;
+	uint16_t *head;
+
+	key_cache_remove(cache, idx);
+
+	if (key) {
+		head = key_cache_bucket(cache, key);
+		cache->key[idx] = key;
+		cache->chain[idx] = *head;
+		*head = idx + 1;
+	}
+
+	cache->next = (idx + 1) % ARRAY_SIZE(cache->key);
+
+	return idx;
+}
+
+static bool check_dup(struct net_buf_simple *data)
+{
+	const uint8_t *tail = net_buf_simple_tail(data);
+	uint32_t val;
+
+	val = sys_get_be32(tail - 4) ^ sys_get_be32(tail - 8);
+
+	if (key_cache_find(&dup_cache, val)) {
+		return true;
 	}
 
+	(void)key_cache_add(&dup_cache, val);
+
 	return false;
 }
 
+static bool msg_cache_match(struct net_buf_simple *pdu)
+{
+	return key_cache_find(&msg_cache,
+			      MSG_CACHE_KEY(SRC(pdu->data), SEQ(pdu->data)));
+}
+
 static void msg_cache_add(struct bt_mesh_net_rx *rx)
 {
-	rx->msg_cache_idx = msg_cache_next++;
-	msg_cache[rx->msg_cache_idx].src = rx->ctx.addr;
-	msg_cache[rx->msg_cache_idx].seq = rx->seq;
-	msg_cache_next %= ARRAY_SIZE(msg_cache);
+	rx->msg_cache_idx = key_cache_add(&msg_cache,
+					  MSG_CACHE_KEY(rx->ctx.addr, rx->seq));
 }
 
 static void store_iv(bool only_duration)
@@ -193,8 +243,7 @@ int bt_mesh_net_create(uint16_t idx, uint8_t flags, const uint8_t key[16],
 		return err;
 	}
 
-	(void)memset(msg_cache, 0, sizeof(msg_cache));
-	msg_cache_next = 0U;
+	(void)memset(&msg_cache, 0, sizeof(msg_cache));
 
 	bt_mesh.iv_index = iv_index;
 	atomic_set_bit_to(bt_mesh.flags, BT_MESH_IVU_IN_PROGRESS,
@@ -881,9 +930,9 @@ void bt_mesh_net_recv(struct net_buf_simple *data, int8_t rssi,
 	 */
 	if (bt_mesh_trans_recv(&buf, &rx) == -EAGAIN) {
 		BT_WARN("Removing rejected message from Network Message Cache");
-		msg_cache[rx.msg_cache_idx].src = BT_MESH_ADDR_UNASSIGNED;
+		key_cache_remove(&msg_cache, rx.msg_cache_idx);
 		/* Rewind the next index now that we're not using this entry */
-		msg_cache_next = rx.msg_cache_idx;
+		msg_cache.next = rx.msg_cache_idx;
 	}
 
 	/* Relay if this was a group/virtual address, or if the destination
@@ -38,11 +38,61 @@ struct rpl_val {
 static struct bt_mesh_rpl replay_list[CONFIG_BT_MESH_CRPL];
 static ATOMIC_DEFINE(store, CONFIG_BT_MESH_CRPL);
 
+/* Hash index of the used entries by source address. Each bucket chains its
+ * entries by index + 1, 0 ends the chain.
+ */
+static uint16_t rpl_bucket[CONFIG_BT_MESH_CRPL];
+static uint16_t rpl_chain[CONFIG_BT_MESH_CRPL];
+/* No entry below this index is free */
+static uint16_t rpl_free;
+
 static inline int rpl_idx(const struct bt_mesh_rpl *rpl)
 {
 	return rpl - &replay_list[0];
 }
 
+static void rpl_index_add(struct bt_mesh_rpl *rpl)
+{
+	uint16_t *head = &rpl_bucket[rpl->src % ARRAY_SIZE(rpl_bucket)];
+
+	rpl_chain[rpl_idx(rpl)] = *head;
+	*head = rpl_idx(rpl) + 1;
+
+	while (rpl_free < ARRAY_SIZE(replay_list) && replay_list[rpl_free].src) {
+		rpl_free++;
+	}
+}
+
+/* Entries are removed or moved only on IV Index update and reset, the
+ * index is then built again.
+ */
+static void rpl_index_rebuild(void)
+{
+	int i;
+
+	(void)memset(rpl_bucket, 0, sizeof(rpl_bucket));
+	rpl_free = 0U;
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
+		if (replay_list[i].src) {
+			rpl_index_add(&replay_list[i]);
+		}
+	}
+}
+
+static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
+{
+	uint16_t i;
+
+	for (i = rpl_bucket[src % ARRAY_SIZE(rpl_bucket)]; i; i = rpl_chain[i - 1]) {
+		if (replay_list[i - 1].src == src) {
+			return &replay_list[i - 1];
+		}
+	}
+
+	return NULL;
+}
+
 static void clear_rpl(struct bt_mesh_rpl *rpl)
 {
 	int err;
@@ -92,7 +142,18 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 		rpl->seg = 0;
 	}
 
-	rpl->src = rx->ctx.addr;
+	if (rpl->src != rx->ctx.addr) {
+		bool was_free = !rpl->src;
+
+		rpl->src = rx->ctx.addr;
+
+		if (was_free) {
+			rpl_index_add(rpl);
+		} else {
+			rpl_index_rebuild();
+		}
+	}
+
 	rpl->seq = rx->seq;
 	rpl->old_iv = rx->old_iv;
 
@@ -109,7 +170,7 @@ void bt_mesh_rpl_update(struct bt_mesh_rpl *rpl,
 bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		struct bt_mesh_rpl **match)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
 	/* Don't bother checking messages from ourselves */
 	if (rx->net_if == BT_MESH_NET_IF_LOCAL) {
@@ -121,11 +182,16 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 		return false;
 	}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		struct bt_mesh_rpl *rpl = &replay_list[i];
+	rpl = bt_mesh_rpl_find(rx->ctx.addr);
+
+	/* Existing slot for given address */
+	if (rpl) {
+		if (rx->old_iv && !rpl->old_iv) {
+			return true;
+		}
 
-		/* Empty slot */
-		if (!rpl->src) {
+		if ((!rx->old_iv && rpl->old_iv) ||
+		    rpl->seq < rx->seq) {
 			if (match) {
 				*match = rpl;
 			} else {
@@ -133,31 +199,25 @@ bool bt_mesh_rpl_check(struct bt_mesh_net_rx *rx,
 			}
 
 			return false;
+		} else {
+			return true;
 		}
+	}
 
-		/* Existing slot for given address */
-		if (rpl->src == rx->ctx.addr) {
-			if (rx->old_iv && !rpl->old_iv) {
-				return true;
-			}
-
-			if ((!rx->old_iv && rpl->old_iv) ||
-			    rpl->seq < rx->seq) {
-				if (match) {
-					*match = rpl;
-				} else {
-					bt_mesh_rpl_update(rpl, rx);
-				}
+	if (rpl_free == ARRAY_SIZE(replay_list)) {
+		BT_ERR("RPL is full!");
+		return true;
+	}
 
-				return false;
-			} else {
-				return true;
-			}
-		}
+	/* Empty slot */
+	rpl = &replay_list[rpl_free];
+	if (match) {
+		*match = rpl;
+	} else {
+		bt_mesh_rpl_update(rpl, rx);
 	}
 
-	BT_ERR("RPL is full!");
-	return true;
+	return false;
 }
 
 void bt_mesh_rpl_clear(void)
@@ -168,34 +228,23 @@ void bt_mesh_rpl_clear(void)
 		schedule_rpl_clear();
 	} else {
 		(void)memset(replay_list, 0, sizeof(replay_list));
+		rpl_index_rebuild();
 	}
 }
 
-static struct bt_mesh_rpl *bt_mesh_rpl_find(uint16_t src)
-{
-	int i;
-
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (replay_list[i].src == src) {
-			return &replay_list[i];
-		}
-	}
-
-	return NULL;
-}
-
 static struct bt_mesh_rpl *bt_mesh_rpl_alloc(uint16_t src)
 {
-	int i;
+	struct bt_mesh_rpl *rpl;
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (!replay_list[i].src) {
-			replay_list[i].src = src;
-			return &replay_list[i];
-		}
+	if (rpl_free == ARRAY_SIZE(replay_list)) {
+		return NULL;
 	}
 
-	return NULL;
+	rpl = &replay_list[rpl_free];
+	rpl->src = src;
+	rpl_index_add(rpl);
+
+	return rpl;
 }
 
 void bt_mesh_rpl_reset(void)
@@ -235,6 +284,8 @@ void bt_mesh_rpl_reset(void)
 	}
 
 	(void) memset(&replay_list[last - shift + 1], 0, sizeof(struct bt_mesh_rpl) * shift);
+
+	rpl_index_rebuild();
 }
 
 static int rpl_set(const char *name, size_t len_rd,
@@ -257,6 +308,7 @@ static int rpl_set(const char *name, size_t len_rd,
 		BT_DBG("val (null)");
 		if (entry) {
 			(void)memset(entry, 0, sizeof(*entry));
+			rpl_index_rebuild();
 		} else {
 			BT_WARN("Unable to find RPL entry for 0x%04x", src);
 		}
@@ -326,6 +378,7 @@ static void store_pending_rpl(struct bt_mesh_rpl *rpl)
 
 void bt_mesh_rpl_pending_store(uint16_t addr)
 {
+	struct bt_mesh_rpl *rpl;
 	int i;
 
 	if (!IS_ENABLED(CONFIG_BT_SETTINGS) ||
@@ -334,24 +387,33 @@ void bt_mesh_rpl_pending_store(uint16_t addr)
 		return;
 	}
 
-	if (addr == BT_MESH_ADDR_ALL_NODES) {
-		bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
-	}
+	if (addr != BT_MESH_ADDR_ALL_NODES) {
+		rpl = bt_mesh_rpl_find(addr);
+		if (!rpl) {
+			return;
+		}
 
-	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
-		if (addr != BT_MESH_ADDR_ALL_NODES &&
-		    addr != replay_list[i].src) {
-			continue;
+		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
+			store_pending_rpl(rpl);
+		} else {
+			clear_rpl(rpl);
+			rpl_index_rebuild();
 		}
 
+		return;
+	}
+
+	bt_mesh_settings_store_cancel(BT_MESH_SETTINGS_RPL_PENDING);
+
+	for (i = 0; i < ARRAY_SIZE(replay_list); i++) {
 		if (atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
 			store_pending_rpl(&replay_list[i]);
 		} else {
 			clear_rpl(&replay_list[i]);
 		}
+	}
 
-		if (addr != BT_MESH_ADDR_ALL_NODES) {
-			break;
-		}
+	if (!atomic_test_bit(bt_mesh.flags, BT_MESH_VALID)) {
+		rpl_index_rebuild();
 	}
 }
@@ -65,6 +65,36 @@ static struct bt_mesh_subnet subnets[CONFIG_BT_MESH_SUBNET_COUNT] = {
 	},
 };
 
+#define SUBNET_KEYS ARRAY_SIZE(subnets[0].keys)
+#define NID_BUCKETS MIN(128, SUBNET_KEYS * CONFIG_BT_MESH_SUBNET_COUNT)
+
+/* Valid subnet keys by NID of their network credentials, so that a network
+ * PDU is only tried with the credentials that may have encrypted it. Keys
+ * are numbered subnet index * SUBNET_KEYS + key index, plus one so that 0
+ * ends a chain.
+ */
+static uint16_t nid_bucket[NID_BUCKETS];
+static uint16_t nid_chain[SUBNET_KEYS * CONFIG_BT_MESH_SUBNET_COUNT];
+
+static void nid_index_update(void)
+{
+	(void)memset(nid_bucket, 0, sizeof(nid_bucket));
+
+	/* Chains are built backwards so that keys are tried in subnet order */
+	for (int i = ARRAY_SIZE(nid_chain) - 1; i >= 0; i--) {
+		struct bt_mesh_subnet *sub = &subnets[i / SUBNET_KEYS];
+		struct bt_mesh_subnet_keys *keys = &sub->keys[i % SUBNET_KEYS];
+		uint8_t bucket = keys->msg.nid % NID_BUCKETS;
+
+		if (sub->net_idx == BT_MESH_KEY_UNUSED || !keys->valid) {
+			continue;
+		}
+
+		nid_chain[i] = nid_bucket[bucket];
+		nid_bucket[bucket] = i + 1;
+	}
+}
+
 static void subnet_evt(struct bt_mesh_subnet *sub, enum bt_mesh_key_evt evt)
 {
 	STRUCT_SECTION_FOREACH(bt_mesh_subnet_cb, cb) {
@@ -219,6 +249,7 @@ static void key_refresh(struct bt_mesh_subnet *sub, uint8_t new_phase)
 		sub->kr_phase = BT_MESH_KR_NORMAL;
 		memcpy(&sub->keys[0], &sub->keys[1], sizeof(sub->keys[0]));
 		sub->keys[1].valid = 0U;
+		nid_index_update();
 		subnet_evt(sub, BT_MESH_KEY_REVOKED);
 		break;
 	}
@@ -275,6 +306,7 @@ static void subnet_del(struct bt_mesh_subnet *sub)
 	subnet_evt(sub, BT_MESH_KEY_DELETED);
 	(void)memset(sub, 0, sizeof(*sub));
 	sub->net_idx = BT_MESH_KEY_UNUSED;
+	nid_index_update();
 }
 
 static int msg_cred_create(struct bt_mesh_net_cred *cred, const uint8_t *p,
@@ -359,6 +391,7 @@ uint8_t bt_mesh_subnet_add(uint16_t net_idx, const uint8_t key[16])
 
 	sub->net_idx = net_idx;
 	sub->kr_phase = BT_MESH_KR_NORMAL;
+	nid_index_update();
 
 	if (IS_ENABLED(CONFIG_BT_MESH_GATT_PROXY)) {
 		sub->node_id = BT_MESH_NODE_IDENTITY_STOPPED;
@@ -420,6 +453,8 @@ uint8_t bt_mesh_subnet_update(uint16_t net_idx, const uint8_t key[16])
 		return STATUS_CANNOT_UPDATE;
 	}
 
+	nid_index_update();
+
 	key_refresh(sub, BT_MESH_KR_PHASE_1);
 
 	return STATUS_SUCCESS;
@@ -625,6 +660,7 @@ int bt_mesh_subnet_set(uint16_t net_idx, uint8_t kr_phase,
 
 	sub->net_idx = net_idx;
 	sub->kr_phase = kr_phase;
+	nid_index_update();
 
 	if (IS_ENABLED(CONFIG_BT_MESH_GATT_PROXY)) {
 		sub->node_id = BT_MESH_NODE_IDENTITY_STOPPED;
@@ -769,23 +805,17 @@ bool bt_mesh_net_cred_find(struct bt_mesh_net_rx *rx, struct net_buf_simple *in,
 	}
 #endif
 
-	for (i = 0; i < ARRAY_SIZE(subnets); i++) {
-		rx->sub = &subnets[i];
-		if (rx->sub->net_idx == BT_MESH_KEY_UNUSED) {
-			continue;
-		}
-
-		for (j = 0; j < ARRAY_SIZE(rx->sub->keys); j++) {
-			if (!rx->sub->keys[j].valid) {
-				continue;
-			}
-
-			if (cb(rx, in, out, &rx->sub->keys[j].msg)) {
-				rx->new_key = (j > 0);
-				rx->friend_cred = 0U;
-				rx->ctx.net_idx = rx->sub->net_idx;
-				return true;
-			}
+	/* The NID is the low bits of the first octet of the network PDU */
+	for (i = nid_bucket[(in->data[0] & 0x7f) % NID_BUCKETS]; i;
+	     i = nid_chain[i - 1]) {
+		rx->sub = &subnets[(i - 1) / SUBNET_KEYS];
+		j = (i - 1) % SUBNET_KEYS;
+
+		if (cb(rx, in, out, &rx->sub->keys[j].msg)) {
+			rx->new_key = (j > 0);
+			rx->friend_cred = 0U;
+			rx->ctx.net_idx = rx->sub->net_idx;
+			return true;
 		}
 	}
 
@@ -158,7 +158,9 @@ int bt_mesh_friend_cred_create(struct bt_mesh_net_cred *cred,
  *  @param in Input message buffer, passed to the callback.
  *  @param out Output message buffer, passed to the callback.
  *  @param cb Callback to call for each known network credential. Iteration
- *            stops when this callback returns @c true.
+ *            stops when this callback returns @c true. Subnet credentials
+ *            are only passed if their NID matches the one of the network
+ *            PDU in @p in.
  *
  *  @returns Whether any of the credentials got a @c true return from the
  *           callback.
@@ -79,9 +79,15 @@ int flash_img_init_id(struct flash_img_context *ctx, uint8_t area_id)
 
 	flash_dev = flash_area_get_device(ctx->flash_area);
 
+#ifdef CONFIG_IMG_BACKGROUND_WRITE
+	return stream_flash_init_background(&ctx->stream, flash_dev, ctx->buf,
+			sizeof(ctx->buf), ctx->flash_area->fa_off,
+			ctx->flash_area->fa_size, NULL);
+#else
 	return stream_flash_init(&ctx->stream, flash_dev, ctx->buf,
 			CONFIG_IMG_BLOCK_BUF_SIZE, ctx->flash_area->fa_off,
 			ctx->flash_area->fa_size, NULL);
+#endif
 }
 
 int flash_img_init(struct flash_img_context *ctx)
@@ -89,6 +95,24 @@ int flash_img_init(struct flash_img_context *ctx)
 	return flash_img_init_id(ctx, UPLOAD_FLASH_AREA_ID);
 }
 
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+int flash_img_pre_erase_start(struct flash_img_context *ctx)
+{
+	return stream_flash_pre_erase_start(&ctx->stream);
+}
+
+int flash_img_pre_erase_stop(struct flash_img_context *ctx)
+{
+	return stream_flash_pre_erase_stop(&ctx->stream);
+}
+
+int flash_img_pre_erase_stats_get(struct flash_img_context *ctx,
+				  struct stream_flash_pre_erase_stats *stats)
+{
+	return stream_flash_pre_erase_stats_get(&ctx->stream, stats);
+}
+#endif
+
 #if defined(CONFIG_IMG_ENABLE_IMAGE_CHECK)
 int flash_img_check(struct flash_img_context *ctx,
 		    const struct flash_img_check *fic,
@@ -13,6 +13,9 @@
 #include <errno.h>
 #include <zephyr/device.h>
 
+#include "disk_cache.h"
+#include "disk_rtio.h"
+
 #define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(disk);
@@ -87,7 +90,13 @@ int disk_access_read(const char *pdrv, uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->read != NULL)) {
-		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+			rc = disk_cache_read(disk, data_buf, start_sector,
+					     num_sector);
+		} else {
+			rc = disk->ops->read(disk, data_buf, start_sector,
+					     num_sector);
+		}
 	}
 
 	return rc;
@@ -101,7 +110,13 @@ int disk_access_write(const char *pdrv, const uint8_t *data_buf,
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->write != NULL)) {
-		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+			rc = disk_cache_write(disk, data_buf, start_sector,
+					      num_sector);
+		} else {
+			rc = disk->ops->write(disk, data_buf, start_sector,
+					      num_sector);
+		}
 	}
 
 	return rc;
@@ -114,6 +129,13 @@ int disk_access_ioctl(const char *pdrv, uint8_t cmd, void *buf)
 
 	if ((disk != NULL) && (disk->ops != NULL) &&
 				(disk->ops->ioctl != NULL)) {
+		if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE) &&
+		    (cmd == DISK_IOCTL_CTRL_SYNC)) {
+			rc = disk_cache_sync(disk);
+			if (rc != 0) {
+				return rc;
+			}
+		}
 		rc = disk->ops->ioctl(disk, cmd, buf);
 	}
 
@@ -137,6 +159,10 @@ int disk_access_register(struct disk_info *disk)
 		goto reg_err;
 	}
 
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_RTIO)) {
+		disk_rtio_register(disk);
+	}
+
 	/*  append to the disk list */
 	sys_dlist_append(&disk_access_list, &disk->node);
 	LOG_DBG("disk interface(%s) registered", disk->name);
@@ -161,6 +187,12 @@ int disk_access_unregister(struct disk_info *disk)
 		rc = -EINVAL;
 		goto unreg_err;
 	}
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE) &&
+	    (disk_cache_invalidate(disk) != 0)) {
+		LOG_WRN("disk interface(%s) cache write back failed",
+			disk->name);
+	}
+
 	/* remove disk node from the list */
 	sys_dlist_remove(&disk->node);
 	LOG_DBG("disk interface(%s) unregistered", disk->name);
@@ -175,6 +207,12 @@ static int disk_init(const struct device *dev)
 
 	k_mutex_init(&mutex);
 	sys_dlist_init(&disk_access_list);
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+		disk_cache_init();
+	}
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_RTIO)) {
+		disk_rtio_init();
+	}
 	return 0;
 }
 
@@ -0,0 +1,409 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/types.h>
+#include <zephyr/kernel.h>
+#include <zephyr/sys/dlist.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/storage/disk_access.h>
+#include <errno.h>
+
+#include "disk_cache.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+#define CACHE_SECTORS		CONFIG_DISK_ACCESS_CACHE_SECTORS
+#define CACHE_SECTOR_SIZE	CONFIG_DISK_ACCESS_CACHE_SECTOR_SIZE
+/* Requests longer than this bypass the cache, so they don't flush it */
+#define CACHE_MAX_RUN		(CACHE_SECTORS / 2)
+/* A burst must fit in the cache without evicting itself */
+#define CACHE_BURST		MIN(CONFIG_DISK_ACCESS_CACHE_BURST, CACHE_MAX_RUN)
+
+struct disk_cache_entry {
+	/* Position in the LRU list, most recently used first */
+	sys_dnode_t node;
+	/* Position in its hash bucket, linked while the entry caches a sector */
+	sys_dnode_t hash_node;
+	/* Disk the sector belongs to, NULL if the entry is free */
+	struct disk_info *disk;
+	uint32_t sector;
+	bool dirty;
+	uint8_t *data;
+};
+
+static struct disk_cache_entry cache_entries[CACHE_SECTORS];
+static uint8_t cache_data[CACHE_SECTORS][CACHE_SECTOR_SIZE] __aligned(4);
+/* Bounce buffer for read-ahead and coalesced writes */
+static uint8_t cache_burst_buf[CACHE_BURST * CACHE_SECTOR_SIZE] __aligned(4);
+static sys_dlist_t cache_lru;
+/* Entries caching a sector, hashed by disk and sector number */
+static sys_dlist_t cache_hash[CACHE_SECTORS];
+
+/* Protects all of the above, and serializes cached disk accesses */
+static K_MUTEX_DEFINE(cache_lock);
+
+/* Returns true if sectors of the disk fit in the cache */
+static bool cache_usable(struct disk_info *disk)
+{
+	uint32_t val;
+
+	if (disk->cache_sector_size == 0U) {
+		if ((disk->ops->ioctl == NULL) ||
+		    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+				      &val) != 0)) {
+			return false;
+		}
+
+		if (val > CACHE_SECTOR_SIZE) {
+			LOG_WRN("%s: sector size %u too large for cache",
+				disk->name, val);
+		}
+		disk->cache_sector_size = val;
+
+		if (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_COUNT,
+				     &val) == 0) {
+			disk->cache_sector_count = val;
+		}
+	}
+
+	return disk->cache_sector_size <= CACHE_SECTOR_SIZE;
+}
+
+/* Adjacent sectors of a disk land in different buckets */
+static sys_dlist_t *cache_bucket(struct disk_info *disk, uint32_t sector)
+{
+	return &cache_hash[(sector + ((uintptr_t)disk >> 3)) %
+			   ARRAY_SIZE(cache_hash)];
+}
+
+static struct disk_cache_entry *cache_find(struct disk_info *disk,
+					   uint32_t sector)
+{
+	struct disk_cache_entry *e;
+
+	SYS_DLIST_FOR_EACH_CONTAINER(cache_bucket(disk, sector), e, hash_node) {
+		if ((e->disk == disk) && (e->sector == sector)) {
+			return e;
+		}
+	}
+
+	return NULL;
+}
+
+static void cache_touch(struct disk_cache_entry *e)
+{
+	sys_dlist_remove(&e->node);
+	sys_dlist_prepend(&cache_lru, &e->node);
+}
+
+static void cache_drop(struct disk_cache_entry *e)
+{
+	if (e->disk != NULL) {
+		sys_dlist_remove(&e->hash_node);
+	}
+
+	e->disk = NULL;
+	e->dirty = false;
+	sys_dlist_remove(&e->node);
+	sys_dlist_append(&cache_lru, &e->node);
+}
+
+/*
+ * Write back a dirty entry together with the dirty entries caching the
+ * sectors following it, in a single multi-sector write.
+ */
+static int cache_flush_run(struct disk_cache_entry *e)
+{
+	struct disk_info *disk = e->disk;
+	uint32_t size = disk->cache_sector_size;
+	struct disk_cache_entry *run[CACHE_BURST];
+	size_t n = 0;
+	int rc;
+
+	do {
+		run[n++] = e;
+		e = (n < CACHE_BURST) ? cache_find(disk, e->sector + 1) : NULL;
+	} while ((e != NULL) && e->dirty);
+
+	if (n == 1) {
+		rc = disk->ops->write(disk, run[0]->data, run[0]->sector, 1);
+	} else {
+		for (size_t i = 0; i < n; i++) {
+			memcpy(&cache_burst_buf[i * size], run[i]->data, size);
+		}
+		rc = disk->ops->write(disk, cache_burst_buf, run[0]->sector, n);
+	}
+
+	if (rc != 0) {
+		LOG_ERR("%s: write back of sector %u failed (%d)", disk->name,
+			run[0]->sector, rc);
+		return rc;
+	}
+
+	for (size_t i = 0; i < n; i++) {
+		run[i]->dirty = false;
+	}
+
+	return 0;
+}
+
+/* Claim the least recently used entry for a sector, writing it back first */
+static struct disk_cache_entry *cache_alloc(struct disk_info *disk,
+					    uint32_t sector, int *err)
+{
+	struct disk_cache_entry *e;
+
+	e = CONTAINER_OF(sys_dlist_peek_tail(&cache_lru),
+			 struct disk_cache_entry, node);
+
+	if (e->disk != NULL) {
+		if (e->dirty) {
+			*err = cache_flush_run(e);
+			if (*err != 0) {
+				return NULL;
+			}
+		}
+
+		sys_dlist_remove(&e->hash_node);
+	}
+
+	e->disk = disk;
+	e->sector = sector;
+	e->dirty = false;
+	sys_dlist_append(cache_bucket(disk, sector), &e->hash_node);
+	cache_touch(e);
+
+	return e;
+}
+
+static void cache_read_ahead(struct disk_info *disk, uint32_t sector)
+{
+	struct disk_cache_entry *run[CACHE_BURST];
+	uint32_t size = disk->cache_sector_size;
+	size_t n = 0;
+	int rc = 0;
+
+	while ((n < CACHE_BURST) && (sector + n < disk->cache_sector_count) &&
+	       (cache_find(disk, sector + n) == NULL)) {
+		/* Entries are claimed before reading, as writing back their
+		 * previous content uses the bounce buffer.
+		 */
+		run[n] = cache_alloc(disk, sector + n, &rc);
+		if (run[n] == NULL) {
+			break;
+		}
+		n++;
+	}
+
+	if (n == 0) {
+		return;
+	}
+
+	rc = disk->ops->read(disk, cache_burst_buf, sector, n);
+
+	for (size_t i = 0; i < n; i++) {
+		if (rc == 0) {
+			memcpy(run[i]->data, &cache_burst_buf[i * size], size);
+		} else {
+			cache_drop(run[i]);
+		}
+	}
+}
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_entry *e;
+	uint32_t size;
+	uint32_t i = 0;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!cache_usable(disk)) {
+		rc = disk->ops->read(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	size = disk->cache_sector_size;
+
+	while (i < num_sector) {
+		uint32_t run = 1;
+
+		e = cache_find(disk, start_sector + i);
+		if (e != NULL) {
+			memcpy(&data_buf[i * size], e->data, size);
+			cache_touch(e);
+			i++;
+			continue;
+		}
+
+		/* Read all following missing sectors at once */
+		while ((i + run < num_sector) &&
+		       (cache_find(disk, start_sector + i + run) == NULL)) {
+			run++;
+		}
+
+		rc = disk->ops->read(disk, &data_buf[i * size],
+				     start_sector + i, run);
+		if (rc != 0) {
+			goto out;
+		}
+
+		/* Long runs are not kept, they would flush the whole cache */
+		for (uint32_t j = 0; (run <= CACHE_MAX_RUN) && (j < run); j++) {
+			e = cache_alloc(disk, start_sector + i + j, &rc);
+			if (e == NULL) {
+				goto out;
+			}
+			memcpy(e->data, &data_buf[(i + j) * size], size);
+		}
+
+		i += run;
+	}
+
+	if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE_READ_AHEAD) &&
+	    (start_sector == disk->cache_next_sector) &&
+	    (num_sector <= CACHE_MAX_RUN)) {
+		cache_read_ahead(disk, start_sector + num_sector);
+	}
+	disk->cache_next_sector = start_sector + num_sector;
+
+out:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector)
+{
+	struct disk_cache_entry *e;
+	uint32_t size;
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	if (!cache_usable(disk)) {
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		goto out;
+	}
+
+	size = disk->cache_sector_size;
+
+	if (num_sector > CACHE_MAX_RUN) {
+		/* Write large requests through, refreshing cached copies */
+		rc = disk->ops->write(disk, data_buf, start_sector, num_sector);
+		if (rc != 0) {
+			goto out;
+		}
+
+		for (size_t i = 0; i < ARRAY_SIZE(cache_entries); i++) {
+			e = &cache_entries[i];
+
+			if ((e->disk == disk) && (e->sector >= start_sector) &&
+			    (e->sector - start_sector < num_sector)) {
+				memcpy(e->data,
+				       &data_buf[(e->sector - start_sector) * size],
+				       size);
+				e->dirty = false;
+			}
+		}
+		goto out;
+	}
+
+	for (uint32_t i = 0; i < num_sector; i++) {
+		e = cache_find(disk, start_sector + i);
+		if (e == NULL) {
+			e = cache_alloc(disk, start_sector + i, &rc);
+			if (e == NULL) {
+				goto out;
+			}
+		} else {
+			cache_touch(e);
+		}
+
+		memcpy(e->data, &data_buf[i * size], size);
+		e->dirty = true;
+	}
+
+out:
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_sync(struct disk_info *disk)
+{
+	int rc = 0;
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	while (rc == 0) {
+		struct disk_cache_entry *first = NULL;
+
+		/* Flush from the lowest dirty sector, so each write covers
+		 * the longest run of adjacent dirty sectors.
+		 */
+		for (size_t i = 0; i < ARRAY_SIZE(cache_entries); i++) {
+			struct disk_cache_entry *e = &cache_entries[i];
+
+			if ((e->disk == disk) && e->dirty &&
+			    ((first == NULL) || (e->sector < first->sector))) {
+				first = e;
+			}
+		}
+
+		if (first == NULL) {
+			break;
+		}
+
+		rc = cache_flush_run(first);
+	}
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+int disk_cache_invalidate(struct disk_info *disk)
+{
+	int rc;
+
+	rc = disk_cache_sync(disk);
+
+	k_mutex_lock(&cache_lock, K_FOREVER);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_entries); i++) {
+		if (cache_entries[i].disk == disk) {
+			cache_drop(&cache_entries[i]);
+		}
+	}
+
+	disk->cache_sector_size = 0U;
+
+	k_mutex_unlock(&cache_lock);
+
+	return rc;
+}
+
+void disk_cache_init(void)
+{
+	sys_dlist_init(&cache_lru);
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_hash); i++) {
+		sys_dlist_init(&cache_hash[i]);
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(cache_entries); i++) {
+		cache_entries[i].data = cache_data[i];
+		sys_dnode_init(&cache_entries[i].hash_node);
+		sys_dlist_append(&cache_lru, &cache_entries[i].node);
+	}
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_
+
+#include <zephyr/drivers/disk.h>
+
+/*
+ * LRU sector cache sitting between disk_access_*() and the disk drivers.
+ * Writes are held back until DISK_IOCTL_CTRL_SYNC, eviction or unregistration
+ * of the disk, and written back as runs of adjacent sectors.
+ */
+
+void disk_cache_init(void);
+
+int disk_cache_read(struct disk_info *disk, uint8_t *data_buf,
+		    uint32_t start_sector, uint32_t num_sector);
+
+int disk_cache_write(struct disk_info *disk, const uint8_t *data_buf,
+		     uint32_t start_sector, uint32_t num_sector);
+
+/* Write back all dirty sectors of the disk */
+int disk_cache_sync(struct disk_info *disk);
+
+/* Write back, then forget, all sectors of the disk */
+int disk_cache_invalidate(struct disk_info *disk);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_CACHE_H_ */
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/types.h>
+#include <zephyr/kernel.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/storage/disk_access.h>
+#include <errno.h>
+
+#include "disk_cache.h"
+#include "disk_rtio.h"
+
+#define LOG_LEVEL CONFIG_DISK_LOG_LEVEL
+#include <zephyr/logging/log.h>
+LOG_MODULE_DECLARE(disk);
+
+static K_KERNEL_STACK_DEFINE(disk_rtio_stack, CONFIG_DISK_ACCESS_RTIO_STACK_SIZE);
+static struct k_work_q disk_rtio_workq;
+
+/* Returns 0 if the request can be performed on the disk */
+static int disk_rtio_check(struct disk_rtio_iodev *rio,
+			   const struct rtio_sqe *sqe)
+{
+	struct disk_info *disk = rio->disk;
+
+	if (sqe->op == RTIO_OP_NOP) {
+		return 0;
+	}
+
+	if (rio->sector_size == 0U) {
+		if ((disk->ops->ioctl == NULL) ||
+		    (disk->ops->ioctl(disk, DISK_IOCTL_GET_SECTOR_SIZE,
+				      &rio->sector_size) != 0)) {
+			rio->sector_size = 0U;
+			return -EIO;
+		}
+	}
+
+	if ((sqe->buf_len == 0U) || ((sqe->buf_len % rio->sector_size) != 0U)) {
+		return -EINVAL;
+	}
+
+	if (((sqe->op == RTIO_OP_RX) && (disk->ops->read == NULL)) ||
+	    ((sqe->op == RTIO_OP_TX) && (disk->ops->write == NULL))) {
+		return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+/*
+ * A request can be merged with the previous one if it continues it both on
+ * the disk and in memory, so both are done with a single driver call.
+ */
+static bool disk_rtio_mergeable(struct disk_rtio_iodev *rio,
+				const struct rtio_sqe *prev,
+				const struct rtio_sqe *next)
+{
+	return (next->op == prev->op) && (next->op != RTIO_OP_NOP) &&
+	       (next->offset == prev->offset + prev->buf_len / rio->sector_size) &&
+	       (next->buf == prev->buf + prev->buf_len) &&
+	       (disk_rtio_check(rio, next) == 0);
+}
+
+static int disk_rtio_xfer(struct disk_rtio_iodev *rio,
+			  const struct rtio_sqe *sqe, uint32_t len)
+{
+	struct disk_info *disk = rio->disk;
+	uint32_t count = len / rio->sector_size;
+
+	switch (sqe->op) {
+	case RTIO_OP_NOP:
+		return 0;
+	case RTIO_OP_RX:
+		if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+			return disk_cache_read(disk, sqe->buf, sqe->offset,
+					       count);
+		}
+		return disk->ops->read(disk, sqe->buf, sqe->offset, count);
+	case RTIO_OP_TX:
+		if (IS_ENABLED(CONFIG_DISK_ACCESS_CACHE)) {
+			return disk_cache_write(disk, sqe->buf, sqe->offset,
+						count);
+		}
+		return disk->ops->write(disk, sqe->buf, sqe->offset, count);
+	default:
+		return -ENOTSUP;
+	}
+}
+
+static void disk_rtio_work_handler(struct k_work *work)
+{
+	struct disk_rtio_iodev *rio =
+		CONTAINER_OF(work, struct disk_rtio_iodev, work);
+	struct rtio_iodev_sq *sq = rio->iodev.iodev_sq;
+	struct rtio_iodev_sqe batch[CONFIG_DISK_ACCESS_RTIO_MERGE_MAX];
+	struct rtio_iodev_sqe *item;
+
+	while ((item = rtio_spsc_consume(sq)) != NULL) {
+		const struct rtio_sqe *sqe = item->sqe;
+		uint32_t len = sqe->buf_len;
+		size_t n = 1;
+		int rc;
+
+		batch[0] = *item;
+
+		rc = disk_rtio_check(rio, sqe);
+		while ((rc == 0) && (n < ARRAY_SIZE(batch))) {
+			item = rtio_spsc_peek(sq);
+			if ((item == NULL) ||
+			    !disk_rtio_mergeable(rio, batch[n - 1].sqe,
+						 item->sqe)) {
+				break;
+			}
+
+			(void)rtio_spsc_consume(sq);
+			batch[n++] = *item;
+			len += item->sqe->buf_len;
+		}
+
+		if (rc == 0) {
+			rc = disk_rtio_xfer(rio, sqe, len);
+		}
+
+		/* Free the queue slots first, completing a request may submit
+		 * the next one to this device.
+		 */
+		for (size_t i = 0; i < n; i++) {
+			rtio_spsc_release(sq);
+		}
+
+		for (size_t i = 0; i < n; i++) {
+			if (rc == 0) {
+				rtio_sqe_ok(batch[i].r, batch[i].sqe, 0);
+			} else {
+				rtio_sqe_err(batch[i].r, batch[i].sqe, rc);
+			}
+		}
+	}
+}
+
+static void disk_rtio_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct disk_rtio_iodev *rio = (struct disk_rtio_iodev *)sqe->iodev;
+	struct rtio_iodev_sqe *item;
+	k_spinlock_key_t key;
+
+	/* Several RTIO contexts may submit to the same disk */
+	key = k_spin_lock(&rio->lock);
+	item = rtio_spsc_acquire(rio->iodev.iodev_sq);
+	if (item != NULL) {
+		item->sqe = sqe;
+		item->r = r;
+		rtio_spsc_produce(rio->iodev.iodev_sq);
+	}
+	k_spin_unlock(&rio->lock, key);
+
+	if (item == NULL) {
+		LOG_WRN("%s: request queue full", rio->disk->name);
+		rtio_sqe_err(r, sqe, -EWOULDBLOCK);
+		return;
+	}
+
+	k_work_submit_to_queue(&disk_rtio_workq, &rio->work);
+}
+
+static const struct rtio_iodev_api disk_rtio_api = {
+	.submit = disk_rtio_submit,
+};
+
+struct rtio_iodev *disk_access_rtio_iodev(const char *pdrv)
+{
+	struct disk_info *disk = disk_access_get_di(pdrv);
+
+	if ((disk == NULL) || (disk->rtio == NULL)) {
+		return NULL;
+	}
+
+	return &disk->rtio->iodev;
+}
+
+void disk_rtio_register(struct disk_info *disk)
+{
+	struct disk_rtio_iodev *rio = disk->rtio;
+
+	if (rio == NULL) {
+		return;
+	}
+
+	rio->iodev.api = &disk_rtio_api;
+	rio->disk = disk;
+	rio->sector_size = 0U;
+	k_work_init(&rio->work, disk_rtio_work_handler);
+}
+
+void disk_rtio_init(void)
+{
+	k_work_queue_start(&disk_rtio_workq, disk_rtio_stack,
+			   K_KERNEL_STACK_SIZEOF(disk_rtio_stack),
+			   CONFIG_DISK_ACCESS_RTIO_THREAD_PRIO, NULL);
+	k_thread_name_set(&disk_rtio_workq.thread, "disk_rtio");
+}
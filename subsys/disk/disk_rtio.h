@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_SUBSYS_DISK_DISK_RTIO_H_
+#define ZEPHYR_SUBSYS_DISK_DISK_RTIO_H_
+
+#include <zephyr/drivers/disk.h>
+
+/*
+ * Asynchronous disk access through RTIO. Requests queued on the RTIO device
+ * of a disk are performed from a dedicated work queue thread.
+ */
+
+void disk_rtio_init(void);
+
+/* Implemented by disk_access.c */
+struct disk_info *disk_access_get_di(const char *name);
+
+/* Bind the RTIO device of the disk, if the driver provides one */
+void disk_rtio_register(struct disk_info *disk);
+
+#endif /* ZEPHYR_SUBSYS_DISK_DISK_RTIO_H_ */
@@ -8,6 +8,8 @@
 #include <stddef.h>
 #include <string.h>
 
+#include <zephyr/sys/crc.h>
+
 #include <zephyr/fs/fcb.h>
 #include "fcb_priv.h"
 
@@ -56,10 +58,33 @@ fcb_append_to_scratch(struct fcb *fcb)
 	return 0;
 }
 
+/*
+ * Switch the active sector to a new one, with room for len bytes of entries.
+ */
+static int
+fcb_append_new_sector(struct fcb *fcb, int len)
+{
+	struct flash_sector *sector;
+	int rc;
+
+	sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
+	if (!sector || (sector->fs_size <
+		fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len)) {
+		return -ENOSPC;
+	}
+	rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+	if (rc) {
+		return rc;
+	}
+	fcb->f_active.fe_sector = sector;
+	fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
+	fcb->f_active_id++;
+	return 0;
+}
+
 int
 fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 {
-	struct flash_sector *sector;
 	struct fcb_entry *active;
 	int cnt;
 	int rc;
@@ -80,19 +105,10 @@ fcb_append(struct fcb *fcb, uint16_t len, struct fcb_entry *append_loc)
 	}
 	active = &fcb->f_active;
 	if (active->fe_elem_off + len + cnt > active->fe_sector->fs_size) {
-		sector = fcb_new_sector(fcb, fcb->f_scratch_cnt);
-		if (!sector || (sector->fs_size <
-			fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area)) + len + cnt)) {
-			rc = -ENOSPC;
-			goto err;
-		}
-		rc = fcb_sector_hdr_init(fcb, sector, fcb->f_active_id + 1);
+		rc = fcb_append_new_sector(fcb, len + cnt);
 		if (rc) {
 			goto err;
 		}
-		fcb->f_active.fe_sector = sector;
-		fcb->f_active.fe_elem_off = fcb_len_in_flash(fcb, sizeof(struct fcb_disk_area));
-		fcb->f_active_id++;
 	}
 
 	rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off, tmp_str, cnt);
@@ -135,3 +151,143 @@ fcb_append_finish(struct fcb *fcb, struct fcb_entry *loc)
 	}
 	return 0;
 }
+
+void
+fcb_batch_init(struct fcb_batch *batch, uint8_t *buf, size_t size)
+{
+	batch->fb_buf = buf;
+	batch->fb_size = size;
+	batch->fb_len = 0;
+	batch->fb_cnt = 0;
+}
+
+/*
+ * Size in flash of the entry packed at buf: length, data and crc8.
+ */
+static int
+fcb_batch_elem_len(struct fcb *fcb, uint8_t *buf)
+{
+	uint16_t len;
+	int cnt;
+
+	cnt = fcb_get_len(fcb, buf, &len);
+	if (cnt < 0) {
+		return cnt;
+	}
+	return fcb_len_in_flash(fcb, cnt) + fcb_len_in_flash(fcb, len) +
+	       fcb_len_in_flash(fcb, FCB_CRC_SZ);
+}
+
+int
+fcb_batch_add(struct fcb *fcb, struct fcb_batch *batch, const void *data,
+	      uint16_t len)
+{
+	uint8_t tmp_str[MAX(8, fcb->f_align)];
+	uint8_t *elem;
+	uint8_t crc8;
+	int cnt;
+	int data_off;
+	int crc_off;
+	int elem_len;
+
+	cnt = fcb_put_len(fcb, tmp_str, len);
+	if (cnt < 0) {
+		return cnt;
+	}
+	data_off = fcb_len_in_flash(fcb, cnt);
+	crc_off = data_off + fcb_len_in_flash(fcb, len);
+	elem_len = crc_off + fcb_len_in_flash(fcb, FCB_CRC_SZ);
+
+	if (batch->fb_len + elem_len > batch->fb_size) {
+		return -ENOMEM;
+	}
+
+	/*
+	 * Same layout as fcb_append() and fcb_append_finish() leave in
+	 * flash, padding included.
+	 */
+	elem = &batch->fb_buf[batch->fb_len];
+	(void)memset(elem, fcb->f_erase_value, crc_off);
+	(void)memset(&elem[crc_off], 0xFF, elem_len - crc_off);
+	memcpy(elem, tmp_str, cnt);
+	memcpy(&elem[data_off], data, len);
+
+	crc8 = CRC8_CCITT_INITIAL_VALUE;
+	crc8 = crc8_ccitt(crc8, tmp_str, cnt);
+	crc8 = crc8_ccitt(crc8, data, len);
+	elem[crc_off] = crc8;
+
+	batch->fb_len += elem_len;
+	batch->fb_cnt++;
+	return 0;
+}
+
+int
+fcb_batch_commit(struct fcb *fcb, struct fcb_batch *batch)
+{
+	struct fcb_entry *active;
+	size_t off;
+	size_t run;
+	uint16_t cnt;
+	uint16_t run_cnt;
+	int elem_len;
+	int rc;
+
+	rc = k_mutex_lock(&fcb->f_mtx, K_FOREVER);
+	if (rc) {
+		return -EINVAL;
+	}
+	active = &fcb->f_active;
+
+	off = 0;
+	cnt = 0;
+	elem_len = 0;
+	while (off < batch->fb_len) {
+		/*
+		 * Write as many whole entries as fit in the active sector
+		 * at once.
+		 */
+		run = 0;
+		run_cnt = 0;
+		while (off + run < batch->fb_len) {
+			elem_len = fcb_batch_elem_len(fcb, &batch->fb_buf[off + run]);
+			if (elem_len < 0) {
+				rc = elem_len;
+				goto out;
+			}
+			if (active->fe_elem_off + run + elem_len >
+			    active->fe_sector->fs_size) {
+				break;
+			}
+			run += elem_len;
+			run_cnt++;
+		}
+
+		if (!run) {
+			rc = fcb_append_new_sector(fcb, elem_len);
+			if (rc) {
+				goto out;
+			}
+			continue;
+		}
+
+		rc = fcb_flash_write(fcb, active->fe_sector, active->fe_elem_off,
+				     &batch->fb_buf[off], run);
+		if (rc) {
+			rc = -EIO;
+			goto out;
+		}
+		active->fe_elem_off += run;
+		off += run;
+		cnt += run_cnt;
+	}
+
+out:
+	k_mutex_unlock(&fcb->f_mtx);
+
+	/* Keep the entries which were not written */
+	memmove(batch->fb_buf, &batch->fb_buf[off], batch->fb_len - off);
+	batch->fb_len -= off;
+	batch->fb_cnt -= cnt;
+	return rc;
+}
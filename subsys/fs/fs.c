@@ -20,12 +20,94 @@
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(fs);
 
-/* list of mounted file systems */
+/* list of mounted file systems, longest mount point first */
 static sys_dlist_t fs_mnt_list;
 
 /* lock to protect mount list operations */
 static struct k_mutex mutex;
 
+#ifdef CONFIG_FS_STAT_CACHE
+/*
+ * Direct mapped cache of fs_stat() results, including nonexistent paths.
+ * Every operation that may change the result of a stat bumps the
+ * generation, which invalidates all entries at once.
+ */
+struct stat_cache_entry {
+	atomic_val_t gen;
+	uint32_t hash;
+	int rc;
+	struct fs_dirent entry;
+	char path[CONFIG_FS_STAT_CACHE_PATH_LEN];
+};
+
+static struct stat_cache_entry stat_cache[CONFIG_FS_STAT_CACHE_SIZE];
+/* Starts at 1, so zeroed entries are never valid */
+static atomic_t stat_cache_gen = ATOMIC_INIT(1);
+
+static inline void stat_cache_invalidate(void)
+{
+	atomic_inc(&stat_cache_gen);
+}
+
+static uint32_t stat_cache_hash(const char *path)
+{
+	uint32_t hash = 2166136261U;
+
+	while (*path != '\0') {
+		hash = (hash ^ (uint8_t)*path++) * 16777619U;
+	}
+
+	return hash;
+}
+
+static bool stat_cache_get(const char *path, uint32_t hash,
+			   struct fs_dirent *entry, int *rc)
+{
+	struct stat_cache_entry *ce =
+		&stat_cache[hash % CONFIG_FS_STAT_CACHE_SIZE];
+	bool hit;
+
+	k_mutex_lock(&mutex, K_FOREVER);
+	hit = (ce->gen == atomic_get(&stat_cache_gen)) && (ce->hash == hash) &&
+	      (strcmp(ce->path, path) == 0);
+	if (hit) {
+		*rc = ce->rc;
+		if (ce->rc == 0) {
+			*entry = ce->entry;
+		}
+	}
+	k_mutex_unlock(&mutex);
+
+	return hit;
+}
+
+/* gen is the generation read before the file system was asked */
+static void stat_cache_put(const char *path, uint32_t hash, atomic_val_t gen,
+			   const struct fs_dirent *entry, int rc)
+{
+	struct stat_cache_entry *ce =
+		&stat_cache[hash % CONFIG_FS_STAT_CACHE_SIZE];
+
+	if (strlen(path) >= sizeof(ce->path)) {
+		return;
+	}
+
+	k_mutex_lock(&mutex, K_FOREVER);
+	ce->gen = gen;
+	ce->hash = hash;
+	ce->rc = rc;
+	if (rc == 0) {
+		ce->entry = *entry;
+	}
+	strcpy(ce->path, path);
+	k_mutex_unlock(&mutex);
+}
+#else
+static inline void stat_cache_invalidate(void)
+{
+}
+#endif /* CONFIG_FS_STAT_CACHE */
+
 /* Maps an identifier used in mount points to the file system
  * implementation.
  */
@@ -82,7 +164,6 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			    const char *name, size_t *match_len)
 {
 	struct fs_mount_t *mnt_p = NULL, *itr;
-	size_t longest_match = 0;
 	size_t len, name_len = strlen(name);
 	sys_dnode_t *node;
 
@@ -92,11 +173,10 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 		len = itr->mountp_len;
 
 		/*
-		 * Move to next node if mount point length is
-		 * shorter than longest_match match or if path
-		 * name is shorter than the mount point name.
+		 * Move to next node if path name is shorter than the
+		 * mount point name.
 		 */
-		if ((len < longest_match) || (len > name_len)) {
+		if (len > name_len) {
 			continue;
 		}
 
@@ -108,10 +188,13 @@ static int fs_get_mnt_point(struct fs_mount_t **mnt_pntp,
 			continue;
 		}
 
-		/* Check for mount point match */
+		/*
+		 * The list is sorted by decreasing mount point length,
+		 * so the first match is the longest one.
+		 */
 		if (strncmp(name, itr->mnt_point, len) == 0) {
 			mnt_p = itr;
-			longest_match = len;
+			break;
 		}
 	}
 	k_mutex_unlock(&mutex);
@@ -161,6 +244,9 @@ int fs_open(struct fs_file_t *zfp, const char *file_name, fs_mode_t flags)
 
 	zfp->mp = mp;
 	rc = mp->fs->open(zfp, file_name, flags);
+	if ((flags & FS_O_CREATE) != 0) {
+		stat_cache_invalidate();
+	}
 	if (rc < 0) {
 		LOG_ERR("file open error (%d)", rc);
 		zfp->mp = NULL;
@@ -186,6 +272,9 @@ int fs_close(struct fs_file_t *zfp)
 	}
 
 	rc = zfp->mp->fs->close(zfp);
+	if ((zfp->flags & FS_O_WRITE) != 0) {
+		stat_cache_invalidate();
+	}
 	if (rc < 0) {
 		LOG_ERR("file close error (%d)", rc);
 		return rc;
@@ -229,6 +318,7 @@ ssize_t fs_write(struct fs_file_t *zfp, const void *ptr, size_t size)
 	}
 
 	rc = zfp->mp->fs->write(zfp, ptr, size);
+	stat_cache_invalidate();
 	if (rc < 0) {
 		LOG_ERR("file write error (%d)", rc);
 	}
@@ -289,6 +379,7 @@ int fs_truncate(struct fs_file_t *zfp, off_t length)
 	}
 
 	rc = zfp->mp->fs->truncate(zfp, length);
+	stat_cache_invalidate();
 	if (rc < 0) {
 		LOG_ERR("file truncate error (%d)", rc);
 	}
@@ -309,6 +400,7 @@ int fs_sync(struct fs_file_t *zfp)
 	}
 
 	rc = zfp->mp->fs->sync(zfp);
+	stat_cache_invalidate();
 	if (rc < 0) {
 		LOG_ERR("file sync error (%d)", rc);
 	}
@@ -499,6 +591,7 @@ int fs_mkdir(const char *abs_path)
 	}
 
 	rc = mp->fs->mkdir(mp, abs_path);
+	stat_cache_invalidate();
 	if (rc < 0) {
 		LOG_ERR("failed to create directory (%d)", rc);
 	}
@@ -532,6 +625,7 @@ int fs_unlink(const char *abs_path)
 	}
 
 	rc = mp->fs->unlink(mp, abs_path);
+	stat_cache_invalidate();
 	if (rc < 0) {
 		LOG_ERR("failed to unlink path (%d)", rc);
 	}
@@ -572,6 +666,7 @@ int fs_rename(const char *from, const char *to)
 	}
 
 	rc = mp->fs->rename(mp, from, to);
+	stat_cache_invalidate();
 	if (rc < 0) {
 		LOG_ERR("failed to rename file or dir (%d)", rc);
 	}
@@ -590,6 +685,15 @@ int fs_stat(const char *abs_path, struct fs_dirent *entry)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_FS_STAT_CACHE
+	uint32_t hash = stat_cache_hash(abs_path);
+	atomic_val_t gen = atomic_get(&stat_cache_gen);
+
+	if ((entry != NULL) && stat_cache_get(abs_path, hash, entry, &rc)) {
+		return rc;
+	}
+#endif
+
 	rc = fs_get_mnt_point(&mp, abs_path, NULL);
 	if (rc < 0) {
 		LOG_ERR("mount point not found!!");
@@ -606,6 +710,12 @@ int fs_stat(const char *abs_path, struct fs_dirent *entry)
 	} else if (rc < 0) {
 		LOG_ERR("failed get file or dir stat (%d)", rc);
 	}
+
+#ifdef CONFIG_FS_STAT_CACHE
+	if ((entry != NULL) && ((rc == 0) || (rc == -ENOENT))) {
+		stat_cache_put(abs_path, hash, gen, entry, rc);
+	}
+#endif
 	return rc;
 }
 
@@ -708,11 +818,25 @@ int fs_mount(struct fs_mount_t *mp)
 		goto mount_err;
 	}
 
-	/* Update mount point data and append it to the list */
+	/* Update mount point data and insert it in the list before the
+	 * first shorter mount point.
+	 */
 	mp->mountp_len = len;
 	mp->fs = fs;
 
-	sys_dlist_append(&fs_mnt_list, &mp->node);
+	SYS_DLIST_FOR_EACH_NODE(&fs_mnt_list, node) {
+		itr = CONTAINER_OF(node, struct fs_mount_t, node);
+		if (itr->mountp_len < len) {
+			break;
+		}
+	}
+
+	if (node != NULL) {
+		sys_dlist_insert(node, &mp->node);
+	} else {
+		sys_dlist_append(&fs_mnt_list, &mp->node);
+	}
+	stat_cache_invalidate();
 	LOG_DBG("fs mounted at %s", mp->mnt_point);
 
 mount_err:
@@ -753,6 +877,7 @@ int fs_unmount(struct fs_mount_t *mp)
 
 	/* remove mount node from the list */
 	sys_dlist_remove(&mp->node);
+	stat_cache_invalidate();
 	LOG_DBG("fs unmounted from %s", mp->mnt_point);
 
 unmount_err:
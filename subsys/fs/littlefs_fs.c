@@ -28,6 +28,12 @@ struct lfs_file_data {
 	struct lfs_file file;
 	struct lfs_file_config config;
 	void *cache_block;
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+	/* Serializes operations on the file, held while the volume lock is
+	 * dropped between chunks of a read or write.
+	 */
+	struct k_mutex mutex;
+#endif
 };
 
 #define LFS_FILEP(fp) (&((struct lfs_file_data *)(fp->filep))->file)
@@ -88,6 +94,25 @@ static inline void fs_unlock(struct fs_littlefs *fs)
 	k_mutex_unlock(&fs->mutex);
 }
 
+/* Must be taken before the volume lock */
+static inline void file_lock(struct fs_file_t *fp)
+{
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+	struct lfs_file_data *fdp = fp->filep;
+
+	k_mutex_lock(&fdp->mutex, K_FOREVER);
+#endif
+}
+
+static inline void file_unlock(struct fs_file_t *fp)
+{
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+	struct lfs_file_data *fdp = fp->filep;
+
+	k_mutex_unlock(&fdp->mutex);
+#endif
+}
+
 static int lfs_to_errno(int error)
 {
 	if (error >= 0) {
@@ -298,6 +323,10 @@ static int littlefs_open(struct fs_file_t *fp, const char *path,
 	fdp->config.buffer = fdp->cache_block;
 	path = fs_impl_strip_prefix(path, fp->mp);
 
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+	k_mutex_init(&fdp->mutex);
+#endif
+
 	fs_lock(fs);
 
 	ret = lfs_file_opencfg(&fs->lfs, &fdp->file,
@@ -316,11 +345,13 @@ static int littlefs_close(struct fs_file_t *fp)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+	file_lock(fp);
 	fs_lock(fs);
 
 	int ret = lfs_file_close(&fs->lfs, LFS_FILEP(fp));
 
 	fs_unlock(fs);
+	file_unlock(fp);
 
 	release_file_data(fp);
 
@@ -357,8 +388,57 @@ static int littlefs_rename(struct fs_mount_t *mountp, const char *from,
 	return lfs_to_errno(ret);
 }
 
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+/* Read or write in chunks, dropping the volume lock in between so that
+ * other files and directories can be accessed meanwhile. The file lock
+ * keeps the whole transfer atomic with respect to the file.
+ */
+static ssize_t littlefs_xfer(struct fs_file_t *fp, uint8_t *ptr, size_t len,
+			     bool write)
+{
+	struct fs_littlefs *fs = fp->mp->fs_data;
+	size_t done = 0;
+	ssize_t ret = 0;
+
+	file_lock(fp);
+
+	while (done < len) {
+		size_t chunk = MIN(len - done, CONFIG_FS_LITTLEFS_LOCK_CHUNK_SIZE);
+
+		fs_lock(fs);
+		if (write) {
+			ret = lfs_file_write(&fs->lfs, LFS_FILEP(fp),
+					     ptr + done, chunk);
+		} else {
+			ret = lfs_file_read(&fs->lfs, LFS_FILEP(fp),
+					    ptr + done, chunk);
+		}
+		fs_unlock(fs);
+
+		if (ret <= 0) {
+			break;
+		}
+
+		done += ret;
+
+		/* End of file reached */
+		if ((size_t)ret < chunk) {
+			break;
+		}
+	}
+
+	file_unlock(fp);
+
+	/* Report what was transferred before an error */
+	return (done > 0) ? done : ret;
+}
+#endif /* CONFIG_FS_LITTLEFS_FILE_LOCK */
+
 static ssize_t littlefs_read(struct fs_file_t *fp, void *ptr, size_t len)
 {
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+	ssize_t ret = littlefs_xfer(fp, ptr, len, false);
+#else
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
 	fs_lock(fs);
@@ -366,11 +446,15 @@ static ssize_t littlefs_read(struct fs_file_t *fp, void *ptr, size_t len)
 	ssize_t ret = lfs_file_read(&fs->lfs, LFS_FILEP(fp), ptr, len);
 
 	fs_unlock(fs);
+#endif
 	return lfs_to_errno(ret);
 }
 
 static ssize_t littlefs_write(struct fs_file_t *fp, const void *ptr, size_t len)
 {
+#ifdef CONFIG_FS_LITTLEFS_FILE_LOCK
+	ssize_t ret = littlefs_xfer(fp, (uint8_t *)ptr, len, true);
+#else
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
 	fs_lock(fs);
@@ -378,6 +462,7 @@ static ssize_t littlefs_write(struct fs_file_t *fp, const void *ptr, size_t len)
 	ssize_t ret = lfs_file_write(&fs->lfs, LFS_FILEP(fp), ptr, len);
 
 	fs_unlock(fs);
+#endif
 	return lfs_to_errno(ret);
 }
 
@@ -389,11 +474,13 @@ static int littlefs_seek(struct fs_file_t *fp, off_t off, int whence)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+	file_lock(fp);
 	fs_lock(fs);
 
 	off_t ret = lfs_file_seek(&fs->lfs, LFS_FILEP(fp), off, whence);
 
 	fs_unlock(fs);
+	file_unlock(fp);
 
 	if (ret >= 0) {
 		ret = 0;
@@ -406,11 +493,13 @@ static off_t littlefs_tell(struct fs_file_t *fp)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+	file_lock(fp);
 	fs_lock(fs);
 
 	off_t ret = lfs_file_tell(&fs->lfs, LFS_FILEP(fp));
 
 	fs_unlock(fs);
+	file_unlock(fp);
 	return ret;
 }
 
@@ -418,11 +507,13 @@ static int littlefs_truncate(struct fs_file_t *fp, off_t length)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+	file_lock(fp);
 	fs_lock(fs);
 
 	int ret = lfs_file_truncate(&fs->lfs, LFS_FILEP(fp), length);
 
 	fs_unlock(fs);
+	file_unlock(fp);
 	return lfs_to_errno(ret);
 }
 
@@ -430,11 +521,16 @@ static int littlefs_sync(struct fs_file_t *fp)
 {
 	struct fs_littlefs *fs = fp->mp->fs_data;
 
+	file_lock(fp);
+	/* littlefs is not reentrant: the volume stays locked for the whole
+	 * sync, including any metadata compaction.
+	 */
 	fs_lock(fs);
 
 	int ret = lfs_file_sync(&fs->lfs, LFS_FILEP(fp));
 
 	fs_unlock(fs);
+	file_unlock(fp);
 	return lfs_to_errno(ret);
 }
 
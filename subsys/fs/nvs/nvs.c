@@ -287,10 +287,10 @@ static int nvs_flash_block_move(struct nvs_fs *fs, uint32_t addr, size_t len)
 	return 0;
 }
 
-/* erase a sector and verify erase was OK.
+/* erase a sector and verify erase was OK, without updating the lookup cache.
  * return 0 if OK, errorcode on error.
  */
-static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
+static int nvs_flash_erase(struct nvs_fs *fs, uint32_t addr)
 {
 	int rc;
 	off_t offset;
@@ -303,9 +303,6 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	LOG_DBG("Erasing flash at %lx, len %d", (long int) offset,
 		fs->sector_size);
 
-#ifdef CONFIG_NVS_LOOKUP_CACHE
-	nvs_lookup_cache_invalidate(fs, addr >> ADDR_SECT_SHIFT);
-#endif
 	rc = flash_erase(fs->flash_device, offset, fs->sector_size);
 
 	if (rc) {
@@ -320,6 +317,17 @@ static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
 	return rc;
 }
 
+/* erase a sector and verify erase was OK.
+ * return 0 if OK, errorcode on error.
+ */
+static int nvs_flash_erase_sector(struct nvs_fs *fs, uint32_t addr)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, (addr & ADDR_SECT_MASK) >> ADDR_SECT_SHIFT);
+#endif
+	return nvs_flash_erase(fs, addr);
+}
+
 /* crc update on allocation entry */
 static void nvs_ate_crc8_update(struct nvs_ate *entry)
 {
@@ -576,6 +584,150 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 	return nvs_flash_ate_wrt(fs, &gc_done_ate);
 }
 
+/* nvs_erase_ate_valid validates a sector erase ate: a valid sector erase ate:
+ * - has a correct crc8
+ * - id = 0xFFFF and offset = NVS_ERASE_ATE_OFFSET
+ * - len is the number of an existing sector
+ * As its offset is out of the sector, it is not a valid ate and is skipped
+ * by everything else. Return 1 if valid, 0 otherwise
+ */
+static int nvs_erase_ate_valid(struct nvs_fs *fs, const struct nvs_ate *entry)
+{
+	if ((nvs_ate_crc8_check(entry)) || (entry->id != 0xFFFF) ||
+	    (entry->offset != NVS_ERASE_ATE_OFFSET) ||
+	    (entry->len >= fs->sector_count)) {
+		return 0;
+	}
+
+	return 1;
+}
+
+/* Erase the sectors named by the sector erase ates of the write sector which
+ * are not erased: the erase was interrupted, and what is left of their
+ * entries would be taken for valid entries.
+ */
+static int nvs_erase_ate_recover(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate erase_ate;
+	uint32_t addr, sec_addr;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	addr = fs->ate_wra + ate_size;
+	while ((addr & ADDR_OFFS_MASK) < (fs->sector_size - ate_size)) {
+		rc = nvs_flash_ate_rd(fs, addr, &erase_ate);
+		if (rc) {
+			return rc;
+		}
+
+		addr += ate_size;
+		if (!nvs_erase_ate_valid(fs, &erase_ate)) {
+			continue;
+		}
+
+		sec_addr = (uint32_t)erase_ate.len << ADDR_SECT_SHIFT;
+		rc = nvs_flash_cmp_const(fs, sec_addr,
+					 fs->flash_parameters->erase_value,
+					 fs->sector_size);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			LOG_INF("Redoing erase of sector %d", erase_ate.len);
+			rc = nvs_flash_erase_sector(fs, sec_addr);
+			if (rc) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* A valid entry of the sector being collected must be moved if it is the most
+ * recent entry for its id and it is not a delete entry. gc_prev_addr is the
+ * address of the entry. Returns 1 if it must be moved, 0 if not, negative
+ * errno code on error.
+ */
+static int nvs_gc_ate_needs_move(struct nvs_fs *fs, uint32_t gc_prev_addr,
+				 const struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr;
+
+	if (!nvs_ate_valid(fs, gc_ate)) {
+		return 0;
+	}
+
+	wlk_addr = fs->ate_wra;
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
+		 */
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
+
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	return (wlk_prev_addr == gc_prev_addr) && gc_ate->len;
+}
+
+/* move an entry of the sector being collected to the write sector */
+static int nvs_gc_ate_move(struct nvs_fs *fs, uint32_t gc_prev_addr,
+			   struct nvs_ate *gc_ate)
+{
+	int rc;
+	uint32_t data_addr;
+
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
+
+	data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Wait until nvs_gc_step() is done erasing a sector, if it is erasing one.
+ * The sector erase ate naming it is in the write sector, which must not be
+ * closed before the erase is done. Called with the lock held, the erase does
+ * not need it.
+ */
+static void nvs_gc_wait_erase(struct nvs_fs *fs)
+{
+	if (fs->gc_state != NVS_GC_ERASE) {
+		return;
+	}
+
+	(void)k_sem_take(&fs->gc_erase_sem, K_FOREVER);
+	k_sem_give(&fs->gc_erase_sem);
+	fs->gc_state = NVS_GC_IDLE;
+}
+#endif
+
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
  * sector.
@@ -583,9 +735,8 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 static int nvs_gc(struct nvs_fs *fs)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate, gc_ate;
+	uint32_t sec_addr, gc_addr, gc_prev_addr, stop_addr;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
@@ -625,47 +776,13 @@ static int nvs_gc(struct nvs_fs *fs)
 			return rc;
 		}
 
-		if (!nvs_ate_valid(fs, &gc_ate)) {
-			continue;
+		rc = nvs_gc_ate_needs_move(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
 		}
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
-
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
-		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
-
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
-
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
-
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
-
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
+		if (rc) {
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
 			if (rc) {
 				return rc;
 			}
@@ -687,6 +804,15 @@ gc_done:
 		}
 	}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* The sector may have been erased ahead by nvs_gc_step() */
+	rc = nvs_flash_cmp_const(fs, sec_addr, fs->flash_parameters->erase_value,
+				 fs->sector_size);
+	if (rc <= 0) {
+		return rc;
+	}
+#endif
+
 	/* Erase the gc'ed sector */
 	rc = nvs_flash_erase_sector(fs, sec_addr);
 	if (rc) {
@@ -804,6 +930,16 @@ static int nvs_startup(struct nvs_fs *fs)
 		fs->ate_wra -= ate_size;
 	}
 
+	/* Sectors erased ahead of time by nvs_gc_step() are named in the
+	 * write sector before the erase starts, redo the interrupted ones.
+	 * This is done whether or not CONFIG_NVS_GC_INCREMENTAL is enabled,
+	 * as the file system may have been written by a build that enabled it.
+	 */
+	rc = nvs_erase_ate_recover(fs);
+	if (rc) {
+		goto end;
+	}
+
 	/* if the sector after the write sector is not empty gc was interrupted
 	 * we might need to restart gc if it has not yet finished. Otherwise
 	 * just erase the sector.
@@ -936,6 +1072,10 @@ int nvs_mount(struct nvs_fs *fs)
 	size_t write_block_size;
 
 	k_mutex_init(&fs->nvs_lock);
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	k_sem_init(&fs->gc_erase_sem, 1, 1);
+	fs->gc_state = NVS_GC_IDLE;
+#endif
 
 	fs->flash_parameters = flash_get_parameters(fs->flash_device);
 	if (fs->flash_parameters == NULL) {
@@ -1087,6 +1227,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			break;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		nvs_gc_wait_erase(fs);
+#endif
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
@@ -1238,3 +1381,215 @@ ssize_t nvs_calc_free_space(struct nvs_fs *fs)
 	}
 	return free_space;
 }
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+/* Find the sector to collect ahead of time: the oldest closed sector, if
+ * fewer than CONFIG_NVS_GC_RESERVE_SECTORS sectors are empty on top of the
+ * one that always is. Returns 1 and starts moving its entries if a sector
+ * must be collected, 0 if not, errorcode on error.
+ */
+static int nvs_gc_start(struct nvs_fs *fs)
+{
+	int rc;
+	struct nvs_ate close_ate;
+	uint32_t sec_addr, close_addr;
+	size_t ate_size;
+	uint16_t empty_sectors = 0U;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	sec_addr = fs->ate_wra & ADDR_SECT_MASK;
+	while (true) {
+		nvs_sector_advance(fs, &sec_addr);
+		if (sec_addr == (fs->ate_wra & ADDR_SECT_MASK)) {
+			/* all other sectors are empty */
+			return 0;
+		}
+
+		close_addr = sec_addr + fs->sector_size - ate_size;
+		rc = nvs_flash_ate_rd(fs, close_addr, &close_ate);
+		if (rc) {
+			return rc;
+		}
+
+		if (nvs_ate_cmp_const(&close_ate,
+				      fs->flash_parameters->erase_value)) {
+			/* oldest closed sector */
+			break;
+		}
+
+		empty_sectors++;
+		if (empty_sectors > CONFIG_NVS_GC_RESERVE_SECTORS) {
+			return 0;
+		}
+	}
+
+	fs->gc_sector = sec_addr >> ADDR_SECT_SHIFT;
+	fs->gc_wra_sector = fs->ate_wra >> ADDR_SECT_SHIFT;
+	fs->gc_stop_addr = close_addr - ate_size;
+	fs->gc_addr = close_addr;
+
+	if (nvs_close_ate_valid(fs, &close_ate)) {
+		fs->gc_addr &= ADDR_SECT_MASK;
+		fs->gc_addr += close_ate.offset;
+	} else {
+		rc = nvs_recover_last_ate(fs, &fs->gc_addr);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	/* a sector closed without any entry */
+	if (fs->gc_addr > fs->gc_stop_addr) {
+		fs->gc_addr = fs->gc_stop_addr;
+	}
+
+	LOG_DBG("Incremental gc of sector %d", fs->gc_sector);
+	fs->gc_state = NVS_GC_MOVE;
+
+	return 1;
+}
+
+/* Move the valid entries of the sector being collected until the budget has
+ * elapsed. Returns 1 if more steps are needed, 0 if the write sector is full,
+ * errorcode on error.
+ */
+static int nvs_gc_move(struct nvs_fs *fs, uint32_t budget_us)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t gc_prev_addr, start;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+	start = k_cycle_get_32();
+
+	do {
+		gc_prev_addr = fs->gc_addr;
+		rc = nvs_flash_ate_rd(fs, gc_prev_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		rc = nvs_gc_ate_needs_move(fs, gc_prev_addr, &gc_ate);
+		if (rc < 0) {
+			return rc;
+		}
+
+		if (rc) {
+			/* Keep the same room as nvs_write() does, the
+			 * remaining entries are moved once the write sector
+			 * has been closed.
+			 */
+			if (fs->ate_wra < (fs->data_wra +
+					   nvs_al_size(fs, gc_ate.len) + ate_size)) {
+				fs->gc_state = NVS_GC_BLOCKED;
+				return 0;
+			}
+
+			rc = nvs_gc_ate_move(fs, gc_prev_addr, &gc_ate);
+			if (rc) {
+				return rc;
+			}
+		}
+
+		if (gc_prev_addr == fs->gc_stop_addr) {
+			fs->gc_state = NVS_GC_ERASE;
+			return 1;
+		}
+
+		/* Entries of the sector only, unlike nvs_prev_ate() */
+		fs->gc_addr += ate_size;
+	} while (k_cyc_to_us_floor32(k_cycle_get_32() - start) < budget_us);
+
+	return 1;
+}
+
+int nvs_gc_step(struct nvs_fs *fs, uint32_t budget_us)
+{
+	int rc;
+	struct nvs_ate erase_ate;
+	uint32_t sec_addr;
+	size_t ate_size;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+
+	/* Once the write sector has moved on, the sector may have been
+	 * collected by nvs_write(), start over.
+	 */
+	if ((fs->gc_state != NVS_GC_IDLE) &&
+	    ((fs->ate_wra >> ADDR_SECT_SHIFT) != fs->gc_wra_sector)) {
+		fs->gc_state = NVS_GC_IDLE;
+	}
+
+	switch (fs->gc_state) {
+	case NVS_GC_IDLE:
+		rc = nvs_gc_start(fs);
+		break;
+	case NVS_GC_MOVE:
+		rc = nvs_gc_move(fs, budget_us);
+		break;
+	case NVS_GC_BLOCKED:
+		rc = 0;
+		break;
+	case NVS_GC_ERASE:
+		/* Name the sector in the write sector first, so that
+		 * nvs_startup() redoes the erase if it is interrupted. Keep
+		 * the room for a delete entry, as nvs_write() does.
+		 */
+		if (fs->ate_wra < (fs->data_wra + ate_size)) {
+			fs->gc_state = NVS_GC_BLOCKED;
+			rc = 0;
+			break;
+		}
+
+		erase_ate.id = 0xffff;
+		erase_ate.len = fs->gc_sector;
+		erase_ate.offset = NVS_ERASE_ATE_OFFSET;
+		erase_ate.part = 0xff;
+		nvs_ate_crc8_update(&erase_ate);
+
+		rc = nvs_flash_ate_wrt(fs, &erase_ate);
+		if (rc) {
+			break;
+		}
+
+		/* The erase does not need the lock. A nvs_write() that closes
+		 * the write sector waits for the erase to finish.
+		 */
+		sec_addr = (uint32_t)fs->gc_sector << ADDR_SECT_SHIFT;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+		nvs_lookup_cache_invalidate(fs, fs->gc_sector);
+#endif
+		(void)k_sem_take(&fs->gc_erase_sem, K_NO_WAIT);
+		k_mutex_unlock(&fs->nvs_lock);
+
+		rc = nvs_flash_erase(fs, sec_addr);
+		k_sem_give(&fs->gc_erase_sem);
+
+		k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+		if (fs->gc_state == NVS_GC_ERASE) {
+			fs->gc_state = NVS_GC_IDLE;
+		}
+		rc = rc ? rc : 1;
+		break;
+	default:
+		rc = -EINVAL;
+		break;
+	}
+
+	if (rc < 0) {
+		fs->gc_state = NVS_GC_IDLE;
+	}
+
+	k_mutex_unlock(&fs->nvs_lock);
+	return rc;
+}
+#endif /* CONFIG_NVS_GC_INCREMENTAL */
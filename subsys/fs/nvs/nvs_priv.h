@@ -30,6 +30,19 @@ extern "C" {
 
 #define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
 
+/*
+ * Offset of a sector erase ate, out of any sector so it is not a valid ate
+ */
+#define NVS_ERASE_ATE_OFFSET 0xFFFF
+
+/*
+ * Incremental garbage collection states
+ */
+#define NVS_GC_IDLE 0	/* nothing in progress */
+#define NVS_GC_MOVE 1	/* moving the valid entries of gc_sector */
+#define NVS_GC_ERASE 2	/* erasing gc_sector */
+#define NVS_GC_BLOCKED 3	/* no room in the write sector, wait for the next one */
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/profiling/profiler.h>
+#include <zephyr/spinlock.h>
+#include <string.h>
+
+/* Open addressing is bounded so that a nearly full table never costs
+ * more than a few probes in the timer interrupt.
+ */
+#define PROFILER_MAX_PROBES 16
+
+struct profiler_bucket {
+	uintptr_t pcs[CONFIG_PROFILER_STACK_DEPTH];
+	uint32_t count;		/* 0 if the bucket is free */
+	uint8_t depth;
+};
+
+static struct profiler_bucket table[CONFIG_PROFILER_BUCKETS];
+static struct profiler_stats stats;
+static struct k_spinlock lock;
+static bool running;
+
+static uint32_t profiler_hash(const uintptr_t *pcs, size_t depth)
+{
+	uint32_t h = depth;
+
+	for (size_t i = 0; i < depth; i++) {
+		h = (h ^ (uint32_t)pcs[i]) * 0x9e3779b1U;
+	}
+
+	return h ^ (h >> 16);
+}
+
+static void profiler_record(const uintptr_t *pcs, size_t depth)
+{
+	uint32_t idx = profiler_hash(pcs, depth) % CONFIG_PROFILER_BUCKETS;
+
+	for (int probe = 0; probe < PROFILER_MAX_PROBES; probe++) {
+		struct profiler_bucket *b = &table[idx];
+
+		if (b->count == 0U) {
+			memcpy(b->pcs, pcs, depth * sizeof(pcs[0]));
+			b->depth = depth;
+			b->count = 1U;
+			stats.buckets++;
+			stats.samples++;
+			return;
+		}
+
+		if ((b->depth == depth) &&
+		    (memcmp(b->pcs, pcs, depth * sizeof(pcs[0])) == 0)) {
+			b->count++;
+			stats.samples++;
+			return;
+		}
+
+		idx = (idx + 1U) % CONFIG_PROFILER_BUCKETS;
+	}
+
+	stats.dropped++;
+}
+
+static void profiler_sample(struct k_timer *timer)
+{
+	uintptr_t pcs[CONFIG_PROFILER_STACK_DEPTH];
+	k_spinlock_key_t key;
+	size_t depth;
+
+	ARG_UNUSED(timer);
+
+	depth = arch_profiler_backtrace(pcs, ARRAY_SIZE(pcs));
+
+	key = k_spin_lock(&lock);
+
+	if (depth == 0) {
+		stats.missed++;
+	} else {
+		profiler_record(pcs, depth);
+	}
+
+	k_spin_unlock(&lock, key);
+}
+
+static K_TIMER_DEFINE(profiler_timer, profiler_sample, NULL);
+
+int profiler_start(uint32_t rate_hz)
+{
+	k_spinlock_key_t key;
+	k_timeout_t period;
+
+	if (rate_hz == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (running) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	running = true;
+	k_spin_unlock(&lock, key);
+
+	period = K_USEC(MAX(USEC_PER_SEC / rate_hz, 1U));
+	k_timer_start(&profiler_timer, period, period);
+
+	return 0;
+}
+
+int profiler_stop(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (!running) {
+		k_spin_unlock(&lock, key);
+		return -EALREADY;
+	}
+
+	running = false;
+	k_spin_unlock(&lock, key);
+
+	k_timer_stop(&profiler_timer);
+
+	return 0;
+}
+
+void profiler_reset(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	memset(table, 0, sizeof(table));
+	memset(&stats, 0, sizeof(stats));
+
+	k_spin_unlock(&lock, key);
+}
+
+void profiler_stats_get(struct profiler_stats *out)
+{
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*out = stats;
+
+	k_spin_unlock(&lock, key);
+}
+
+void profiler_foreach(profiler_sample_cb_t cb, void *user_data)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(table); i++) {
+		struct profiler_bucket b;
+		k_spinlock_key_t key;
+
+		/* Copy one bucket at a time so the callback runs unlocked */
+		key = k_spin_lock(&lock);
+		b = table[i];
+		k_spin_unlock(&lock, key);
+
+		if (b.count != 0U) {
+			cb(b.pcs, b.depth, b.count, user_data);
+		}
+	}
+}
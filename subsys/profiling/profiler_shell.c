@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/profiling/profiler.h>
+
+static int cmd_start(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t rate = CONFIG_PROFILER_DEFAULT_RATE;
+	int err;
+
+	if (argc > 1) {
+		rate = strtoul(argv[1], NULL, 0);
+	}
+
+	err = profiler_start(rate);
+	if (err) {
+		shell_error(shell, "Failed to start profiler (%d)", err);
+		return err;
+	}
+
+	shell_print(shell, "Sampling at %u Hz", rate);
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
+{
+	int err;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	err = profiler_stop();
+	if (err) {
+		shell_error(shell, "Failed to stop profiler (%d)", err);
+	}
+
+	return err;
+}
+
+static int cmd_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_reset();
+
+	return 0;
+}
+
+static int cmd_stats(const struct shell *shell, size_t argc, char **argv)
+{
+	struct profiler_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_stats_get(&stats);
+
+	shell_print(shell, "samples: %u", stats.samples);
+	shell_print(shell, "dropped: %u", stats.dropped);
+	shell_print(shell, "missed: %u", stats.missed);
+	shell_print(shell, "buckets: %u / %u", stats.buckets,
+		    CONFIG_PROFILER_BUCKETS);
+
+	return 0;
+}
+
+static void dump_sample(const uintptr_t *pcs, size_t depth, uint32_t count,
+			void *user_data)
+{
+	const struct shell *shell = user_data;
+
+	/* One "prof: <count> <pc>;<pc>;..." line per backtrace, innermost
+	 * first, as expected by scripts/profiling/profiler_collapse.py.
+	 */
+	shell_fprintf(shell, SHELL_NORMAL, "prof: %u ", count);
+
+	for (size_t i = 0; i < depth; i++) {
+		shell_fprintf(shell, SHELL_NORMAL, "%s0x%lx", i ? ";" : "",
+			      (unsigned long)pcs[i]);
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static int cmd_dump(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	profiler_foreach(dump_sample, (void *)shell);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "[rate_hz] Start sampling.", cmd_start,
+		      1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_stop),
+	SHELL_CMD(reset, NULL, "Discard collected samples.", cmd_reset),
+	SHELL_CMD(stats, NULL, "Show profiler statistics.", cmd_stats),
+	SHELL_CMD(dump, NULL, "Dump collected samples.", cmd_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands",
+		   NULL);
@@ -65,11 +65,32 @@ static uint16_t conex_task_id(struct rtio_concurrent_executor *exc,
 	return task_id;
 }
 
+/**
+ * complete every sqe of the transaction starting with sqe, returns the last one
+ */
+static const struct rtio_sqe *conex_txn_complete(struct rtio *r, const struct rtio_sqe *sqe,
+						 int result)
+{
+	const struct rtio_sqe *next;
+
+	rtio_cqe_submit_sqe(r, result, sqe);
+	if (sqe->flags & RTIO_SQE_PERIODIC) {
+		rtio_periodic_retire(sqe->userdata);
+	}
+
+	while ((next = rtio_txn_next(r, sqe)) != NULL) {
+		sqe = next;
+		rtio_cqe_submit_sqe(r, result, sqe);
+	}
+
+	return sqe;
+}
+
 static void conex_sweep_task(struct rtio *r, struct rtio_concurrent_executor *exc)
 {
 	struct rtio_sqe *sqe = rtio_spsc_consume(r->sq);
 
-	while (sqe != NULL && sqe->flags & RTIO_SQE_CHAINED) {
+	while (sqe != NULL && sqe->flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION)) {
 		rtio_spsc_release(r->sq);
 		sqe = rtio_spsc_consume(r->sq);
 	}
@@ -97,8 +118,8 @@ static void conex_resume(struct rtio *r, struct rtio_concurrent_executor *exc)
 	for (uint16_t task_id = exc->task_out; task_id < exc->task_in; task_id++) {
 		if (exc->task_status[task_id & exc->task_mask] & CONEX_TASK_SUSPENDED) {
 			LOG_INF("resuming suspended task %d", task_id);
-			exc->task_status[task_id] &= ~CONEX_TASK_SUSPENDED;
-			rtio_iodev_submit(exc->task_cur[task_id], r);
+			exc->task_status[task_id & exc->task_mask] &= ~CONEX_TASK_SUSPENDED;
+			rtio_iodev_submit(exc->task_cur[task_id & exc->task_mask], r);
 		}
 	}
 }
@@ -150,12 +171,12 @@ int rtio_concurrent_submit(struct rtio *r)
 		LOG_INF("setting up task %d", task_idx);
 
 		/* Setup task (yes this is it) */
-		exc->task_cur[task_idx] = sqe;
-		exc->task_status[task_idx] = CONEX_TASK_SUSPENDED;
+		exc->task_cur[task_idx & exc->task_mask] = sqe;
+		exc->task_status[task_idx & exc->task_mask] = CONEX_TASK_SUSPENDED;
 
 		LOG_INF("submitted sqe %p", sqe);
 		/* Go to the next sqe not in the current chain */
-		while (sqe != NULL && (sqe->flags & RTIO_SQE_CHAINED)) {
+		while (sqe != NULL && (sqe->flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION))) {
 			sqe = rtio_spsc_next(r->sq, sqe);
 		}
 
@@ -210,19 +231,27 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
 	uint16_t task_id = conex_task_id(exc, sqe);
 
+	if (sqe->flags & RTIO_SQE_MULTISHOT) {
+		/* The task goes on with the same request */
+		rtio_cqe_submit_sqe(r, result, sqe);
+		rtio_sqe_multishot_rearm(r, sqe);
+		k_spin_unlock(&exc->lock, key);
+		return;
+	}
+
+	sqe = conex_txn_complete(r, sqe, result);
+
 	if (sqe->flags & RTIO_SQE_CHAINED) {
 		next_sqe = rtio_spsc_next(r->sq, sqe);
 
 		rtio_iodev_submit(next_sqe, r);
 
-		exc->task_cur[task_id] = next_sqe;
+		exc->task_cur[task_id & exc->task_mask] = next_sqe;
 	} else {
-		exc->task_status[task_id]  |= CONEX_TASK_COMPLETE;
+		exc->task_status[task_id & exc->task_mask] |= CONEX_TASK_COMPLETE;
 	}
 
 
@@ -240,7 +269,7 @@ void rtio_concurrent_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
  */
 void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	struct rtio_sqe *nsqe;
+	const struct rtio_sqe *nsqe;
 	k_spinlock_key_t key;
 	struct rtio_concurrent_executor *exc = (struct rtio_concurrent_executor *)r->executor;
 
@@ -254,23 +283,23 @@ void rtio_concurrent_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	 */
 	key = k_spin_lock(&exc->lock);
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-
 	/* Determine the task id : O(n) */
 	uint16_t task_id = conex_task_id(exc, sqe);
 
+	sqe = conex_txn_complete(r, sqe, result);
 
-	/* Fail the remaining sqe's in the chain */
-	if (sqe->flags & RTIO_SQE_CHAINED) {
-		nsqe = rtio_spsc_next(r->sq, sqe);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
-			nsqe = rtio_spsc_next(r->sq, nsqe);
+	/* Fail the remaining sqe's in the chain, up to and including its tail */
+	nsqe = sqe;
+	while (nsqe->flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION)) {
+		nsqe = rtio_spsc_next(r->sq, nsqe);
+		if (nsqe == NULL) {
+			break;
 		}
+		rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
 	}
 
 	/* Task is complete (failed) */
-	exc->task_status[task_id] |= CONEX_TASK_COMPLETE;
+	exc->task_status[task_id & exc->task_mask] |= CONEX_TASK_COMPLETE;
 
 	conex_sweep_resume(r, exc);
 
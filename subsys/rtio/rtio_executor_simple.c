@@ -36,13 +36,45 @@ int rtio_simple_submit(struct rtio *r)
 	return 0;
 }
 
+/**
+ * @brief Complete every request of the transaction starting with sqe
+ *
+ * @return Flags of the last request of the transaction
+ */
+static uint16_t rtio_simple_txn_complete(struct rtio *r, const struct rtio_sqe *sqe,
+					 int result)
+{
+	uint16_t flags;
+
+	do {
+		flags = sqe->flags;
+		rtio_cqe_submit_sqe(r, result, sqe);
+		if (flags & RTIO_SQE_PERIODIC) {
+			rtio_periodic_retire(sqe->userdata);
+		}
+		rtio_spsc_release(r->sq);
+
+		if (flags & RTIO_SQE_TRANSACTION) {
+			sqe = rtio_spsc_consume(r->sq);
+		}
+	} while ((flags & RTIO_SQE_TRANSACTION) && sqe != NULL);
+
+	return flags;
+}
+
 /**
  * @brief Callback from an iodev describing success
  */
 void rtio_simple_ok(struct rtio *r, const struct rtio_sqe *sqe, int result)
 {
-	rtio_cqe_submit(r, result, sqe->userdata);
-	rtio_spsc_release(r->sq);
+	if (sqe->flags & RTIO_SQE_MULTISHOT) {
+		/* Stays the current request */
+		rtio_cqe_submit_sqe(r, result, sqe);
+		rtio_sqe_multishot_rearm(r, sqe);
+		return;
+	}
+
+	(void)rtio_simple_txn_complete(r, sqe, result);
 	rtio_simple_submit(r);
 }
 
@@ -54,25 +86,24 @@ void rtio_simple_err(struct rtio *r, const struct rtio_sqe *sqe, int result)
 	struct rtio_sqe *nsqe;
 	bool chained;
 
-	rtio_cqe_submit(r, result, sqe->userdata);
-	chained = sqe->flags & RTIO_SQE_CHAINED;
-	rtio_spsc_release(r->sq);
+	chained = rtio_simple_txn_complete(r, sqe, result) & RTIO_SQE_CHAINED;
 
+	/* Cancel the rest of the chain, up to and including its tail */
 	if (chained) {
+		uint16_t flags;
 
-		nsqe = rtio_spsc_consume(r->sq);
-		while (nsqe != NULL && nsqe->flags & RTIO_SQE_CHAINED) {
-			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
-			rtio_spsc_release(r->sq);
+		do {
 			nsqe = rtio_spsc_consume(r->sq);
-		}
+			if (nsqe == NULL) {
+				break;
+			}
 
-		if (nsqe != NULL) {
-			rtio_iodev_submit(nsqe, r);
-		}
-
-	} else {
-		/* Now we can submit the next in the queue if we aren't done */
-		rtio_simple_submit(r);
+			flags = nsqe->flags;
+			rtio_cqe_submit(r, -ECANCELED, nsqe->userdata);
+			rtio_spsc_release(r->sq);
+		} while (flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION));
 	}
+
+	/* Now we can submit the next in the queue if we aren't done */
+	rtio_simple_submit(r);
 }
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/kernel.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(rtio_periodic, CONFIG_RTIO_LOG_LEVEL);
+
+static void rtio_periodic_work(struct k_work *work)
+{
+	struct rtio_periodic *p = CONTAINER_OF(work, struct rtio_periodic, work);
+
+	/* The request may complete, and be retired, before this returns */
+	rtio_iodev_submit(p->sqe, p->r);
+}
+
+static void rtio_periodic_expiry(struct k_timer *timer)
+{
+	struct rtio_periodic *p = CONTAINER_OF(timer, struct rtio_periodic, timer);
+
+	if (!atomic_cas(&p->busy, 0, 1)) {
+		p->overruns++;
+		return;
+	}
+
+	/* The iodev may block, submit from a thread */
+	k_work_submit(&p->work);
+}
+
+int rtio_periodic_start(struct rtio_periodic *p, struct rtio *r,
+			struct rtio_sqe *sqe, k_timeout_t period)
+{
+	__ASSERT((sqe->flags & (RTIO_SQE_CHAINED | RTIO_SQE_TRANSACTION)) == 0,
+		 "periodic requests may not be chained");
+
+	p->r = r;
+	p->sqe = sqe;
+	p->userdata = sqe->userdata;
+	p->overruns = 0;
+	/* The first submission goes through the executor */
+	atomic_set(&p->busy, 1);
+	k_timer_init(&p->timer, rtio_periodic_expiry, NULL);
+	k_work_init(&p->work, rtio_periodic_work);
+
+	sqe->userdata = p;
+	sqe->flags |= RTIO_SQE_MULTISHOT | RTIO_SQE_PERIODIC;
+
+	k_timer_start(&p->timer, period, period);
+
+	return rtio_submit(r, 0);
+}
+
+void rtio_periodic_stop(struct rtio_periodic *p)
+{
+	struct rtio_sqe *sqe;
+	bool cancel;
+	k_spinlock_key_t key = k_spin_lock(&p->lock);
+
+	/* Retired after a failure, the slot may be in use by another request */
+	if (p->sqe == NULL) {
+		k_spin_unlock(&p->lock, key);
+		return;
+	}
+
+	k_timer_stop(&p->timer);
+	rtio_sqe_multishot_stop(p->sqe);
+
+	/* A request in progress is retired by the executor once it completes */
+	cancel = atomic_cas(&p->busy, 0, 1);
+	sqe = p->sqe;
+
+	k_spin_unlock(&p->lock, key);
+
+	if (cancel) {
+		rtio_sqe_err(p->r, sqe, -ECANCELED);
+	}
+}
+
+void rtio_periodic_retire(struct rtio_periodic *p)
+{
+	k_spinlock_key_t key = k_spin_lock(&p->lock);
+
+	k_timer_stop(&p->timer);
+	p->sqe = NULL;
+
+	k_spin_unlock(&p->lock, key);
+}
@@ -24,6 +24,130 @@ sys_slist_t settings_handlers;
 
 K_MUTEX_DEFINE(settings_lock);
 
+#if defined(CONFIG_SETTINGS_HANDLER_TABLE)
+/* Static handlers sorted by name */
+static const struct settings_handler_static
+	*settings_handler_table[CONFIG_SETTINGS_HANDLER_TABLE_SIZE];
+static size_t settings_handler_cnt;
+static bool settings_handler_table_valid;
+
+/* Compare a handler name with the first len characters of key, with the
+ * same ordering as strcmp() would give on the truncated key.
+ */
+static int settings_handler_cmp(const char *name, const char *key, size_t len)
+{
+	int rc = strncmp(name, key, len);
+
+	if ((rc == 0) && (name[len] != '\0')) {
+		rc = 1;
+	}
+
+	return rc;
+}
+
+/* Index of the first handler whose name is not below key[0..len) */
+static size_t settings_handler_lower_bound(const char *key, size_t len)
+{
+	size_t lo = 0;
+	size_t hi = settings_handler_cnt;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+
+		if (settings_handler_cmp(settings_handler_table[mid]->name,
+					 key, len) < 0) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static void settings_handler_table_add(const struct settings_handler_static *ch)
+{
+	size_t idx;
+
+	if (settings_handler_cnt == ARRAY_SIZE(settings_handler_table)) {
+		LOG_WRN("Handler table full, falling back to linear lookup");
+		settings_handler_table_valid = false;
+		return;
+	}
+
+	idx = settings_handler_lower_bound(ch->name, strlen(ch->name));
+	memmove(&settings_handler_table[idx + 1], &settings_handler_table[idx],
+		(settings_handler_cnt - idx) * sizeof(settings_handler_table[0]));
+	settings_handler_table[idx] = ch;
+	settings_handler_cnt++;
+}
+
+static void settings_handler_table_init(void)
+{
+	settings_handler_cnt = 0;
+	settings_handler_table_valid = true;
+
+	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+		settings_handler_table_add(ch);
+		if (!settings_handler_table_valid) {
+			break;
+		}
+	}
+}
+
+/* Look up every prefix of name which ends on a separator, from the shortest
+ * one, and keep the longest which names a handler. Handlers sharing a prefix
+ * are adjacent in the table, so the walk stops as soon as no handler name
+ * starts with the current prefix.
+ */
+static struct settings_handler_static *
+settings_handler_table_lookup(const char *name, const char **next)
+{
+	const struct settings_handler_static *bestmatch = NULL;
+	size_t bestlen = 0;
+	size_t len = 0;
+
+	while (true) {
+		char c = name[len];
+		const char *hname;
+		size_t idx;
+
+		if ((c != '\0') && (c != SETTINGS_NAME_END) &&
+		    (c != SETTINGS_NAME_SEPARATOR)) {
+			len++;
+			continue;
+		}
+
+		idx = settings_handler_lower_bound(name, len);
+		if (idx == settings_handler_cnt) {
+			break;
+		}
+
+		hname = settings_handler_table[idx]->name;
+		if (strncmp(hname, name, len) != 0) {
+			break;
+		}
+
+		if (hname[len] == '\0') {
+			bestmatch = settings_handler_table[idx];
+			bestlen = len;
+		}
+
+		if (c != SETTINGS_NAME_SEPARATOR) {
+			break;
+		}
+		len++;
+	}
+
+	if (next) {
+		*next = ((bestmatch != NULL) &&
+			 (name[bestlen] == SETTINGS_NAME_SEPARATOR)) ?
+			&name[bestlen + 1] : NULL;
+	}
+
+	return (struct settings_handler_static *)bestmatch;
+}
+#endif /* CONFIG_SETTINGS_HANDLER_TABLE */
 
 void settings_store_init(void);
 
@@ -32,6 +156,9 @@ void settings_init(void)
 #if defined(CONFIG_SETTINGS_DYNAMIC_HANDLERS)
 	sys_slist_init(&settings_handlers);
 #endif /* CONFIG_SETTINGS_DYNAMIC_HANDLERS */
+#if defined(CONFIG_SETTINGS_HANDLER_TABLE)
+	settings_handler_table_init();
+#endif /* CONFIG_SETTINGS_HANDLER_TABLE */
 	settings_store_init();
 }
 
@@ -139,27 +266,38 @@ struct settings_handler_static *settings_parse_and_lookup(const char *name,
 {
 	struct settings_handler_static *bestmatch;
 	const char *tmpnext;
+	bool scan_static = true;
 
 	bestmatch = NULL;
 	if (next) {
 		*next = NULL;
 	}
 
-	STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
-		if (!settings_name_steq(name, ch->name, &tmpnext)) {
-			continue;
-		}
-		if (!bestmatch) {
-			bestmatch = ch;
-			if (next) {
-				*next = tmpnext;
+#if defined(CONFIG_SETTINGS_HANDLER_TABLE)
+	if (settings_handler_table_valid) {
+		bestmatch = settings_handler_table_lookup(name, next);
+		scan_static = false;
+	}
+#endif /* CONFIG_SETTINGS_HANDLER_TABLE */
+
+	if (scan_static) {
+		STRUCT_SECTION_FOREACH(settings_handler_static, ch) {
+			if (!settings_name_steq(name, ch->name, &tmpnext)) {
+				continue;
 			}
-			continue;
-		}
-		if (settings_name_steq(ch->name, bestmatch->name, NULL)) {
-			bestmatch = ch;
-			if (next) {
-				*next = tmpnext;
+			if (!bestmatch) {
+				bestmatch = ch;
+				if (next) {
+					*next = tmpnext;
+				}
+				continue;
+			}
+			if (settings_name_steq(ch->name, bestmatch->name,
+					       NULL)) {
+				bestmatch = ch;
+				if (next) {
+					*next = tmpnext;
+				}
 			}
 		}
 	}
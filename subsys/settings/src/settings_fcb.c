@@ -119,6 +119,74 @@ static bool settings_fcb_check_duplicate(struct settings_fcb *cf,
 	return false;
 }
 
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+/* Protected by the settings lock, like every load */
+static struct settings_index_slot settings_fcb_index[CONFIG_SETTINGS_LOAD_INDEX_SIZE];
+static struct fcb_entry settings_fcb_index_loc[CONFIG_SETTINGS_LOAD_INDEX_SIZE];
+
+/**
+ * @brief Index the newest record of every setting
+ *
+ * Walks the FCB once and records, per name hash, the ordinal and location of
+ * the last record met. When a record hashes to a slot holding another name,
+ * the slot is marked as collided and its names fall back to the slow check.
+ *
+ * @param cf FCB handler
+ */
+static void settings_fcb_index_build(struct settings_fcb *cf)
+{
+	struct fcb_entry_ctx entry_ctx = {
+		{.fe_sector = NULL, .fe_elem_off = 0},
+		.fap = cf->cf_fcb.fap
+	};
+	uint32_t seq = 0;
+
+	memset(settings_fcb_index, 0, sizeof(settings_fcb_index));
+
+	while (fcb_getnext(&cf->cf_fcb, &entry_ctx.loc) == 0) {
+		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+		char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+		struct settings_index_slot *slot;
+		struct fcb_entry_ctx entry2_ctx;
+		size_t name_len;
+		size_t name2_len;
+		int idx;
+
+		seq++;
+
+		if (settings_line_name_read(name, sizeof(name), &name_len,
+					    &entry_ctx)) {
+			continue;
+		}
+		name[name_len] = '\0';
+
+		idx = settings_index_slot(settings_fcb_index,
+					  ARRAY_SIZE(settings_fcb_index),
+					  settings_index_hash(name), true);
+		if (idx < 0) {
+			/* Index is full, the name will be checked the slow way */
+			continue;
+		}
+		slot = &settings_fcb_index[idx];
+
+		if ((slot->seq != 0U) && !slot->collided) {
+			entry2_ctx.loc = settings_fcb_index_loc[idx];
+			entry2_ctx.fap = cf->cf_fcb.fap;
+
+			if (settings_line_name_read(name2, sizeof(name2),
+						    &name2_len, &entry2_ctx) ||
+			    (name_len != name2_len) ||
+			    memcmp(name, name2, name_len)) {
+				slot->collided = true;
+			}
+		}
+
+		slot->seq = seq;
+		settings_fcb_index_loc[idx] = entry_ctx.loc;
+	}
+}
+#endif
+
 static int read_entry_len(const struct fcb_entry_ctx *entry_ctx, off_t off)
 {
 	if (off >= entry_ctx->loc.fe_data_len) {
@@ -127,6 +195,25 @@ static int read_entry_len(const struct fcb_entry_ctx *entry_ctx, off_t off)
 	return entry_ctx->loc.fe_data_len - off;
 }
 
+static bool settings_fcb_is_duplicate(struct settings_fcb *cf,
+				      const struct fcb_entry_ctx *entry_ctx,
+				      const char * const name, uint32_t seq)
+{
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+	int rc;
+
+	rc = settings_index_check_duplicate(settings_fcb_index,
+					    ARRAY_SIZE(settings_fcb_index),
+					    name, seq);
+	if (rc >= 0) {
+		return rc == 1;
+	}
+#else
+	ARG_UNUSED(seq);
+#endif
+	return settings_fcb_check_duplicate(cf, entry_ctx, name);
+}
+
 static int settings_fcb_load_priv(struct settings_store *cs,
 				  line_load_cb cb,
 				  void *cb_arg,
@@ -137,14 +224,23 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 		{.fe_sector = NULL, .fe_elem_off = 0},
 		.fap = cf->cf_fcb.fap
 	};
+	uint32_t seq = 0;
 	int rc;
 
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+	if (filter_duplicates) {
+		settings_fcb_index_build(cf);
+	}
+#endif
+
 	while ((rc = fcb_getnext(&cf->cf_fcb, &entry_ctx.loc)) == 0) {
 		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 		size_t name_len;
 		int rc;
 		bool pass_entry = true;
 
+		seq++;
+
 		rc = settings_line_name_read(name, sizeof(name), &name_len,
 					     (void *)&entry_ctx);
 		if (rc) {
@@ -155,7 +251,7 @@ static int settings_fcb_load_priv(struct settings_store *cs,
 
 		if (filter_duplicates &&
 		    (!read_entry_len(&entry_ctx, name_len+1) ||
-		     settings_fcb_check_duplicate(cf, &entry_ctx, name))) {
+		     settings_fcb_is_duplicate(cf, &entry_ctx, name, seq))) {
 			pass_entry = false;
 		}
 		/*name, val-read_cb-ctx, val-off*/
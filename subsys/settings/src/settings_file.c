@@ -99,6 +99,91 @@ static bool settings_file_check_duplicate(
 	return false;
 }
 
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+/* Protected by the settings lock, like every load */
+static struct settings_index_slot settings_file_index[CONFIG_SETTINGS_LOAD_INDEX_SIZE];
+static struct line_entry_ctx settings_file_index_loc[CONFIG_SETTINGS_LOAD_INDEX_SIZE];
+
+/**
+ * @brief Index the newest record of every setting
+ *
+ * Walks the file once and records, per name hash, the ordinal and location of
+ * the last line met. When a line hashes to a slot holding another name, the
+ * slot is marked as collided and its names fall back to the slow check.
+ *
+ * @param file Settings file, opened for reading
+ */
+static void settings_file_index_build(struct fs_file_t *file)
+{
+	struct line_entry_ctx entry_ctx = {
+		.stor_ctx = (void *)file,
+		.seek = 0,
+		.len = 0 /* unknown length */
+	};
+	uint32_t seq = 0;
+
+	memset(settings_file_index, 0, sizeof(settings_file_index));
+
+	while (settings_next_line_ctx(&entry_ctx) == 0 && entry_ctx.len != 0) {
+		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+		char name2[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
+		struct settings_index_slot *slot;
+		struct line_entry_ctx entry2_ctx;
+		size_t name_len;
+		size_t name2_len;
+		int idx;
+
+		if (settings_line_name_read(name, sizeof(name), &name_len,
+					    &entry_ctx) || name_len == 0) {
+			break;
+		}
+		name[name_len] = '\0';
+		seq++;
+
+		idx = settings_index_slot(settings_file_index,
+					  ARRAY_SIZE(settings_file_index),
+					  settings_index_hash(name), true);
+		if (idx < 0) {
+			/* Index is full, the name will be checked the slow way */
+			continue;
+		}
+		slot = &settings_file_index[idx];
+
+		if ((slot->seq != 0U) && !slot->collided) {
+			entry2_ctx = settings_file_index_loc[idx];
+
+			if (settings_line_name_read(name2, sizeof(name2),
+						    &name2_len, &entry2_ctx) ||
+			    (name_len != name2_len) ||
+			    memcmp(name, name2, name_len)) {
+				slot->collided = true;
+			}
+		}
+
+		slot->seq = seq;
+		settings_file_index_loc[idx] = entry_ctx;
+	}
+}
+#endif
+
+static bool settings_file_is_duplicate(const struct line_entry_ctx *entry_ctx,
+				       const char * const name, uint32_t seq)
+{
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+	int rc;
+
+	rc = settings_index_check_duplicate(settings_file_index,
+					    ARRAY_SIZE(settings_file_index),
+					    name, seq);
+	if (rc >= 0) {
+		return rc == 1;
+	}
+#else
+	ARG_UNUSED(seq);
+#endif
+	return settings_file_check_duplicate(entry_ctx, name);
+}
+
 static int read_entry_len(const struct line_entry_ctx *entry_ctx, off_t off)
 {
 	if (off >= entry_ctx->len) {
@@ -130,6 +215,12 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+	if (filter_duplicates) {
+		settings_file_index_build(&file);
+	}
+#endif
+
 	while (1) {
 		char name[SETTINGS_MAX_NAME_LEN + SETTINGS_EXTRA_LEN + 1];
 		size_t name_len;
@@ -147,10 +238,11 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 			break;
 		}
 		name[name_len] = '\0';
+		lines++;
 
 		if (filter_duplicates &&
 		    (!read_entry_len(&entry_ctx, name_len+1) ||
-		     settings_file_check_duplicate(&entry_ctx, name))) {
+		     settings_file_is_duplicate(&entry_ctx, name, lines))) {
 			pass_entry = false;
 		}
 		/*name, val-read_cb-ctx, val-off*/
@@ -158,7 +250,6 @@ static int settings_file_load_priv(struct settings_store *cs, line_load_cb cb,
 		if (pass_entry) {
 			cb(name, (void *)&entry_ctx, name_len + 1, cb_arg);
 		}
-		lines++;
 	}
 
 	rc = fs_close(&file);
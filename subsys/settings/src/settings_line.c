@@ -425,3 +425,57 @@ int settings_line_load_cb(const char *name, void *val_read_cb_ctx, off_t off,
 	return settings_call_set_handler(name, len, settings_line_read_cb,
 					 &value_ctx, arg);
 }
+
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+uint32_t settings_index_hash(const char *name)
+{
+	/* 32-bit FNV-1a */
+	uint32_t hash = 2166136261U;
+
+	while (*name != '\0') {
+		hash ^= (uint8_t)*name++;
+		hash *= 16777619U;
+	}
+
+	return hash;
+}
+
+int settings_index_slot(struct settings_index_slot *slots, size_t size,
+			uint32_t hash, bool insert)
+{
+	size_t i = hash % size;
+
+	/* Linear probing, slots are never freed while an index is in use */
+	for (size_t n = 0; n < size; n++) {
+		if (slots[i].seq == 0U) {
+			if (!insert) {
+				return -ENOENT;
+			}
+			slots[i].hash = hash;
+			return i;
+		}
+
+		if (slots[i].hash == hash) {
+			return i;
+		}
+
+		i = (i + 1 == size) ? 0 : i + 1;
+	}
+
+	return insert ? -ENOSPC : -ENOENT;
+}
+
+int settings_index_check_duplicate(struct settings_index_slot *slots,
+				   size_t size, const char *name, uint32_t seq)
+{
+	int slot;
+
+	slot = settings_index_slot(slots, size, settings_index_hash(name),
+				   false);
+	if (slot < 0 || slots[slot].collided) {
+		return -ENOENT;
+	}
+
+	return (slots[slot].seq != seq) ? 1 : 0;
+}
+#endif
@@ -8,6 +8,7 @@
 #ifndef __SETTINGS_PRIV_H_
 #define __SETTINGS_PRIV_H_
 
+#include <stdbool.h>
 #include <sys/types.h>
 #include <zephyr/sys/slist.h>
 #include <errno.h>
@@ -120,6 +121,42 @@ void settings_line_io_init(int (*read_cb)(void *ctx, off_t off, char *buf,
 			  size_t (*get_len_cb)(void *ctx),
 			  uint8_t io_rwbs);
 
+#ifdef CONFIG_SETTINGS_LOAD_INDEX
+/*
+ * RAM index of the newest record of every name in a log-structured backend,
+ * built in one forward walk before the load walk. Records are identified by
+ * their 1-based ordinal in the walk. The backend keeps the storage location of
+ * each indexed record in an array parallel to the slots so that names which
+ * only share a hash can be told apart.
+ */
+struct settings_index_slot {
+	uint32_t hash;
+	uint32_t seq;      /* ordinal of the newest record, 0 if slot is free */
+	bool collided;     /* different names share this hash */
+};
+
+uint32_t settings_index_hash(const char *name);
+
+/**
+ * Find the slot of a hash, optionally claiming a free one.
+ *
+ * @retval slot number on success,
+ * -ENOENT if the hash is not indexed and @p insert is false,
+ * -ENOSPC if the index is full.
+ */
+int settings_index_slot(struct settings_index_slot *slots, size_t size,
+			uint32_t hash, bool insert);
+
+/**
+ * Check whether a newer record with the same name follows record @p seq.
+ *
+ * @retval 1 a newer record exists,
+ * 0 record @p seq is the newest one,
+ * -ENOENT the index can not tell, the slow duplicate check must be used.
+ */
+int settings_index_check_duplicate(struct settings_index_slot *slots,
+				   size_t size, const char *name, uint32_t seq);
+#endif
 
 extern sys_slist_t settings_load_srcs;
 extern sys_slist_t settings_handlers;
@@ -25,6 +25,8 @@ static int init(const struct shell_transport *transport,
 	}
 
 	sh_dummy->initialized = true;
+	sh_dummy->evt_handler = evt_handler;
+	sh_dummy->context = context;
 
 	return 0;
 }
@@ -80,12 +82,24 @@ static int read(const struct shell_transport *transport,
 		void *data, size_t length, size_t *cnt)
 {
 	struct shell_dummy *sh_dummy = (struct shell_dummy *)transport->ctx;
+	k_spinlock_key_t key;
 
 	if (!sh_dummy->initialized) {
 		return -ENODEV;
 	}
 
-	*cnt = 0;
+	key = k_spin_lock(&sh_dummy->lock);
+
+	*cnt = MIN(length, sh_dummy->in_len - sh_dummy->in_pos);
+	memcpy(data, sh_dummy->in_buf + sh_dummy->in_pos, *cnt);
+	sh_dummy->in_pos += *cnt;
+
+	if (sh_dummy->in_pos == sh_dummy->in_len) {
+		sh_dummy->in_pos = 0;
+		sh_dummy->in_len = 0;
+	}
+
+	k_spin_unlock(&sh_dummy->lock, key);
 
 	return 0;
 }
@@ -132,3 +146,25 @@ void shell_backend_dummy_clear_output(const struct shell *shell)
 	sh_dummy->buf[0] = '\0';
 	sh_dummy->len = 0;
 }
+
+size_t shell_backend_dummy_push_input(const struct shell *shell,
+				      const char *data, size_t len)
+{
+	struct shell_dummy *sh_dummy = (struct shell_dummy *)shell->iface->ctx;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&sh_dummy->lock);
+
+	len = MIN(len, sizeof(sh_dummy->in_buf) - sh_dummy->in_len);
+	memcpy(sh_dummy->in_buf + sh_dummy->in_len, data, len);
+	sh_dummy->in_len += len;
+
+	k_spin_unlock(&sh_dummy->lock, key);
+
+	if (sh_dummy->evt_handler != NULL) {
+		sh_dummy->evt_handler(SHELL_TRANSPORT_EVT_RX_RDY,
+				      sh_dummy->context);
+	}
+
+	return len;
+}
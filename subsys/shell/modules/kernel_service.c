@@ -15,6 +15,7 @@
 #include <zephyr/drivers/timer/system_timer.h>
 #include <zephyr/kernel.h>
 #include <kernel_internal.h>
+#include <zephyr/tracing/tracking.h>
 
 static int cmd_kernel_version(const struct shell *shell,
 			      size_t argc, char **argv)
@@ -218,6 +219,172 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_HISTOGRAMS) && defined(CONFIG_THREAD_MONITOR)
+static void shell_hist_print(const struct shell *shell, const char *name,
+			     const uint32_t *hist, uint32_t max)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "\t%s (max %u):", name, max);
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_HISTOGRAM_BUCKETS; i++) {
+		if (hist[i] != 0U) {
+			/* Bucket [i] holds samples below 2^i cycles */
+			shell_fprintf(shell, SHELL_NORMAL, " <2^%d:%u", i,
+				      hist[i]);
+		}
+	}
+
+	shell_fprintf(shell, SHELL_NORMAL, "\n");
+}
+
+static void shell_sched_hist_dump(const struct k_thread *cthread,
+				  void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *shell = (const struct shell *)user_data;
+	struct k_thread_sched_hist hist;
+	const char *tname;
+
+	if (k_thread_sched_hist_get(thread, &hist) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(shell, "%p %-10s", thread, tname ? tname : "NA");
+	shell_hist_print(shell, "wait cycles", hist.wait, hist.wait_max);
+	shell_hist_print(shell, "run cycles", hist.run, hist.run_max);
+}
+
+static int cmd_kernel_sched_hist(const struct shell *shell,
+				 size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_thread_foreach(shell_sched_hist_dump, (void *)shell);
+
+	return 0;
+}
+
+static void shell_sched_hist_reset(const struct k_thread *thread,
+				   void *user_data)
+{
+	ARG_UNUSED(user_data);
+
+	(void)k_thread_sched_hist_reset((k_tid_t)thread);
+}
+
+static int cmd_kernel_sched_hist_reset(const struct shell *shell,
+				       size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	k_thread_foreach(shell_sched_hist_reset, NULL);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_sched_hist,
+	SHELL_CMD(reset, NULL, "Clear all scheduling histograms.",
+		  cmd_kernel_sched_hist_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif
+
+#if defined(CONFIG_KERNEL_OBJ_STATS) && defined(CONFIG_TRACING_OBJECT_TRACKING)
+typedef void (*obj_stats_cb_t)(const struct shell *shell, const char *type,
+			       const void *obj, _wait_q_t *wait_q);
+
+static void obj_stats_foreach(const struct shell *shell, obj_stats_cb_t cb)
+{
+	for (struct k_sem *sem = _track_list_k_sem; sem != NULL;
+	     sem = SYS_PORT_TRACK_NEXT(sem)) {
+		cb(shell, "sem", sem, &sem->wait_q);
+	}
+
+	for (struct k_mutex *mutex = _track_list_k_mutex; mutex != NULL;
+	     mutex = SYS_PORT_TRACK_NEXT(mutex)) {
+		cb(shell, "mutex", mutex, &mutex->wait_q);
+	}
+
+	for (struct k_msgq *msgq = _track_list_k_msgq; msgq != NULL;
+	     msgq = SYS_PORT_TRACK_NEXT(msgq)) {
+		cb(shell, "msgq", msgq, &msgq->wait_q);
+	}
+
+	for (struct k_queue *queue = _track_list_k_queue; queue != NULL;
+	     queue = SYS_PORT_TRACK_NEXT(queue)) {
+		cb(shell, "queue", queue, &queue->wait_q);
+	}
+
+	for (struct k_pipe *pipe = _track_list_k_pipe; pipe != NULL;
+	     pipe = SYS_PORT_TRACK_NEXT(pipe)) {
+		cb(shell, "pipe rd", pipe, &pipe->wait_q.readers);
+		cb(shell, "pipe wr", pipe, &pipe->wait_q.writers);
+	}
+}
+
+static void shell_obj_stats_print(const struct shell *shell, const char *type,
+				  const void *obj, _wait_q_t *wait_q)
+{
+	struct k_obj_stats stats;
+
+	z_waitq_stats_get(wait_q, &stats);
+
+	/* Objects which were never used only add noise */
+	if ((stats.acquisitions == 0U) && (stats.contended == 0U)) {
+		return;
+	}
+
+	shell_print(shell, "%-7s %p %10u %10u %4u/%-4u %12llu %10u",
+		    type, obj, stats.acquisitions, stats.contended,
+		    stats.waiters, stats.max_waiters, stats.wait_total,
+		    stats.wait_max);
+}
+
+static int cmd_kernel_obj_stats(const struct shell *shell,
+				size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "%-7s %-10s %10s %10s %9s %12s %10s",
+		    "type", "object", "acquired", "contended", "waiters",
+		    "wait cyc", "max cyc");
+	obj_stats_foreach(shell, shell_obj_stats_print);
+
+	return 0;
+}
+
+static void shell_obj_stats_reset(const struct shell *shell, const char *type,
+				  const void *obj, _wait_q_t *wait_q)
+{
+	ARG_UNUSED(shell);
+	ARG_UNUSED(type);
+	ARG_UNUSED(obj);
+
+	z_waitq_stats_reset(wait_q);
+}
+
+static int cmd_kernel_obj_stats_reset(const struct shell *shell,
+				      size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	obj_stats_foreach(shell, shell_obj_stats_reset);
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_obj_stats,
+	SHELL_CMD(reset, NULL, "Clear all kernel object statistics.",
+		  cmd_kernel_obj_stats_reset),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -252,9 +419,19 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel_reboot,
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 	SHELL_CMD(cycles, NULL, "Kernel cycles.", cmd_kernel_cycles),
+#if defined(CONFIG_KERNEL_OBJ_STATS) && defined(CONFIG_TRACING_OBJECT_TRACKING)
+	SHELL_CMD_ARG(obj_stats, &sub_kernel_obj_stats,
+		      "Kernel objects contention statistics.",
+		      cmd_kernel_obj_stats, 1, 0),
+#endif
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
+#if defined(CONFIG_SCHED_THREAD_HISTOGRAMS) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD_ARG(sched_hist, &sub_kernel_sched_hist,
+		      "Threads scheduling latency and run length histograms.",
+		      cmd_kernel_sched_hist, 1, 0),
+#endif
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 		defined(CONFIG_THREAD_MONITOR)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
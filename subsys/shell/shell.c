@@ -104,7 +104,9 @@ static inline void state_set(const struct shell *shell, enum shell_state state)
 					SHELL_MSG_BACKEND_NOT_ACTIVE);
 			z_flag_print_noinit_set(shell, false);
 		}
-		z_shell_print_prompt_and_cmd(shell);
+		if (!z_flag_batch_get(shell)) {
+			z_shell_print_prompt_and_cmd(shell);
+		}
 	}
 }
 
@@ -320,6 +322,14 @@ static inline bool is_completion_candidate(const char *candidate,
 	return (strncmp(candidate, str, len) == 0) ? true : false;
 }
 
+/* Commands disabled at build time are kept with an empty syntax, they are
+ * never completion candidates.
+ */
+static inline bool is_disabled_cmd(const struct shell_static_entry *entry)
+{
+	return entry->syntax[0] == '\0';
+}
+
 static void find_completion_candidates(const struct shell *shell,
 				       const struct shell_static_entry *cmd,
 				       const char *incompl_cmd,
@@ -329,15 +339,48 @@ static void find_completion_candidates(const struct shell *shell,
 	const struct shell_static_entry *candidate;
 	struct shell_static_entry dloc;
 	size_t incompl_cmd_len;
+	size_t sorted_cnt;
 	size_t idx = 0;
 
 	incompl_cmd_len = z_shell_strlen(incompl_cmd);
 	*longest = 0U;
 	*cnt = 0;
 
+	if (z_shell_cmd_sorted_count(cmd, &sorted_cnt)) {
+		/* All candidates are adjacent, starting from the first
+		 * command not lower than the prefix.
+		 */
+		idx = z_shell_cmd_lower_bound(cmd, sorted_cnt, incompl_cmd,
+					      incompl_cmd_len);
+
+		while (idx < sorted_cnt) {
+			candidate = z_shell_cmd_get(cmd, idx, &dloc);
+			if (is_disabled_cmd(candidate)) {
+				idx++;
+				continue;
+			}
+
+			if (!is_completion_candidate(candidate->syntax,
+						     incompl_cmd,
+						     incompl_cmd_len)) {
+				break;
+			}
+
+			*longest = Z_MAX(strlen(candidate->syntax), *longest);
+			if (*cnt == 0) {
+				*first_idx = idx;
+			}
+			(*cnt)++;
+			idx++;
+		}
+
+		return;
+	}
+
 	while ((candidate = z_shell_cmd_get(cmd, idx, &dloc)) != NULL) {
 		bool is_candidate;
-		is_candidate = is_completion_candidate(candidate->syntax,
+		is_candidate = !is_disabled_cmd(candidate) &&
+			       is_completion_candidate(candidate->syntax,
 						incompl_cmd, incompl_cmd_len);
 		if (is_candidate) {
 			*longest = Z_MAX(strlen(candidate->syntax), *longest);
@@ -439,6 +482,10 @@ static void tab_options_print(const struct shell *shell,
 		match = z_shell_cmd_get(cmd, idx, &shell->ctx->active_cmd);
 		__ASSERT_NO_MSG(match != NULL);
 		idx++;
+		if (is_disabled_cmd(match)) {
+			continue;
+		}
+
 		if (str && match->syntax &&
 		    !is_completion_candidate(match->syntax, str, str_len)) {
 			continue;
@@ -481,6 +528,10 @@ static uint16_t common_beginning_find(const struct shell *shell,
 			break;
 		}
 
+		if (is_disabled_cmd(match2)) {
+			continue;
+		}
+
 		curr_common = str_common(shell->ctx->temp_buff, match2->syntax,
 					 UINT16_MAX);
 		if ((arg_len == 0U) || (curr_common >= arg_len)) {
@@ -634,14 +685,16 @@ static int execute(const struct shell *shell)
 	char *cmd_buf = shell->ctx->cmd_buff;
 	bool has_last_handler = false;
 
-	z_shell_op_cursor_end_move(shell);
-	if (!z_shell_cursor_in_empty_line(shell)) {
-		z_cursor_next_line_move(shell);
+	if (!z_flag_batch_get(shell)) {
+		z_shell_op_cursor_end_move(shell);
+		if (!z_shell_cursor_in_empty_line(shell)) {
+			z_cursor_next_line_move(shell);
+		}
 	}
 
 	memset(&shell->ctx->active_cmd, 0, sizeof(shell->ctx->active_cmd));
 
-	if (IS_ENABLED(CONFIG_SHELL_HISTORY)) {
+	if (IS_ENABLED(CONFIG_SHELL_HISTORY) && !z_flag_batch_get(shell)) {
 		z_shell_cmd_trim(shell);
 		history_put(shell, shell->ctx->cmd_buff,
 			    shell->ctx->cmd_buff_len);
@@ -943,6 +996,59 @@ static inline int ascii_filter(const char data)
 	return (uint8_t) data > SHELL_ASCII_MAX_CHAR ? -EINVAL : 0;
 }
 
+static void batch_line_execute(const struct shell *shell)
+{
+	int ret;
+
+	if (z_flag_batch_ovf_set(shell, false)) {
+		ret = -E2BIG;
+	} else if (shell->ctx->cmd_buff_len == 0) {
+		return;
+	} else {
+		shell->ctx->cmd_buff[shell->ctx->cmd_buff_len] = '\0';
+		ret = execute(shell);
+	}
+
+	if (ret == 0) {
+		z_shell_fprintf(shell, SHELL_NORMAL, "OK\n");
+	} else {
+		z_shell_fprintf(shell, SHELL_NORMAL, "ERR %d\n", ret);
+	}
+
+	/* Prints the prompt if the command has left batch mode. */
+	state_set(shell, SHELL_STATE_ACTIVE);
+}
+
+/* Batch mode input: characters are appended to the command buffer without
+ * any echo or editing and each complete line is executed at once.
+ */
+static void batch_char_process(const struct shell *shell, char data)
+{
+	if (process_nl(shell, data)) {
+		batch_line_execute(shell);
+		return;
+	}
+
+	if ((data == '\r') || (data == '\n')) {
+		/* Second character of a CR LF pair. */
+		return;
+	}
+
+	if (data == '\t') {
+		data = ' ';
+	} else if (!isprint((int) data)) {
+		return;
+	}
+
+	if (shell->ctx->cmd_buff_len + 1 >= CONFIG_SHELL_CMD_BUFF_SIZE) {
+		z_flag_batch_ovf_set(shell, true);
+		return;
+	}
+
+	shell->ctx->cmd_buff[shell->ctx->cmd_buff_len++] = data;
+	shell->ctx->cmd_buff_pos = shell->ctx->cmd_buff_len;
+}
+
 static void state_collect(const struct shell *shell)
 {
 	size_t count = 0;
@@ -979,6 +1085,11 @@ static void state_collect(const struct shell *shell)
 			continue;
 		}
 
+		if (z_flag_batch_get(shell)) {
+			batch_char_process(shell, data);
+			continue;
+		}
+
 		switch (shell->ctx->receive_state) {
 		case SHELL_RECEIVE_DEFAULT:
 			if (process_nl(shell, data)) {
@@ -1649,6 +1760,23 @@ int shell_echo_set(const struct shell *shell, bool val)
 	return (int)z_flag_echo_set(shell, val);
 }
 
+int shell_batch_mode_set(const struct shell *shell, bool val)
+{
+	if (shell == NULL) {
+		return -EINVAL;
+	}
+
+	if (!IS_ENABLED(CONFIG_SHELL_BATCH_MODE)) {
+		return -ENOTSUP;
+	}
+
+	if (val) {
+		receive_state_change(shell, SHELL_RECEIVE_DEFAULT);
+	}
+
+	return (int)z_flag_batch_set(shell, val);
+}
+
 int shell_obscure_set(const struct shell *shell, bool val)
 {
 	if (shell == NULL) {
@@ -41,6 +41,12 @@
 #define SHELL_HELP_ECHO_OFF	\
 	"Disable shell echo. Editing keys and meta-keys are not handled"
 
+#define SHELL_HELP_BATCH	"Batch mode for scripted input."
+#define SHELL_HELP_BATCH_ON	\
+	"Enter batch mode. Input is not echoed nor edited, each line is "   \
+	"executed and followed by OK or ERR <ret>."
+#define SHELL_HELP_BATCH_OFF	"Leave batch mode."
+
 #define SHELL_HELP_SELECT	"Selects new root command. In order for the " \
 	"command to be selected, it must meet the criteria:\n"		      \
 	" - it is a static command\n"					      \
@@ -278,6 +284,26 @@ static int cmd_echo(const struct shell *shell, size_t argc, char **argv)
 	return 0;
 }
 
+static int cmd_batch_on(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_batch_mode_set(shell, true);
+
+	return 0;
+}
+
+static int cmd_batch_off(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_batch_mode_set(shell, false);
+
+	return 0;
+}
+
 static int cmd_history(const struct shell *shell, size_t argc, char **argv)
 {
 	ARG_UNUSED(argc);
@@ -405,6 +431,12 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_echo,
 	SHELL_SUBCMD_SET_END
 );
 
+SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_batch,
+	SHELL_CMD_ARG(off, NULL, SHELL_HELP_BATCH_OFF, cmd_batch_off, 1, 0),
+	SHELL_CMD_ARG(on, NULL, SHELL_HELP_BATCH_ON, cmd_batch_on, 1, 0),
+	SHELL_SUBCMD_SET_END
+);
+
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_shell_stats,
 	SHELL_CMD_ARG(reset, NULL, SHELL_HELP_STATISTICS_RESET,
 			cmd_shell_stats_reset, 1, 0),
@@ -424,6 +456,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_backspace_mode,
 SHELL_STATIC_SUBCMD_SET_CREATE(m_sub_shell,
 	SHELL_CMD(backspace_mode, &m_sub_backspace_mode,
 			SHELL_HELP_BACKSPACE_MODE, NULL),
+	SHELL_COND_CMD(CONFIG_SHELL_BATCH_MODE, batch, &m_sub_batch,
+		       SHELL_HELP_BATCH, NULL),
 	SHELL_COND_CMD(CONFIG_SHELL_VT100_COMMANDS, colors, &m_sub_colors,
 		       SHELL_HELP_COLORS, NULL),
 	SHELL_CMD_ARG(echo, &m_sub_echo, SHELL_HELP_ECHO, cmd_echo, 1, 1),
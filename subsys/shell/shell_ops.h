@@ -65,7 +65,10 @@ static inline bool z_flag_insert_mode_set(const struct shell *sh, bool val)
 
 static inline bool z_flag_use_colors_get(const struct shell *sh)
 {
-	return sh->ctx->cfg.flags.use_colors == 1;
+	/* No VT100 escape sequences are sent in batch mode. */
+	return (sh->ctx->cfg.flags.use_colors == 1) &&
+	       !(IS_ENABLED(CONFIG_SHELL_BATCH_MODE) &&
+		 (sh->ctx->ctx.flags.batch == 1));
 }
 
 static inline bool z_flag_use_colors_set(const struct shell *sh, bool val)
@@ -216,6 +219,28 @@ static inline bool z_flag_sync_mode_set(const struct shell *sh, bool val)
 	return ret;
 }
 
+static inline bool z_flag_batch_get(const struct shell *sh)
+{
+	return IS_ENABLED(CONFIG_SHELL_BATCH_MODE) &&
+	       (sh->ctx->ctx.flags.batch == 1);
+}
+
+static inline bool z_flag_batch_set(const struct shell *sh, bool val)
+{
+	bool ret;
+
+	Z_SHELL_SET_FLAG_ATOMIC(sh, ctx, batch, val, ret);
+	return ret;
+}
+
+static inline bool z_flag_batch_ovf_set(const struct shell *sh, bool val)
+{
+	bool ret;
+
+	Z_SHELL_SET_FLAG_ATOMIC(sh, ctx, batch_ovf, val, ret);
+	return ret;
+}
+
 /* Function sends VT100 command to clear the screen from cursor position to
  * end of the screen.
  */
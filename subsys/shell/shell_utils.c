@@ -268,13 +268,12 @@ static inline uint32_t shell_root_cmd_count(void)
 const struct shell_static_entry *root_cmd_find(const char *syntax)
 {
 	const size_t cmd_count = shell_root_cmd_count();
-	const union shell_cmd_entry *cmd;
+	size_t idx = z_shell_cmd_lower_bound(NULL, cmd_count, syntax,
+					     SIZE_MAX);
 
-	for (size_t cmd_idx = 0; cmd_idx < cmd_count; ++cmd_idx) {
-		cmd = shell_root_cmd_get(cmd_idx);
-		if (strcmp(syntax, cmd->entry->syntax) == 0) {
-			return cmd->entry;
-		}
+	if ((idx < cmd_count) &&
+	    (strcmp(syntax, shell_root_cmd_get(idx)->entry->syntax) == 0)) {
+		return shell_root_cmd_get(idx)->entry;
 	}
 
 	return NULL;
@@ -322,6 +321,144 @@ const struct shell_static_entry *z_shell_cmd_get(
 	return res;
 }
 
+/* Number of commands of recently used sorted subcommand sets, so that a
+ * lookup does not walk the whole set to find its end.
+ */
+#define SORTED_CNT_CACHE_SIZE 16
+
+static struct {
+	const union shell_cmd_entry *set;
+	size_t cnt;
+} sorted_cnt_cache[SORTED_CNT_CACHE_SIZE];
+
+static struct k_spinlock sorted_cnt_cache_lock;
+
+static inline size_t sorted_cnt_cache_idx(const union shell_cmd_entry *set)
+{
+	return ((uintptr_t)set / sizeof(void *)) % SORTED_CNT_CACHE_SIZE;
+}
+
+#if __ASSERT_ON
+/* Check that the commands of a set are listed in strcmp() order, skipping the
+ * ones disabled with SHELL_COND_CMD.
+ */
+static bool is_set_sorted(const struct shell_static_entry *entry_list,
+			  size_t cnt)
+{
+	const char *prev = NULL;
+
+	for (size_t idx = 0; idx < cnt; idx++) {
+		if (entry_list[idx].syntax[0] == '\0') {
+			continue;
+		}
+
+		if ((prev != NULL) &&
+		    (strcmp(prev, entry_list[idx].syntax) >= 0)) {
+			return false;
+		}
+
+		prev = entry_list[idx].syntax;
+	}
+
+	return true;
+}
+#endif
+
+bool z_shell_cmd_sorted_count(const struct shell_static_entry *parent,
+			      size_t *cnt)
+{
+	const struct shell_static_entry *entry_list;
+	k_spinlock_key_t key;
+	size_t cache_idx;
+	size_t idx = 0;
+
+	/* Root commands and subcommands added with SHELL_SUBCMD_ADD are
+	 * placed in memory sections sorted by name by the linker.
+	 */
+	if (parent == NULL) {
+		*cnt = shell_root_cmd_count();
+		return true;
+	}
+
+	if ((parent->subcmd == NULL) || is_dynamic_cmd(parent->subcmd)) {
+		return false;
+	}
+
+	if (is_section_cmd(parent->subcmd)) {
+		/* First element is null */
+		entry_list =
+			(const struct shell_static_entry *)parent->subcmd + 1;
+	} else if (IS_ENABLED(CONFIG_SHELL_SORTED_SUBCMD_SETS)) {
+		entry_list = parent->subcmd->entry;
+	} else {
+		return false;
+	}
+
+	cache_idx = sorted_cnt_cache_idx(parent->subcmd);
+	key = k_spin_lock(&sorted_cnt_cache_lock);
+	if (sorted_cnt_cache[cache_idx].set == parent->subcmd) {
+		*cnt = sorted_cnt_cache[cache_idx].cnt;
+		k_spin_unlock(&sorted_cnt_cache_lock, key);
+		return true;
+	}
+	k_spin_unlock(&sorted_cnt_cache_lock, key);
+
+	while (entry_list[idx].syntax != NULL) {
+		idx++;
+	}
+
+	/* Sets created with SHELL_STATIC_SUBCMD_SET_CREATE are only assumed to
+	 * be sorted, commands listed out of order could not be found.
+	 */
+	__ASSERT(is_section_cmd(parent->subcmd) || is_set_sorted(entry_list, idx),
+		 "Subcommands of \"%s\" are not sorted", parent->syntax);
+
+	key = k_spin_lock(&sorted_cnt_cache_lock);
+	sorted_cnt_cache[cache_idx].set = parent->subcmd;
+	sorted_cnt_cache[cache_idx].cnt = idx;
+	k_spin_unlock(&sorted_cnt_cache_lock, key);
+
+	*cnt = idx;
+
+	return true;
+}
+
+size_t z_shell_cmd_lower_bound(const struct shell_static_entry *parent,
+			       size_t cnt, const char *str, size_t len)
+{
+	struct shell_static_entry dloc;
+	size_t lo = 0;
+	size_t hi = cnt;
+
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		size_t probe = mid;
+		const struct shell_static_entry *entry;
+
+		/* Commands disabled with SHELL_COND_CMD keep their slot with
+		 * an empty syntax, compare against the next valid one.
+		 */
+		entry = z_shell_cmd_get(parent, probe, &dloc);
+		while ((entry->syntax[0] == '\0') && (probe + 1 < hi)) {
+			entry = z_shell_cmd_get(parent, ++probe, &dloc);
+		}
+
+		if ((entry->syntax[0] != '\0') &&
+		    (strncmp(entry->syntax, str, len) < 0)) {
+			lo = probe + 1;
+		} else {
+			hi = mid;
+		}
+	}
+
+	while ((lo < cnt) &&
+	       (z_shell_cmd_get(parent, lo, &dloc)->syntax[0] == '\0')) {
+		lo++;
+	}
+
+	return lo;
+}
+
 /* Function returns pointer to a command matching given pattern.
  *
  * @param cmd		Pointer to commands array that will be searched.
@@ -340,6 +477,7 @@ const struct shell_static_entry *z_shell_find_cmd(
 	const struct shell_static_entry *entry;
 	struct shell_static_entry parent_cpy;
 	size_t idx = 0;
+	size_t cnt;
 
 	/* Dynamic command operates on shared memory. If we are processing two
 	 * dynamic commands at the same time (current and subcommand) they
@@ -352,6 +490,18 @@ const struct shell_static_entry *z_shell_find_cmd(
 		parent = &parent_cpy;
 	}
 
+	if (z_shell_cmd_sorted_count(parent, &cnt)) {
+		idx = z_shell_cmd_lower_bound(parent, cnt, cmd_str, SIZE_MAX);
+		if (idx < cnt) {
+			entry = z_shell_cmd_get(parent, idx, dloc);
+			if (strcmp(cmd_str, entry->syntax) == 0) {
+				return entry;
+			}
+		}
+
+		return NULL;
+	}
+
 	while ((entry = z_shell_cmd_get(parent, idx++, dloc)) != NULL) {
 		if (strcmp(cmd_str, entry->syntax) == 0) {
 			return entry;
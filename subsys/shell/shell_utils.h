@@ -53,6 +53,31 @@ const struct shell_static_entry *z_shell_cmd_get(
 					size_t idx,
 					struct shell_static_entry *dloc);
 
+/** @brief Check if subcommands of given parent can be binary searched.
+ *
+ * @param parent	Parent entry. Null for root commands.
+ * @param cnt		Location to store number of subcommands.
+ *
+ * @return True if subcommands are static and sorted by syntax.
+ */
+bool z_shell_cmd_sorted_count(const struct shell_static_entry *parent,
+			      size_t *cnt);
+
+/** @brief Find first sorted subcommand not lower than given string.
+ *
+ * Comparison is done on at most @p len characters, so passing the length of
+ * a prefix returns the first command starting with it.
+ *
+ * @param parent	Parent entry. Null for root commands.
+ * @param cnt		Number of subcommands from z_shell_cmd_sorted_count().
+ * @param str		String to search for.
+ * @param len		Maximum number of characters to compare.
+ *
+ * @return Index of found command or @p cnt if there is none.
+ */
+size_t z_shell_cmd_lower_bound(const struct shell_static_entry *parent,
+			       size_t cnt, const char *str, size_t len);
+
 const struct shell_static_entry *z_shell_find_cmd(
 					const struct shell_static_entry *parent,
 					const char *cmd_str,
@@ -12,6 +12,8 @@ LOG_MODULE_REGISTER(LOG_MODULE_NAME, CONFIG_STREAM_FLASH_LOG_LEVEL);
 
 #include <zephyr/types.h>
 #include <string.h>
+#include <zephyr/init.h>
+#include <zephyr/kernel.h>
 #include <zephyr/drivers/flash.h>
 
 #include <zephyr/storage/stream_flash.h>
@@ -39,6 +41,9 @@ static int settings_direct_loader(const char *key, size_t len,
 		/* Check that loaded progress is not outdated. */
 		if (bytes_written >= ctx->bytes_written) {
 			ctx->bytes_written = bytes_written;
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+			ctx->bytes_queued = bytes_written;
+#endif
 		} else {
 			LOG_WRN("Loaded outdated bytes_written %zu < %zu",
 				bytes_written, ctx->bytes_written);
@@ -74,6 +79,162 @@ static int settings_direct_loader(const char *key, size_t len,
 
 #ifdef CONFIG_STREAM_FLASH_ERASE
 
+static int erase_page(struct stream_flash_ctx *ctx,
+		      const struct flash_pages_info *page)
+{
+	int rc;
+
+	LOG_DBG("Erasing page at offset 0x%08lx", (long)page->start_offset);
+
+	rc = flash_erase(ctx->fdev, page->start_offset, page->size);
+
+	if (rc != 0) {
+		LOG_ERR("Error %d while erasing page", rc);
+	}
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+
+static K_KERNEL_STACK_DEFINE(pre_erase_stack,
+			     CONFIG_STREAM_FLASH_PRE_ERASE_STACK_SIZE);
+static struct k_work_q pre_erase_workq;
+
+static inline bool pre_erase_used(struct stream_flash_ctx *ctx)
+{
+	return ctx->pre_erase_end > ctx->pre_erase_start;
+}
+
+/* Erase the next page of the pre-erase range, called with the lock held */
+static int pre_erase_next_page(struct stream_flash_ctx *ctx)
+{
+	struct flash_pages_info page;
+	int rc;
+
+	rc = flash_get_page_info_by_offs(ctx->fdev, ctx->pre_erase_next, &page);
+	if (rc == 0) {
+		rc = erase_page(ctx, &page);
+	}
+
+	if (rc == 0) {
+		ctx->pre_erase_next = page.start_offset + page.size;
+	}
+
+	return rc;
+}
+
+/* Erase a page needed by a write, unless it was erased ahead */
+static int pre_erase_claim(struct stream_flash_ctx *ctx,
+			   const struct flash_pages_info *page)
+{
+	struct stream_flash_pre_erase_stats *stats = &ctx->pre_erase_stats;
+	int rc = 0;
+
+	k_mutex_lock(&ctx->pre_erase_lock, K_FOREVER);
+
+	if ((page->start_offset >= ctx->pre_erase_start) &&
+	    (page->start_offset < ctx->pre_erase_next)) {
+		stats->hits++;
+	} else if (stats->active && (page->start_offset >= ctx->pre_erase_next) &&
+		   (page->start_offset < ctx->pre_erase_end)) {
+		/* The write caught up, erase in place of the pre-erase thread
+		 * so it does not erase the page again after it is written.
+		 */
+		stats->misses++;
+		while ((rc == 0) &&
+		       (ctx->pre_erase_next <= page->start_offset)) {
+			rc = pre_erase_next_page(ctx);
+		}
+	} else {
+		rc = erase_page(ctx, page);
+	}
+
+	k_mutex_unlock(&ctx->pre_erase_lock);
+
+	return rc;
+}
+
+static void pre_erase_work_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(dwork, struct stream_flash_ctx, pre_erase_work);
+	struct stream_flash_pre_erase_stats *stats = &ctx->pre_erase_stats;
+	struct flash_pages_info page;
+	int rc;
+
+	k_mutex_lock(&ctx->pre_erase_lock, K_FOREVER);
+
+	if (!stats->active) {
+		goto out;
+	}
+
+	rc = flash_get_page_info_by_offs(ctx->fdev, ctx->pre_erase_next, &page);
+	if ((rc == 0) && (page.start_offset + page.size > ctx->pre_erase_end)) {
+		/* The last page is shared with data after the write area, it
+		 * is left to the writes.
+		 */
+		ctx->pre_erase_end = ctx->pre_erase_next;
+	} else if (rc == 0) {
+		rc = pre_erase_next_page(ctx);
+	}
+
+	if (rc != 0) {
+		LOG_ERR("Pre-erase stopped at 0x%08lx: %d",
+			(long)ctx->pre_erase_next, rc);
+		stats->error = rc;
+		stats->active = false;
+	} else if (ctx->pre_erase_next >= ctx->pre_erase_end) {
+		stats->active = false;
+	} else {
+		k_work_schedule_for_queue(&pre_erase_workq, dwork,
+				K_MSEC(CONFIG_STREAM_FLASH_PRE_ERASE_INTERVAL_MS));
+	}
+
+out:
+	k_mutex_unlock(&ctx->pre_erase_lock);
+}
+
+/* The handler only matches once the work item was initialized, a new context
+ * may hold anything.
+ */
+static inline bool pre_erase_initialized(struct stream_flash_ctx *ctx)
+{
+	return ctx->pre_erase_work.work.handler == pre_erase_work_handler;
+}
+
+static int stream_flash_pre_erase_sys_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&pre_erase_workq, pre_erase_stack,
+			   K_KERNEL_STACK_SIZEOF(pre_erase_stack),
+			   K_PRIO_PREEMPT(CONFIG_STREAM_FLASH_PRE_ERASE_THREAD_PRIO),
+			   NULL);
+	k_thread_name_set(&pre_erase_workq.thread, "stream_flash_erase");
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_pre_erase_sys_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+
+static inline bool pre_erase_used(struct stream_flash_ctx *ctx)
+{
+	return false;
+}
+
+static inline int pre_erase_claim(struct stream_flash_ctx *ctx,
+				  const struct flash_pages_info *page)
+{
+	return -ENOTSUP;
+}
+
+#endif /* CONFIG_STREAM_FLASH_PRE_ERASE */
+
 int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 {
 	int rc;
@@ -89,13 +250,13 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 		return 0;
 	}
 
-	LOG_DBG("Erasing page at offset 0x%08lx", (long)page.start_offset);
-
-	rc = flash_erase(ctx->fdev, page.start_offset, page.size);
-
-	if (rc != 0) {
-		LOG_ERR("Error %d while erasing page", rc);
+	if (pre_erase_used(ctx)) {
+		rc = pre_erase_claim(ctx, &page);
 	} else {
+		rc = erase_page(ctx, &page);
+	}
+
+	if (rc == 0) {
 		ctx->last_erased_page_start_offset = page.start_offset;
 	}
 
@@ -104,7 +265,8 @@ int stream_flash_erase_page(struct stream_flash_ctx *ctx, off_t off)
 
 #endif /* CONFIG_STREAM_FLASH_ERASE */
 
-static int flash_sync(struct stream_flash_ctx *ctx)
+static int flash_program(struct stream_flash_ctx *ctx, uint8_t *buf,
+			 size_t len)
 {
 	int rc = 0;
 	size_t write_addr = ctx->offset + ctx->bytes_written;
@@ -112,15 +274,9 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	size_t fill_length;
 	uint8_t filler;
 
-
-	if (ctx->buf_bytes == 0) {
-		return 0;
-	}
-
 	if (IS_ENABLED(CONFIG_STREAM_FLASH_ERASE)) {
 
-		rc = stream_flash_erase_page(ctx,
-					     write_addr + ctx->buf_bytes - 1);
+		rc = stream_flash_erase_page(ctx, write_addr + len - 1);
 		if (rc < 0) {
 			LOG_ERR("stream_flash_erase_page err %d offset=0x%08zx",
 				rc, write_addr);
@@ -129,17 +285,17 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 	}
 
 	fill_length = flash_get_write_block_size(ctx->fdev);
-	if (ctx->buf_bytes % fill_length) {
-		fill_length -= ctx->buf_bytes % fill_length;
+	if (len % fill_length) {
+		fill_length -= len % fill_length;
 		filler = flash_get_parameters(ctx->fdev)->erase_value;
 
-		memset(ctx->buf + ctx->buf_bytes, filler, fill_length);
+		memset(buf + len, filler, fill_length);
 	} else {
 		fill_length = 0;
 	}
 
-	buf_bytes_aligned = ctx->buf_bytes + fill_length;
-	rc = flash_write(ctx->fdev, write_addr, ctx->buf, buf_bytes_aligned);
+	buf_bytes_aligned = len + fill_length;
+	rc = flash_write(ctx->fdev, write_addr, buf, buf_bytes_aligned);
 
 	if (rc != 0) {
 		LOG_ERR("flash_write error %d offset=0x%08zx", rc,
@@ -151,30 +307,204 @@ static int flash_sync(struct stream_flash_ctx *ctx)
 		/* Invert to ensure that caller is able to discover a faulty
 		 * flash_read() even if no error code is returned.
 		 */
-		for (int i = 0; i < ctx->buf_bytes; i++) {
-			ctx->buf[i] = ~ctx->buf[i];
+		for (int i = 0; i < len; i++) {
+			buf[i] = ~buf[i];
 		}
 
-		rc = flash_read(ctx->fdev, write_addr, ctx->buf,
-				ctx->buf_bytes);
+		rc = flash_read(ctx->fdev, write_addr, buf, len);
 		if (rc != 0) {
 			LOG_ERR("flash read failed: %d", rc);
 			return rc;
 		}
 
-		rc = ctx->callback(ctx->buf, ctx->buf_bytes, write_addr);
+		rc = ctx->callback(buf, len, write_addr);
 		if (rc != 0) {
 			LOG_ERR("callback failed: %d", rc);
 			return rc;
 		}
 	}
 
-	ctx->bytes_written += ctx->buf_bytes;
+	ctx->bytes_written += len;
+
+	return rc;
+}
+
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+
+#define SLOT_COUNT CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS
+
+static K_KERNEL_STACK_DEFINE(stream_flash_stack,
+			     CONFIG_STREAM_FLASH_BACKGROUND_STACK_SIZE);
+static struct k_work_q stream_flash_workq;
+
+static inline bool in_background(struct stream_flash_ctx *ctx)
+{
+	return ctx->slots != NULL;
+}
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+/* Erase the page the data of the slot being filled has reached, so the
+ * slot is not held up by the erase once it is full. Pages past the data are
+ * left alone, as the stream may end before them.
+ */
+static void erase_ahead(struct stream_flash_ctx *ctx)
+{
+	/* Racing with the caller only ever yields less data than there is */
+	size_t filled = ctx->buf_bytes;
+
+	if (filled == 0) {
+		return;
+	}
+
+	/* On error the page is erased again before it is written */
+	(void)stream_flash_erase_page(ctx,
+				      ctx->offset + ctx->bytes_written + filled - 1);
+}
+#endif
+
+static void background_work_handler(struct k_work *work)
+{
+	struct stream_flash_ctx *ctx =
+		CONTAINER_OF(work, struct stream_flash_ctx, work);
+
+	while (atomic_get(&ctx->queued) > 0) {
+		uint8_t slot = ctx->write_slot;
+		size_t len = ctx->slot_bytes[slot];
+
+		/* Data after a failed write would be written at the wrong
+		 * offset, drop it.
+		 */
+		if (ctx->error == 0) {
+			ctx->error = flash_program(ctx,
+						   ctx->slots + slot * ctx->buf_len,
+						   len);
+		}
+
+		ctx->write_slot = (slot + 1) % SLOT_COUNT;
+		atomic_dec(&ctx->queued);
+		k_sem_give(&ctx->free_slots);
+
+#ifdef CONFIG_STREAM_FLASH_ERASE
+		if ((ctx->error == 0) && (atomic_get(&ctx->queued) == 0)) {
+			erase_ahead(ctx);
+		}
+#endif
+	}
+}
+
+/* Hand the filled slot to the writer and move on to the next one */
+static int background_queue(struct stream_flash_ctx *ctx)
+{
+	ctx->slot_bytes[ctx->fill_slot] = ctx->buf_bytes;
+	ctx->bytes_queued += ctx->buf_bytes;
+
+	atomic_inc(&ctx->queued);
+	k_work_submit_to_queue(&stream_flash_workq, &ctx->work);
+
+	/* Slots are programmed in order, so the next slot is free as soon
+	 * as any slot is.
+	 */
+	k_sem_take(&ctx->free_slots, K_FOREVER);
+
+	ctx->fill_slot = (ctx->fill_slot + 1) % SLOT_COUNT;
+	ctx->buf = ctx->slots + ctx->fill_slot * ctx->buf_len;
 	ctx->buf_bytes = 0U;
 
+	return ctx->error;
+}
+
+static int background_wait(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	(void)k_work_flush(&ctx->work, &sync);
+
+	return ctx->error;
+}
+
+/* Stop the writer of a context that was used in the background before. The
+ * handler only matches once the work item was initialized, a new context may
+ * hold anything.
+ */
+static void background_cancel(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	if (ctx->work.handler == background_work_handler) {
+		(void)k_work_cancel_sync(&ctx->work, &sync);
+	}
+}
+
+static int stream_flash_background_sys_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	k_work_queue_start(&stream_flash_workq, stream_flash_stack,
+			   K_KERNEL_STACK_SIZEOF(stream_flash_stack),
+			   CONFIG_STREAM_FLASH_BACKGROUND_THREAD_PRIO, NULL);
+	k_thread_name_set(&stream_flash_workq.thread, "stream_flash");
+
+	return 0;
+}
+
+SYS_INIT(stream_flash_background_sys_init, POST_KERNEL,
+	 CONFIG_KERNEL_INIT_PRIORITY_DEFAULT);
+
+#else
+
+static inline bool in_background(struct stream_flash_ctx *ctx)
+{
+	return false;
+}
+
+static inline int background_queue(struct stream_flash_ctx *ctx)
+{
+	return -ENOTSUP;
+}
+
+static inline int background_wait(struct stream_flash_ctx *ctx)
+{
+	return -ENOTSUP;
+}
+
+static inline void background_cancel(struct stream_flash_ctx *ctx)
+{
+}
+
+#endif /* CONFIG_STREAM_FLASH_BACKGROUND */
+
+static int flash_sync(struct stream_flash_ctx *ctx)
+{
+	int rc;
+
+	if (ctx->buf_bytes == 0) {
+		return 0;
+	}
+
+	if (in_background(ctx)) {
+		return background_queue(ctx);
+	}
+
+	rc = flash_program(ctx, ctx->buf, ctx->buf_bytes);
+	if (rc == 0) {
+		ctx->buf_bytes = 0U;
+	}
+
 	return rc;
 }
 
+/* Number of bytes accepted so far, excluding the ones still in ctx->buf */
+static size_t bytes_accepted(struct stream_flash_ctx *ctx)
+{
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+	if (in_background(ctx)) {
+		return ctx->bytes_queued;
+	}
+#endif
+
+	return ctx->bytes_written;
+}
+
 int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *data,
 				size_t len, bool flush)
 {
@@ -186,7 +516,13 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		return -EFAULT;
 	}
 
-	if (ctx->bytes_written + ctx->buf_bytes + len > ctx->available) {
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+	if (in_background(ctx) && (ctx->error != 0)) {
+		return ctx->error;
+	}
+#endif
+
+	if (bytes_accepted(ctx) + ctx->buf_bytes + len > ctx->available) {
 		return -ENOMEM;
 	}
 
@@ -212,10 +548,23 @@ int stream_flash_buffered_write(struct stream_flash_ctx *ctx, const uint8_t *dat
 		ctx->buf_bytes += len - processed;
 	}
 
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+	/* Nothing is written past the end of the stream */
+	if (flush) {
+		(void)stream_flash_pre_erase_stop(ctx);
+	}
+#endif
+
 	if (flush && ctx->buf_bytes > 0) {
 		rc = flash_sync(ctx);
 	}
 
+	if (flush && in_background(ctx)) {
+		int wait_rc = background_wait(ctx);
+
+		rc = (rc == 0) ? wait_rc : rc;
+	}
+
 	return rc;
 }
 
@@ -253,6 +602,9 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 		return -EFAULT;
 	}
 
+	/* The writer must not see the context change under it */
+	background_cancel(ctx);
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 	int rc = settings_subsys_init();
 
@@ -300,9 +652,168 @@ int stream_flash_init(struct stream_flash_ctx *ctx, const struct device *fdev,
 	ctx->last_erased_page_start_offset = -1;
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+	ctx->slots = NULL;
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+	/* The eraser must not see its state reset under it */
+	(void)stream_flash_pre_erase_stop(ctx);
+
+	ctx->pre_erase_start = 0;
+	ctx->pre_erase_next = 0;
+	ctx->pre_erase_end = 0;
+	memset(&ctx->pre_erase_stats, 0, sizeof(ctx->pre_erase_stats));
+#endif
+
+	return 0;
+}
+
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+
+int stream_flash_init_background(struct stream_flash_ctx *ctx,
+				 const struct device *fdev, uint8_t *buf,
+				 size_t buf_len, size_t offset, size_t size,
+				 stream_flash_callback_t cb)
+{
+	int rc;
+
+	/* Each slot is checked against the write block and page size */
+	rc = stream_flash_init(ctx, fdev, buf, buf_len / SLOT_COUNT, offset,
+			       size, cb);
+	if (rc != 0) {
+		return rc;
+	}
+
+	if (ctx->buf_len == 0) {
+		LOG_ERR("Buffer too small for %d slots", SLOT_COUNT);
+		return -EFAULT;
+	}
+
+	ctx->slots = buf;
+	ctx->fill_slot = 0U;
+	ctx->write_slot = 0U;
+	atomic_set(&ctx->queued, 0);
+	k_sem_init(&ctx->free_slots, SLOT_COUNT - 1, SLOT_COUNT - 1);
+	k_work_init(&ctx->work, background_work_handler);
+	ctx->bytes_queued = 0;
+	ctx->error = 0;
+
+	return 0;
+}
+
+#endif /* CONFIG_STREAM_FLASH_BACKGROUND */
+
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+
+int stream_flash_pre_erase_start(struct stream_flash_ctx *ctx)
+{
+	struct stream_flash_pre_erase_stats *stats;
+	struct flash_pages_info page;
+	off_t start;
+	off_t end;
+	int rc;
+
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	/* The lock and the work item are shared with a previous pre-erase,
+	 * which may still be running.
+	 */
+	if (!pre_erase_initialized(ctx)) {
+		k_mutex_init(&ctx->pre_erase_lock);
+		k_work_init_delayable(&ctx->pre_erase_work,
+				      pre_erase_work_handler);
+	}
+
+	k_mutex_lock(&ctx->pre_erase_lock, K_FOREVER);
+
+	stats = &ctx->pre_erase_stats;
+	if (stats->active) {
+		rc = -EALREADY;
+		goto out;
+	}
+
+	start = ctx->offset + bytes_accepted(ctx);
+	end = ctx->offset + ctx->available;
+
+	if (start < end) {
+		rc = flash_get_page_info_by_offs(ctx->fdev, start, &page);
+		if (rc != 0) {
+			LOG_ERR("Error %d while getting page info", rc);
+			goto out;
+		}
+
+		/* A page already holding data is erased by the writes */
+		if (page.start_offset != start) {
+			start = page.start_offset + page.size;
+		}
+	}
+
+	ctx->pre_erase_start = start;
+	ctx->pre_erase_next = start;
+	ctx->pre_erase_end = MAX(start, end);
+
+	memset(stats, 0, sizeof(*stats));
+	stats->total = ctx->pre_erase_end - start;
+	stats->active = (stats->total > 0);
+
+	if (stats->active) {
+		k_work_schedule_for_queue(&pre_erase_workq,
+					  &ctx->pre_erase_work, K_NO_WAIT);
+	}
+
+	rc = 0;
+out:
+	k_mutex_unlock(&ctx->pre_erase_lock);
+
+	return rc;
+}
+
+int stream_flash_pre_erase_stop(struct stream_flash_ctx *ctx)
+{
+	struct k_work_sync sync;
+
+	if (!ctx) {
+		return -EFAULT;
+	}
+
+	if (!pre_erase_initialized(ctx)) {
+		return 0;
+	}
+
+	k_mutex_lock(&ctx->pre_erase_lock, K_FOREVER);
+	ctx->pre_erase_stats.active = false;
+	k_mutex_unlock(&ctx->pre_erase_lock);
+
+	(void)k_work_cancel_delayable_sync(&ctx->pre_erase_work, &sync);
+
+	return 0;
+}
+
+int stream_flash_pre_erase_stats_get(struct stream_flash_ctx *ctx,
+				     struct stream_flash_pre_erase_stats *stats)
+{
+	if (!ctx || !stats) {
+		return -EFAULT;
+	}
+
+	if (!pre_erase_initialized(ctx)) {
+		*stats = ctx->pre_erase_stats;
+		return 0;
+	}
+
+	k_mutex_lock(&ctx->pre_erase_lock, K_FOREVER);
+	*stats = ctx->pre_erase_stats;
+	stats->erased = ctx->pre_erase_next - ctx->pre_erase_start;
+	k_mutex_unlock(&ctx->pre_erase_lock);
+
 	return 0;
 }
 
+#endif /* CONFIG_STREAM_FLASH_PRE_ERASE */
+
 #ifdef CONFIG_STREAM_FLASH_PROGRESS
 
 int stream_flash_progress_load(struct stream_flash_ctx *ctx,
@@ -0,0 +1,362 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/buf.h>
+#include <zephyr/bluetooth/conn.h>
+#include <zephyr/bluetooth/gatt.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/l2cap.h>
+#include <zephyr/drivers/bluetooth/hci_driver.h>
+
+/* ACL fragmentation benchmark. A test HCI driver stands in for a controller
+ * with 27 byte ACL buffers: it answers the commands needed to enable the
+ * host and accept a connection, then copies every ACL fragment it is given
+ * and completes it right away. Notifications filling the ATT MTU are sent
+ * over the connection, so each one is split into ten fragments. The copy
+ * run allocates a fragment buffer for each of them, the in place run sets
+ * BT_QUIRK_TX_DATA_COPIED so they are sent from the original buffer.
+ */
+
+#define CONN_HANDLE 0x0001
+#define ACL_MTU 27
+#define ACL_PKTS 4
+#define ATT_MTU 247
+#define NTF_LEN (ATT_MTU - 3)
+#define N_NOTIFICATIONS 4000
+
+#define ATT_OP_MTU_REQ 0x02
+#define ATT_OP_NOTIFY 0x1b
+#define ATT_CID 0x0004
+
+BT_GATT_SERVICE_DEFINE(bench_svc,
+	BT_GATT_PRIMARY_SERVICE(BT_UUID_DECLARE_16(0xfd00)),
+	BT_GATT_CHARACTERISTIC(BT_UUID_DECLARE_16(0xfe00), BT_GATT_CHRC_NOTIFY,
+			       BT_GATT_PERM_NONE, NULL, NULL, NULL));
+
+static uint8_t ntf_data[NTF_LEN];
+
+/* L2CAP PDU being reassembled by the test driver */
+static uint8_t pdu[BT_L2CAP_HDR_SIZE + ATT_MTU];
+static size_t pdu_len;
+static size_t pdu_total;
+
+static uint32_t ntf_received;
+static bool ntf_invalid;
+static K_SEM_DEFINE(ntf_sem, 0, 1);
+
+static struct bt_conn *bench_conn;
+static K_SEM_DEFINE(conn_sem, 0, 1);
+
+static struct net_buf *cmd_complete(uint16_t opcode, uint8_t plen)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+	struct bt_hci_evt_hdr *hdr;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = BT_HCI_EVT_CMD_COMPLETE;
+	hdr->len = sizeof(*cc) + plen;
+
+	cc = net_buf_add(buf, sizeof(*cc));
+	cc->ncmd = 1U;
+	cc->opcode = sys_cpu_to_le16(opcode);
+
+	(void)memset(net_buf_add(buf, plen), 0, plen);
+
+	return buf;
+}
+
+/* Every command succeeds, return parameters not set here are zero */
+static void cmd_handle(struct net_buf *buf)
+{
+	struct bt_hci_cmd_hdr *chdr;
+	struct net_buf *evt;
+	uint16_t opcode;
+
+	chdr = net_buf_pull_mem(buf, sizeof(*chdr));
+	opcode = sys_le16_to_cpu(chdr->opcode);
+
+	switch (opcode) {
+	case BT_HCI_OP_READ_LOCAL_FEATURES: {
+		struct bt_hci_rp_read_local_features *rp;
+
+		evt = cmd_complete(opcode, sizeof(*rp));
+		rp = (void *)(evt->data + evt->len - sizeof(*rp));
+		(void)memset(rp->features, 0xFF, sizeof(rp->features));
+		break;
+	}
+	case BT_HCI_OP_LE_READ_BUFFER_SIZE: {
+		struct bt_hci_rp_le_read_buffer_size *rp;
+
+		evt = cmd_complete(opcode, sizeof(*rp));
+		rp = (void *)(evt->data + evt->len - sizeof(*rp));
+		rp->le_max_len = sys_cpu_to_le16(ACL_MTU);
+		rp->le_max_num = ACL_PKTS;
+		break;
+	}
+	default:
+		evt = cmd_complete(opcode,
+				   sizeof(struct bt_hci_rp_read_supported_commands));
+		break;
+	}
+
+	bt_recv_prio(evt);
+}
+
+static void pdu_complete(void)
+{
+	uint8_t *att = &pdu[BT_L2CAP_HDR_SIZE];
+
+	/* L2CAP header is the PDU length followed by the channel ID */
+	if (sys_get_le16(&pdu[2]) != ATT_CID || att[0] != ATT_OP_NOTIFY) {
+		return;
+	}
+
+	if ((pdu_len != BT_L2CAP_HDR_SIZE + 3 + NTF_LEN) ||
+	    (memcmp(&att[3], ntf_data, NTF_LEN) != 0)) {
+		ntf_invalid = true;
+	}
+
+	if (++ntf_received == N_NOTIFICATIONS) {
+		k_sem_give(&ntf_sem);
+	}
+}
+
+/* Copy the fragment like a controller would, then complete it */
+static void acl_handle(struct net_buf *buf)
+{
+	struct bt_hci_evt_num_completed_packets *ncp;
+	struct bt_hci_acl_hdr *hdr;
+	struct bt_hci_evt_hdr *ehdr;
+	struct net_buf *evt;
+	uint16_t len;
+
+	hdr = net_buf_pull_mem(buf, sizeof(*hdr));
+	len = sys_le16_to_cpu(hdr->len);
+
+	if (bt_acl_flags_pb(bt_acl_flags(sys_le16_to_cpu(hdr->handle))) ==
+	    BT_ACL_START_NO_FLUSH) {
+		pdu_len = 0;
+		pdu_total = sys_get_le16(buf->data) + BT_L2CAP_HDR_SIZE;
+	}
+
+	if ((len != buf->len) || (pdu_len + len > MIN(pdu_total, sizeof(pdu)))) {
+		ntf_invalid = true;
+	} else {
+		memcpy(&pdu[pdu_len], buf->data, len);
+		pdu_len += len;
+
+		if (pdu_len == pdu_total) {
+			pdu_complete();
+		}
+	}
+
+	evt = bt_buf_get_evt(BT_HCI_EVT_NUM_COMPLETED_PACKETS, false, K_FOREVER);
+
+	ehdr = net_buf_add(evt, sizeof(*ehdr));
+	ehdr->evt = BT_HCI_EVT_NUM_COMPLETED_PACKETS;
+	ehdr->len = sizeof(*ncp) + sizeof(ncp->h[0]);
+
+	ncp = net_buf_add(evt, sizeof(*ncp) + sizeof(ncp->h[0]));
+	ncp->num_handles = 1U;
+	ncp->h[0].handle = sys_cpu_to_le16(CONN_HANDLE);
+	ncp->h[0].count = sys_cpu_to_le16(1);
+
+	bt_recv_prio(evt);
+}
+
+static int driver_open(void)
+{
+	return 0;
+}
+
+static int driver_send(struct net_buf *buf)
+{
+	switch (bt_buf_get_type(buf)) {
+	case BT_BUF_CMD:
+		cmd_handle(buf);
+		break;
+	case BT_BUF_ACL_OUT:
+		acl_handle(buf);
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	net_buf_unref(buf);
+
+	return 0;
+}
+
+static struct bt_hci_driver drv = {
+	.name = "bench",
+	.bus = BT_HCI_DRIVER_BUS_VIRTUAL,
+	.open = driver_open,
+	.send = driver_send,
+	.quirks = BT_QUIRK_NO_RESET,
+};
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	if (err == 0) {
+		bench_conn = bt_conn_ref(conn);
+		k_sem_give(&conn_sem);
+	}
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+};
+
+static void peer_connect(void)
+{
+	struct bt_hci_evt_le_conn_complete *cc;
+	struct bt_hci_evt_le_meta_event *meta;
+	struct bt_hci_evt_hdr *hdr;
+	struct net_buf *buf;
+
+	buf = bt_buf_get_evt(BT_HCI_EVT_LE_META_EVENT, false, K_FOREVER);
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->evt = BT_HCI_EVT_LE_META_EVENT;
+	hdr->len = sizeof(*meta) + sizeof(*cc);
+
+	meta = net_buf_add(buf, sizeof(*meta));
+	meta->subevent = BT_HCI_EVT_LE_CONN_COMPLETE;
+
+	cc = net_buf_add(buf, sizeof(*cc));
+	(void)memset(cc, 0, sizeof(*cc));
+	cc->handle = sys_cpu_to_le16(CONN_HANDLE);
+	cc->role = BT_HCI_ROLE_PERIPHERAL;
+	cc->peer_addr.type = BT_ADDR_LE_PUBLIC;
+	(void)memset(cc->peer_addr.a.val, 0x11, sizeof(cc->peer_addr.a.val));
+	cc->interval = sys_cpu_to_le16(6);
+	cc->supv_timeout = sys_cpu_to_le16(400);
+
+	bt_recv(buf);
+}
+
+static void peer_mtu_req(void)
+{
+	struct bt_hci_acl_hdr *hdr;
+	struct net_buf *buf;
+	uint8_t *l2cap;
+
+	buf = bt_buf_get_rx(BT_BUF_ACL_IN, K_FOREVER);
+
+	hdr = net_buf_add(buf, sizeof(*hdr));
+	hdr->handle = sys_cpu_to_le16(bt_acl_handle_pack(CONN_HANDLE,
+							  BT_ACL_START));
+	hdr->len = sys_cpu_to_le16(BT_L2CAP_HDR_SIZE + 3);
+
+	l2cap = net_buf_add(buf, BT_L2CAP_HDR_SIZE + 3);
+	sys_put_le16(3, &l2cap[0]);
+	sys_put_le16(ATT_CID, &l2cap[2]);
+	l2cap[4] = ATT_OP_MTU_REQ;
+	sys_put_le16(ATT_MTU, &l2cap[5]);
+
+	bt_recv(buf);
+}
+
+static int setup(void)
+{
+	int rc;
+
+	bt_hci_driver_register(&drv);
+
+	rc = bt_enable(NULL);
+	if (rc == 0) {
+		rc = bt_le_adv_start(BT_LE_ADV_CONN, NULL, 0, NULL, 0);
+	}
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	peer_connect();
+	if (k_sem_take(&conn_sem, K_SECONDS(1)) != 0) {
+		return -ENOTCONN;
+	}
+
+	peer_mtu_req();
+	for (int i = 0; bt_gatt_get_mtu(bench_conn) != ATT_MTU; i++) {
+		if (i == 100) {
+			return -EIO;
+		}
+		k_sleep(K_MSEC(10));
+	}
+
+	for (int i = 0; i < sizeof(ntf_data); i++) {
+		ntf_data[i] = (uint8_t)i;
+	}
+
+	return 0;
+}
+
+static int bench(const char *name, bool in_place)
+{
+	uint32_t start, cycles;
+	uint64_t us;
+	int rc = 0;
+
+	if (in_place) {
+		drv.quirks |= BT_QUIRK_TX_DATA_COPIED;
+	} else {
+		drv.quirks &= ~BT_QUIRK_TX_DATA_COPIED;
+	}
+
+	ntf_received = 0U;
+	ntf_invalid = false;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; (rc == 0) && (i < N_NOTIFICATIONS); i++) {
+		rc = bt_gatt_notify(bench_conn, &attr_bench_svc[1], ntf_data,
+				    sizeof(ntf_data));
+	}
+
+	if ((rc == 0) && (k_sem_take(&ntf_sem, K_SECONDS(10)) != 0)) {
+		rc = -ETIMEDOUT;
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	/* Guard against a zero duration on a simulated clock */
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	if ((rc != 0) || ntf_invalid) {
+		printk("%s failed (%d)\n", name, rc);
+		return -EIO;
+	}
+
+	printk("%-8s %u KiB/s\n", name,
+	       (uint32_t)((uint64_t)N_NOTIFICATIONS * NTF_LEN * USEC_PER_SEC /
+			  1024U / us));
+
+	return 0;
+}
+
+void main(void)
+{
+	int rc = setup();
+
+	if (rc != 0) {
+		printk("setup failed (%d)\n", rc);
+		return;
+	}
+
+	if ((bench("copy", false) != 0) || (bench("in place", true) != 0)) {
+		return;
+	}
+
+	printk("fin\n");
+}
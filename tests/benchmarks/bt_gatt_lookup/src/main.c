@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/gatt.h>
+
+/* GATT attribute lookup benchmark. A large database of static and dynamic
+ * services is set up, then every characteristic value is read by handle the
+ * way the ATT server handles a Read Request: bt_gatt_foreach_attr() with the
+ * same start and end handle, then the read callback of the attribute.
+ * Without CONFIG_BT_GATT_ATTR_INDEX the lookup walks all the services before
+ * the handle.
+ */
+
+#define N_STATIC_SVCS 8
+#define N_DYN_SVCS 16
+#define N_ROUNDS 200
+
+static uint8_t value[4];
+
+static ssize_t read_value(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			  void *buf, uint16_t len, uint16_t offset)
+{
+	return bt_gatt_attr_read(conn, attr, buf, len, offset, value,
+				 sizeof(value));
+}
+
+#define CHRC(i, base)							\
+	BT_GATT_CHARACTERISTIC(BT_UUID_DECLARE_16((base) + (i)),	\
+			       BT_GATT_CHRC_READ, BT_GATT_PERM_READ,	\
+			       read_value, NULL, NULL)
+
+#define SVC_ATTRS(n)							\
+	BT_GATT_PRIMARY_SERVICE(BT_UUID_DECLARE_16(0xfd00 + (n))),	\
+	LISTIFY(4, CHRC, (,), 0xfe00 + 4 * (n))
+
+#define STATIC_SVC(n, _) BT_GATT_SERVICE_DEFINE(static_svc_##n, SVC_ATTRS(n))
+
+LISTIFY(N_STATIC_SVCS, STATIC_SVC, (;), _);
+
+#define DYN_ATTRS(n, _)							\
+	static struct bt_gatt_attr dyn_attrs_##n[] = {			\
+		SVC_ATTRS(N_STATIC_SVCS + (n))				\
+	}
+
+LISTIFY(N_DYN_SVCS, DYN_ATTRS, (;), _);
+
+#define DYN_SVC(n, _) BT_GATT_SERVICE(dyn_attrs_##n)
+
+static struct bt_gatt_service dyn_svcs[] = {
+	LISTIFY(N_DYN_SVCS, DYN_SVC, (,), _)
+};
+
+struct read_data {
+	uint8_t buf[sizeof(value)];
+	uint32_t reads;
+};
+
+static uint8_t read_cb(const struct bt_gatt_attr *attr, uint16_t handle,
+		       void *user_data)
+{
+	struct read_data *data = user_data;
+
+	if (attr->read == read_value) {
+		if (attr->read(NULL, attr, data->buf, sizeof(data->buf), 0) > 0) {
+			data->reads++;
+		}
+	}
+
+	return BT_GATT_ITER_STOP;
+}
+
+static int bench(const char *name, uint16_t start_handle, uint16_t end_handle)
+{
+	struct read_data data = { 0 };
+	uint32_t start, cycles;
+	uint64_t us;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_ROUNDS; i++) {
+		for (uint16_t handle = start_handle; handle <= end_handle;
+		     handle++) {
+			bt_gatt_foreach_attr(handle, handle, read_cb, &data);
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	/* Guard against a zero duration on a simulated clock */
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	if (data.reads == 0) {
+		printk("%s no attribute read\n", name);
+		return -ENOENT;
+	}
+
+	printk("%-8s %u ops/s\n", name,
+	       (uint32_t)((uint64_t)data.reads * USEC_PER_SEC / us));
+
+	return 0;
+}
+
+void main(void)
+{
+	uint16_t first_dyn, last_dyn;
+	int err;
+
+	for (int i = 0; i < ARRAY_SIZE(dyn_svcs); i++) {
+		err = bt_gatt_service_register(&dyn_svcs[i]);
+		if (err) {
+			printk("service registration failed (%d)\n", err);
+			return;
+		}
+	}
+
+	first_dyn = dyn_svcs[0].attrs[0].handle;
+	last_dyn = first_dyn + N_DYN_SVCS * ARRAY_SIZE(dyn_attrs_0) - 1;
+
+	if ((bench("static", 1, first_dyn - 1) != 0) ||
+	    (bench("dynamic", first_dyn, last_dyn) != 0)) {
+		return;
+	}
+
+	printk("fin\n");
+}
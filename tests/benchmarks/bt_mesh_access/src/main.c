@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "mesh/net.h"
+#include "mesh/access.h"
+
+/* Access layer dispatch benchmark. A composition of several elements, each
+ * hosting the same vendor models with a handful of opcodes each, is
+ * registered and given access messages directly:
+ * - first: the first opcode of the first model of the primary element,
+ * - last: the last opcode of the last model of the last element,
+ * - all: every opcode of every element in turn,
+ * - unknown: a vendor opcode no model handles.
+ * With CONFIG_BT_MESH_ACCESS_OP_TABLE_SIZE large enough, the handler is
+ * looked up in the opcode table instead of walking the composition.
+ */
+
+#define ELEM_ADDR 0x0001
+#define CID_BASE 0x1000
+#define N_ELEMS 4
+#define N_MODELS 8
+#define N_OPS 8
+#define N_LOOPS 4096
+
+static uint32_t handled;
+
+static int vnd_handler(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		       struct net_buf_simple *buf)
+{
+	handled++;
+
+	return 0;
+}
+
+#define VND_OP(i, m) { BT_MESH_MODEL_OP_3(i, CID_BASE + m), BT_MESH_LEN_MIN(0), \
+		       vnd_handler }
+#define MODEL_OPS(m)                                                            \
+	static const struct bt_mesh_model_op ops_##m[] = {                      \
+		LISTIFY(N_OPS, VND_OP, (,), m),                                 \
+		BT_MESH_MODEL_OP_END,                                           \
+	}
+
+MODEL_OPS(0);
+MODEL_OPS(1);
+MODEL_OPS(2);
+MODEL_OPS(3);
+MODEL_OPS(4);
+MODEL_OPS(5);
+MODEL_OPS(6);
+MODEL_OPS(7);
+
+#define VND_MODEL(m, _) BT_MESH_MODEL_VND(CID_BASE + m, m, ops_##m, NULL, NULL)
+#define ELEM_MODELS { LISTIFY(N_MODELS, VND_MODEL, (,)) }
+
+static struct bt_mesh_model vnd_models[N_ELEMS][N_MODELS] = {
+	ELEM_MODELS, ELEM_MODELS, ELEM_MODELS, ELEM_MODELS,
+};
+
+static struct bt_mesh_elem elements[N_ELEMS] = {
+	BT_MESH_ELEM(0, BT_MESH_MODEL_NONE, vnd_models[0]),
+	BT_MESH_ELEM(0, BT_MESH_MODEL_NONE, vnd_models[1]),
+	BT_MESH_ELEM(0, BT_MESH_MODEL_NONE, vnd_models[2]),
+	BT_MESH_ELEM(0, BT_MESH_MODEL_NONE, vnd_models[3]),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = BT_COMP_ID_LF,
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static int setup(void)
+{
+	int err;
+
+	err = bt_mesh_comp_register(&comp);
+	if (err) {
+		return err;
+	}
+
+	bt_mesh_comp_provision(ELEM_ADDR);
+
+	/* Bind every model to the AppKey the messages are sent with */
+	for (int e = 0; e < N_ELEMS; e++) {
+		for (int m = 0; m < N_MODELS; m++) {
+			vnd_models[e][m].keys[0] = 0;
+		}
+	}
+
+	return 0;
+}
+
+static void deliver(uint8_t elem, uint8_t op, uint16_t cid)
+{
+	struct bt_mesh_net_rx rx = {
+		.ctx = {
+			.app_idx = 0,
+			.addr = 0x0100,
+			.recv_dst = ELEM_ADDR + elem,
+		},
+	};
+	uint8_t data[3] = { 0xc0 | op, cid & 0xff, cid >> 8 };
+	struct net_buf_simple buf;
+
+	net_buf_simple_init_with_data(&buf, data, sizeof(data));
+	bt_mesh_model_recv(&rx, &buf);
+}
+
+static int bench(const char *name, uint32_t expect, void (*send)(int i))
+{
+	uint32_t start, cycles;
+	uint64_t us;
+
+	handled = 0;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_LOOPS; i++) {
+		send(i);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	/* Guard against a zero duration on a simulated clock */
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	if (handled != expect) {
+		printk("%s handled %u messages, expected %u\n", name, handled,
+		       expect);
+		return -EIO;
+	}
+
+	printk("%-7s %u msg/s\n", name,
+	       (uint32_t)((uint64_t)N_LOOPS * USEC_PER_SEC / us));
+
+	return 0;
+}
+
+static void send_first(int i)
+{
+	deliver(0, 0, CID_BASE);
+}
+
+static void send_last(int i)
+{
+	deliver(N_ELEMS - 1, N_OPS - 1, CID_BASE + N_MODELS - 1);
+}
+
+static void send_all(int i)
+{
+	deliver((i / (N_MODELS * N_OPS)) % N_ELEMS, i % N_OPS,
+	     CID_BASE + (i / N_OPS) % N_MODELS);
+}
+
+static void send_unknown(int i)
+{
+	deliver(i % N_ELEMS, 0, CID_BASE + N_MODELS);
+}
+
+void main(void)
+{
+	int err = setup();
+
+	if (err) {
+		printk("setup failed (%d)\n", err);
+		return;
+	}
+
+	if (bench("first", N_LOOPS, send_first) ||
+	    bench("last", N_LOOPS, send_last) ||
+	    bench("all", N_LOOPS, send_all) ||
+	    bench("unknown", 0, send_unknown)) {
+		return;
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/sys/byteorder.h>
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/buf.h>
+#include <zephyr/bluetooth/hci.h>
+#include <zephyr/bluetooth/mesh.h>
+#include <zephyr/drivers/bluetooth/hci_driver.h>
+
+#include "mesh/net.h"
+#include "mesh/subnet.h"
+
+/* Mesh network PDU receive benchmark. A test HCI driver accepts every
+ * command so the node can be provisioned locally. Network PDUs addressed to
+ * the node are then encrypted on behalf of as many sources as the Replay
+ * Protection List holds, and given to bt_mesh_net_recv() the way the
+ * advertising bearer does:
+ * - new: every PDU is decrypted, added to the caches and checked against
+ *   the RPL,
+ * - relayed: the last PDUs sent again with another TTL, dropped by the
+ *   Network Message Cache,
+ * - duplicate: the last PDUs received again unchanged, dropped by the
+ *   duplicate cache.
+ * The node is added to CONFIG_BT_MESH_SUBNET_COUNT subnets, and the PDUs are
+ * sent on the last one.
+ */
+
+#define LOCAL_ADDR 0x0001
+#define NET_IDX (CONFIG_BT_MESH_SUBNET_COUNT - 1)
+#define SRC_BASE 0x0100
+#define N_SRCS CONFIG_BT_MESH_CRPL
+#define N_ROUNDS 4
+#define N_PDUS (N_SRCS * N_ROUNDS)
+#define N_CACHED MIN(CONFIG_BT_MESH_MSG_CACHE_SIZE, N_PDUS)
+#define PAYLOAD_LEN 9
+
+struct pdu {
+	uint8_t len;
+	uint8_t data[BT_MESH_NET_MAX_PDU_LEN];
+};
+
+static struct pdu pdus[N_PDUS];
+static struct pdu relayed[N_CACHED];
+static uint32_t seqs[N_PDUS];
+
+static const uint8_t net_key[16] = { 0x01 };
+static const uint8_t dev_key[16] = { 0x02 };
+static const uint8_t dev_uuid[16] = { 0xdd, 0xdd };
+
+static struct bt_mesh_cfg_srv cfg_srv;
+
+static struct bt_mesh_model root_models[] = {
+	BT_MESH_MODEL_CFG_SRV(&cfg_srv),
+};
+
+static struct bt_mesh_elem elements[] = {
+	BT_MESH_ELEM(0, root_models, BT_MESH_MODEL_NONE),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = BT_COMP_ID_LF,
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static const struct bt_mesh_prov prov = {
+	.uuid = dev_uuid,
+};
+
+/* Every command succeeds, return parameters not set here are zero */
+static int driver_send(struct net_buf *buf)
+{
+	struct bt_hci_evt_cmd_complete *cc;
+	struct bt_hci_rp_read_local_features *rp;
+	struct bt_hci_cmd_hdr *chdr;
+	struct bt_hci_evt_hdr *hdr;
+	struct net_buf *evt;
+	uint8_t plen = sizeof(struct bt_hci_rp_read_supported_commands);
+	uint16_t opcode;
+
+	if (bt_buf_get_type(buf) != BT_BUF_CMD) {
+		return -EINVAL;
+	}
+
+	chdr = net_buf_pull_mem(buf, sizeof(*chdr));
+	opcode = sys_le16_to_cpu(chdr->opcode);
+	net_buf_unref(buf);
+
+	evt = bt_buf_get_evt(BT_HCI_EVT_CMD_COMPLETE, false, K_FOREVER);
+
+	hdr = net_buf_add(evt, sizeof(*hdr));
+	hdr->evt = BT_HCI_EVT_CMD_COMPLETE;
+	hdr->len = sizeof(*cc) + plen;
+
+	cc = net_buf_add(evt, sizeof(*cc));
+	cc->ncmd = 1U;
+	cc->opcode = sys_cpu_to_le16(opcode);
+
+	rp = net_buf_add(evt, plen);
+	(void)memset(rp, 0, plen);
+
+	if (opcode == BT_HCI_OP_READ_LOCAL_FEATURES) {
+		(void)memset(rp->features, 0xFF, sizeof(rp->features));
+	}
+
+	bt_recv_prio(evt);
+
+	return 0;
+}
+
+static int driver_open(void)
+{
+	return 0;
+}
+
+static const struct bt_hci_driver drv = {
+	.name = "bench",
+	.bus = BT_HCI_DRIVER_BUS_VIRTUAL,
+	.open = driver_open,
+	.send = driver_send,
+	.quirks = BT_QUIRK_NO_RESET,
+};
+
+static int encode(struct pdu *pdu, uint16_t src, uint8_t ttl)
+{
+	struct bt_mesh_msg_ctx ctx = {
+		.net_idx = NET_IDX,
+		.app_idx = BT_MESH_KEY_DEV,
+		.addr = LOCAL_ADDR,
+		.send_ttl = ttl,
+	};
+	struct bt_mesh_net_tx tx = {
+		.sub = bt_mesh_subnet_get(NET_IDX),
+		.ctx = &ctx,
+		.src = src,
+	};
+	struct net_buf_simple buf;
+	int err;
+
+	net_buf_simple_init_with_data(&buf, pdu->data, sizeof(pdu->data));
+	net_buf_simple_reset(&buf);
+	net_buf_simple_reserve(&buf, BT_MESH_NET_HDR_LEN);
+
+	/* Unsegmented access message with device key, zero payload */
+	(void)memset(net_buf_simple_add(&buf, PAYLOAD_LEN), 0, PAYLOAD_LEN);
+
+	err = bt_mesh_net_encode(&tx, &buf, false);
+	pdu->len = buf.len;
+
+	/* Move the PDU to the start of the storage */
+	memmove(pdu->data, buf.data, buf.len);
+
+	return err;
+}
+
+static int setup(void)
+{
+	int err;
+
+	bt_hci_driver_register(&drv);
+
+	err = bt_enable(NULL);
+	if (!err) {
+		err = bt_mesh_init(&prov, &comp);
+	}
+
+	if (!err) {
+		err = bt_mesh_provision(net_key, 0, 0, 0, LOCAL_ADDR, dev_key);
+	}
+
+	for (uint16_t i = 1; !err && i <= NET_IDX; i++) {
+		uint8_t key[16] = { 0x01, i, i >> 8 };
+
+		/* Returns a Config Server status code */
+		if (bt_mesh_subnet_add(i, key)) {
+			err = -ENOMEM;
+		}
+	}
+
+	/* Sources take turns so every PDU of a round is new to the caches */
+	for (int i = 0; !err && i < N_PDUS; i++) {
+		seqs[i] = bt_mesh.seq;
+		err = encode(&pdus[i], SRC_BASE + i % N_SRCS, 5);
+	}
+
+	/* The seq is unchanged so the Network Message Cache still has them */
+	for (int i = 0; !err && i < N_CACHED; i++) {
+		int j = N_PDUS - N_CACHED + i;
+
+		bt_mesh.seq = seqs[j];
+		err = encode(&relayed[i], SRC_BASE + j % N_SRCS, 4);
+	}
+
+	return err;
+}
+
+static void bench(const char *name, struct pdu *list, int count)
+{
+	struct net_buf_simple buf;
+	uint32_t start, cycles;
+	uint64_t us;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < count; i++) {
+		net_buf_simple_init_with_data(&buf, list[i].data, list[i].len);
+		bt_mesh_net_recv(&buf, 0, BT_MESH_NET_IF_ADV);
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	/* Guard against a zero duration on a simulated clock */
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	printk("%-9s %u pkt/s\n", name,
+	       (uint32_t)((uint64_t)count * USEC_PER_SEC / us));
+}
+
+void main(void)
+{
+	int err = setup();
+
+	if (err) {
+		printk("setup failed (%d)\n", err);
+		return;
+	}
+
+	printk("cache sizes: RPL %u, network message %u, subnets %u\n",
+	       CONFIG_BT_MESH_CRPL, CONFIG_BT_MESH_MSG_CACHE_SIZE,
+	       CONFIG_BT_MESH_SUBNET_COUNT);
+
+	bench("new", pdus, N_PDUS);
+	bench("relayed", relayed, N_CACHED);
+	bench("duplicate", &pdus[N_PDUS - N_CACHED], N_CACHED);
+
+	printk("fin\n");
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/dfu/flash_img.h>
+#include <zephyr/storage/flash_map.h>
+
+/* Firmware download benchmark. An image is received in fixed size packets,
+ * each one taking NET_DELAY_MS to arrive, and passed to the flash image
+ * writer. The flash simulator adds erase and write latencies. Without
+ * CONFIG_IMG_BACKGROUND_WRITE the download takes the network time plus the
+ * flash time, with it the two overlap. With CONFIG_STREAM_FLASH_PRE_ERASE
+ * the image slot is erased ahead of the writes from a low priority thread.
+ */
+
+#define IMAGE_SIZE (60 * 1024)
+#define PACKET_SIZE 1024
+#define NET_DELAY_MS 2
+
+static uint8_t packet[PACKET_SIZE];
+static struct flash_img_context ctx;
+
+static void receive(size_t off)
+{
+	k_sleep(K_MSEC(NET_DELAY_MS));
+
+	for (int i = 0; i < sizeof(packet); i++) {
+		packet[i] = (uint8_t)(off + i);
+	}
+}
+
+static int download(bool write)
+{
+	int rc = 0;
+
+	for (size_t off = 0; (rc == 0) && (off < IMAGE_SIZE);
+	     off += sizeof(packet)) {
+		receive(off);
+		if (write) {
+			rc = flash_img_buffered_write(&ctx, packet,
+						      sizeof(packet), false);
+		}
+	}
+
+	if ((rc == 0) && write) {
+		rc = flash_img_buffered_write(&ctx, NULL, 0, true);
+	}
+
+	return rc;
+}
+
+static int verify(void)
+{
+	const struct flash_area *fap;
+	uint8_t buf[64];
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(image_1), &fap);
+	if (rc != 0) {
+		return rc;
+	}
+
+	for (size_t off = 0; (rc == 0) && (off < IMAGE_SIZE);
+	     off += sizeof(buf)) {
+		rc = flash_area_read(fap, off, buf, sizeof(buf));
+		for (int i = 0; (rc == 0) && (i < sizeof(buf)); i++) {
+			rc = (buf[i] == (uint8_t)(off + i)) ? 0 : -EIO;
+		}
+	}
+
+	flash_area_close(fap);
+
+	return rc;
+}
+
+static uint32_t timed(bool write, int *rc)
+{
+	uint32_t start = k_cycle_get_32();
+
+	*rc = download(write);
+
+	return k_cyc_to_ms_floor32(k_cycle_get_32() - start);
+}
+
+void main(void)
+{
+	uint32_t net_ms, dfu_ms;
+	int rc;
+
+	net_ms = timed(false, &rc);
+
+	rc = flash_img_init(&ctx);
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+	if (rc == 0) {
+		rc = flash_img_pre_erase_start(&ctx);
+	}
+#endif
+	if (rc == 0) {
+		dfu_ms = MAX(timed(true, &rc), 1);
+	}
+
+	if (rc == 0) {
+		rc = verify();
+	}
+
+	if (rc != 0) {
+		printk("download failed (%d)\n", rc);
+		return;
+	}
+
+	printk("network %u ms\n", net_ms);
+	printk("dfu     %u ms, %u KiB/s\n", dfu_ms,
+	       (uint32_t)((uint64_t)IMAGE_SIZE * MSEC_PER_SEC / 1024U / dfu_ms));
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+	struct stream_flash_pre_erase_stats stats;
+
+	(void)flash_img_pre_erase_stats_get(&ctx, &stats);
+	printk("erase   %zu of %zu bytes ahead, %u hits, %u misses\n",
+	       stats.erased, stats.total, stats.hits, stats.misses);
+#endif
+	printk("fin\n");
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/storage/disk_access.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_concurrent.h>
+
+/* Disk access throughput benchmark. The same region of the RAM disk is
+ * written and read one sector per request, first with blocking
+ * disk_access_write/read() calls, then by queueing a batch of requests on
+ * the RTIO device of the disk and waiting for all of their completions.
+ * Queued requests for adjacent sectors are merged by the disk RTIO device,
+ * the no_merge variant shows the cost of queueing alone.
+ */
+
+#define DISK_NAME CONFIG_DISK_RAM_VOLUME_NAME
+#define SECTOR_SIZE 512
+#define N_SECTORS 128
+#define BATCH CONFIG_DISK_ACCESS_RTIO_QUEUE_SIZE
+#define N_RUNS 8
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(bench_exec, BATCH);
+/* Twice the batch, the executor looks up new submissions from the last one */
+RTIO_DEFINE(bench_rtio, (struct rtio_executor *)&bench_exec, 2 * BATCH, BATCH);
+
+static uint8_t buf[N_SECTORS * SECTOR_SIZE] __aligned(4);
+
+static int run_sync(bool write)
+{
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < N_SECTORS); i++) {
+		if (write) {
+			rc = disk_access_write(DISK_NAME, &buf[i * SECTOR_SIZE],
+					       i, 1);
+		} else {
+			rc = disk_access_read(DISK_NAME, &buf[i * SECTOR_SIZE],
+					      i, 1);
+		}
+	}
+
+	return rc;
+}
+
+static int run_rtio(struct rtio_iodev *iodev, bool write)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < N_SECTORS); i += BATCH) {
+		for (int j = 0; j < BATCH; j++) {
+			sqe = rtio_spsc_acquire(bench_rtio.sq);
+			if (write) {
+				disk_access_rtio_prep_write(sqe, iodev,
+					&buf[(i + j) * SECTOR_SIZE], i + j,
+					SECTOR_SIZE, NULL);
+			} else {
+				disk_access_rtio_prep_read(sqe, iodev,
+					&buf[(i + j) * SECTOR_SIZE], i + j,
+					SECTOR_SIZE, NULL);
+			}
+		}
+
+		rc = rtio_submit(&bench_rtio, BATCH);
+
+		for (int j = 0; j < BATCH; j++) {
+			cqe = rtio_cqe_consume(&bench_rtio);
+			if ((cqe == NULL) || (cqe->result != 0)) {
+				rc = -EIO;
+			}
+			rtio_spsc_release(bench_rtio.cq);
+		}
+	}
+
+	return rc;
+}
+
+static int bench(const char *name, struct rtio_iodev *iodev, bool write)
+{
+	uint32_t start, cycles;
+	uint64_t us = 0;
+	int rc;
+
+	for (int i = 0; i < N_RUNS; i++) {
+		start = k_cycle_get_32();
+		if (iodev == NULL) {
+			rc = run_sync(write);
+		} else {
+			rc = run_rtio(iodev, write);
+		}
+		cycles = k_cycle_get_32() - start;
+
+		if (rc != 0) {
+			printk("%s %s failed (%d)\n", name,
+			       write ? "write" : "read", rc);
+			return rc;
+		}
+
+		us += k_cyc_to_us_floor64(cycles);
+	}
+
+	/* Guard against a zero duration on a simulated clock */
+	us = MAX(us, 1);
+
+	printk("%s %s %u KiB/s\n", name, write ? "write" : "read ",
+	       (uint32_t)((uint64_t)N_RUNS * sizeof(buf) * USEC_PER_SEC /
+			  1024U / us));
+
+	return 0;
+}
+
+void main(void)
+{
+	struct rtio_iodev *iodev;
+	int rc;
+
+	rc = disk_access_init(DISK_NAME);
+	if (rc != 0) {
+		printk("disk init failed (%d)\n", rc);
+		return;
+	}
+
+	iodev = disk_access_rtio_iodev(DISK_NAME);
+	if (iodev == NULL) {
+		printk("disk has no RTIO device\n");
+		return;
+	}
+
+	for (int i = 0; i < sizeof(buf); i++) {
+		buf[i] = (uint8_t)i;
+	}
+
+	if ((bench("sync", NULL, true) != 0) ||
+	    (bench("rtio", iodev, true) != 0) ||
+	    (bench("sync", NULL, false) != 0) ||
+	    (bench("rtio", iodev, false) != 0)) {
+		return;
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,160 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/fs/fcb.h>
+#include <zephyr/storage/flash_map.h>
+
+/* FCB append throughput benchmark. Small log records are appended one at a
+ * time with fcb_append(), flash_area_write() and fcb_append_finish(), which
+ * program the length, the data and the checksum separately and read the data
+ * back to compute the checksum. Then the same records are packed in a batch
+ * with fcb_batch_add() and written with a single flash write per commit. The
+ * flash simulator charges a fixed time per write call.
+ */
+
+#define SECTOR_SIZE 4096
+#define SECTOR_COUNT 8
+#define RECORD_SIZE 16
+#define N_RECORDS 1024
+#define BATCH_SIZE 512
+
+static struct flash_sector sectors[SECTOR_COUNT];
+static struct fcb fcb;
+
+static uint8_t record[RECORD_SIZE];
+static uint8_t batch_buf[BATCH_SIZE];
+
+static int setup(void)
+{
+	const struct flash_area *fap;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(image_1), &fap);
+	if (rc == 0) {
+		rc = flash_area_erase(fap, 0, SECTOR_COUNT * SECTOR_SIZE);
+		flash_area_close(fap);
+	}
+
+	if (rc != 0) {
+		return rc;
+	}
+
+	for (int i = 0; i < SECTOR_COUNT; i++) {
+		sectors[i].fs_off = i * SECTOR_SIZE;
+		sectors[i].fs_size = SECTOR_SIZE;
+	}
+
+	fcb.f_magic = 0x46434221;
+	fcb.f_sectors = sectors;
+	fcb.f_sector_cnt = SECTOR_COUNT;
+
+	return fcb_init(FLASH_AREA_ID(image_1), &fcb);
+}
+
+static int append_single(void)
+{
+	struct fcb_entry loc;
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < N_RECORDS); i++) {
+		record[0] = (uint8_t)i;
+
+		rc = fcb_append(&fcb, sizeof(record), &loc);
+		if (rc == 0) {
+			rc = flash_area_write(fcb.fap, FCB_ENTRY_FA_DATA_OFF(loc),
+					      record, sizeof(record));
+		}
+		if (rc == 0) {
+			rc = fcb_append_finish(&fcb, &loc);
+		}
+	}
+
+	return rc;
+}
+
+static int append_batch(void)
+{
+	struct fcb_batch batch;
+	int rc = 0;
+
+	fcb_batch_init(&batch, batch_buf, sizeof(batch_buf));
+
+	for (int i = 0; (rc == 0) && (i < N_RECORDS); i++) {
+		record[0] = (uint8_t)i;
+
+		rc = fcb_batch_add(&fcb, &batch, record, sizeof(record));
+		if (rc == -ENOMEM) {
+			rc = fcb_batch_commit(&fcb, &batch);
+			if (rc == 0) {
+				rc = fcb_batch_add(&fcb, &batch, record,
+						   sizeof(record));
+			}
+		}
+	}
+
+	if (rc == 0) {
+		rc = fcb_batch_commit(&fcb, &batch);
+	}
+
+	return rc;
+}
+
+static int count_cb(struct fcb_entry_ctx *loc_ctx, void *arg)
+{
+	(*(int *)arg)++;
+	return 0;
+}
+
+static int bench(const char *name, int (*append)(void))
+{
+	uint32_t start;
+	uint64_t us;
+	int count = 0;
+	int rc;
+
+	rc = fcb_clear(&fcb);
+	if (rc != 0) {
+		printk("%s clear failed (%d)\n", name, rc);
+		return rc;
+	}
+
+	start = k_cycle_get_32();
+	rc = append();
+	us = MAX(k_cyc_to_us_floor64(k_cycle_get_32() - start), 1);
+
+	if (rc == 0) {
+		rc = fcb_walk(&fcb, NULL, count_cb, &count);
+	}
+
+	if ((rc != 0) || (count != N_RECORDS)) {
+		printk("%s failed (%d), %d records\n", name, rc, count);
+		return -EIO;
+	}
+
+	printk("%-6s %u records/s\n", name,
+	       (uint32_t)((uint64_t)N_RECORDS * USEC_PER_SEC / us));
+
+	return 0;
+}
+
+void main(void)
+{
+	int rc = setup();
+
+	if (rc != 0) {
+		printk("setup failed (%d)\n", rc);
+		return;
+	}
+
+	if ((bench("single", append_single) != 0) ||
+	    (bench("batch", append_batch) != 0)) {
+		return;
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/storage/flash_map.h>
+
+/* File system path operation benchmark. Three littlefs volumes are mounted,
+ * a few small files are created on the last one, then open/close and stat
+ * loops run over them. Every operation resolves its path to a mount point
+ * first, and stat may be answered by CONFIG_FS_STAT_CACHE.
+ */
+
+#define N_FILES 4
+#define N_LOOPS 256
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_a);
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_b);
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(lfs_c);
+
+static struct fs_mount_t mounts[] = {
+	{
+		.type = FS_LITTLEFS,
+		.fs_data = &lfs_a,
+		.storage_dev = (void *)FLASH_AREA_ID(eeprom_emu),
+		.mnt_point = "/cfg",
+	},
+	{
+		.type = FS_LITTLEFS,
+		.fs_data = &lfs_b,
+		.storage_dev = (void *)FLASH_AREA_ID(image_1),
+		.mnt_point = "/data",
+	},
+	{
+		.type = FS_LITTLEFS,
+		.fs_data = &lfs_c,
+		.storage_dev = (void *)FLASH_AREA_ID(storage),
+		.mnt_point = "/lfs",
+	},
+};
+
+static char paths[N_FILES][16];
+
+static int setup(void)
+{
+	const struct flash_area *fap;
+	struct fs_file_t file;
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < ARRAY_SIZE(mounts)); i++) {
+		rc = flash_area_open((uintptr_t)mounts[i].storage_dev, &fap);
+		if (rc == 0) {
+			rc = flash_area_erase(fap, 0, fap->fa_size);
+			flash_area_close(fap);
+		}
+
+		if (rc == 0) {
+			rc = fs_mount(&mounts[i]);
+		}
+	}
+
+	for (int i = 0; (rc == 0) && (i < N_FILES); i++) {
+		snprintk(paths[i], sizeof(paths[i]), "/lfs/f%d", i);
+
+		fs_file_t_init(&file);
+		rc = fs_open(&file, paths[i], FS_O_CREATE | FS_O_WRITE);
+		if (rc == 0) {
+			rc = (fs_write(&file, paths[i], 8) == 8) ? 0 : -EIO;
+			(void)fs_close(&file);
+		}
+	}
+
+	return rc;
+}
+
+static int open_close(int i)
+{
+	struct fs_file_t file;
+	int rc;
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, paths[i % N_FILES], FS_O_READ);
+	if (rc == 0) {
+		rc = fs_close(&file);
+	}
+
+	return rc;
+}
+
+static int stat_file(int i)
+{
+	struct fs_dirent entry;
+
+	return fs_stat(paths[i % N_FILES], &entry);
+}
+
+static int stat_missing(int i)
+{
+	struct fs_dirent entry;
+	int rc = fs_stat("/lfs/missing", &entry);
+
+	return (rc == -ENOENT) ? 0 : -EIO;
+}
+
+static int bench(const char *name, int (*op)(int i))
+{
+	uint32_t start = k_cycle_get_32();
+	uint64_t us;
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < N_LOOPS); i++) {
+		rc = op(i);
+	}
+
+	us = MAX(k_cyc_to_us_floor64(k_cycle_get_32() - start), 1);
+
+	if (rc != 0) {
+		printk("%s failed (%d)\n", name, rc);
+		return rc;
+	}
+
+	printk("%-13s %u ops/s\n", name,
+	       (uint32_t)((uint64_t)N_LOOPS * USEC_PER_SEC / us));
+
+	return 0;
+}
+
+void main(void)
+{
+	int rc = setup();
+
+	if (rc != 0) {
+		printk("setup failed (%d)\n", rc);
+		return;
+	}
+
+	if ((bench("open/close", open_close) != 0) ||
+	    (bench("stat", stat_file) != 0) ||
+	    (bench("stat missing", stat_missing) != 0)) {
+		return;
+	}
+
+	printk("fin\n");
+}
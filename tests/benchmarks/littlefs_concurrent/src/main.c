@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/fs/fs.h>
+#include <zephyr/fs/littlefs.h>
+#include <zephyr/storage/flash_map.h>
+
+/* littlefs concurrency benchmark, in two phases on the same volume:
+ * - write: a low priority writer thread repeatedly rewrites a log file in
+ *   large writes, while a higher priority reader thread periodically stats,
+ *   opens and reads a small asset file. The reader latency shows how long
+ *   it waits behind the writer, which with CONFIG_FS_LITTLEFS_FILE_LOCK is
+ *   bounded by a chunk instead of a whole write.
+ * - sync: the writer appends a few bytes to the log file and syncs it, and
+ *   a timer wakes the reader while the sync is in progress to do a stat or
+ *   a readdir of the volume. As every littlefs call holds the volume lock,
+ *   these wait for the sync to end in both locking modes.
+ * Flash timing is simulated so that programming and erasing take time.
+ */
+
+#define MNT_POINT "/lfs"
+#define LOG_PATH MNT_POINT "/log"
+#define ASSET_PATH MNT_POINT "/asset"
+
+#define WRITE_SIZE 4096
+#define WRITES_PER_ROUND 4
+#define N_ROUNDS 8
+#define ASSET_SIZE 256
+#define READ_PERIOD_MS 2
+#define N_SYNCS 256
+#define SYNC_WRITE_SIZE 16
+#define PROBE_DELAY_US 50
+
+#define STACK_SIZE 2048
+#define WRITER_PRIO K_PRIO_PREEMPT(8)
+#define READER_PRIO K_PRIO_PREEMPT(7)
+
+FS_LITTLEFS_DECLARE_DEFAULT_CONFIG(storage);
+static struct fs_mount_t lfs_mnt = {
+	.type = FS_LITTLEFS,
+	.fs_data = &storage,
+	.storage_dev = (void *)FLASH_AREA_ID(storage),
+	.mnt_point = MNT_POINT,
+};
+
+static uint8_t write_buf[WRITE_SIZE];
+static uint8_t read_buf[ASSET_SIZE];
+
+static volatile bool writer_done;
+static int writer_rc;
+static int reader_rc;
+static uint64_t writer_us;
+static uint32_t reader_ops;
+static uint64_t reader_total_us;
+static uint32_t reader_max_us;
+
+static struct fs_file_t sync_file;
+static volatile bool syncing;
+static K_SEM_DEFINE(probe_sem, 0, 1);
+
+struct probe_stats {
+	uint32_t ops;
+	uint64_t total_us;
+	uint32_t max_us;
+};
+
+static struct probe_stats stat_probe;
+static struct probe_stats readdir_probe;
+
+static int write_file(const char *path, const uint8_t *data, size_t len,
+		      int writes)
+{
+	struct fs_file_t file;
+	int rc;
+
+	fs_file_t_init(&file);
+
+	rc = fs_open(&file, path, FS_O_CREATE | FS_O_WRITE);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = fs_truncate(&file, 0);
+	for (int i = 0; (rc == 0) && (i < writes); i++) {
+		ssize_t n = fs_write(&file, data, len);
+
+		rc = (n == len) ? 0 : -EIO;
+	}
+
+	if (rc == 0) {
+		rc = fs_sync(&file);
+	}
+
+	(void)fs_close(&file);
+
+	return rc;
+}
+
+static void writer(void *p1, void *p2, void *p3)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; (writer_rc == 0) && (i < N_ROUNDS); i++) {
+		writer_rc = write_file(LOG_PATH, write_buf, sizeof(write_buf),
+				       WRITES_PER_ROUND);
+	}
+
+	writer_us = k_cyc_to_us_floor64(k_cycle_get_32() - start);
+	writer_done = true;
+}
+
+static int read_asset(void)
+{
+	struct fs_dirent entry;
+	struct fs_file_t file;
+	ssize_t n;
+	int rc;
+
+	rc = fs_stat(ASSET_PATH, &entry);
+	if (rc != 0) {
+		return rc;
+	}
+
+	fs_file_t_init(&file);
+	rc = fs_open(&file, ASSET_PATH, FS_O_READ);
+	if (rc != 0) {
+		return rc;
+	}
+
+	n = fs_read(&file, read_buf, sizeof(read_buf));
+	(void)fs_close(&file);
+
+	return (n == entry.size) ? 0 : -EIO;
+}
+
+static void reader(void *p1, void *p2, void *p3)
+{
+	while (!writer_done && (reader_rc == 0)) {
+		uint32_t start, us;
+
+		k_sleep(K_MSEC(READ_PERIOD_MS));
+
+		start = k_cycle_get_32();
+		reader_rc = read_asset();
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		reader_ops++;
+		reader_total_us += us;
+		reader_max_us = MAX(reader_max_us, us);
+	}
+}
+
+static void probe_expiry(struct k_timer *timer)
+{
+	k_sem_give(&probe_sem);
+}
+
+static K_TIMER_DEFINE(probe_timer, probe_expiry, NULL);
+
+static void sync_writer(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; (writer_rc == 0) && (i < N_SYNCS); i++) {
+		ssize_t n = fs_write(&sync_file, write_buf, SYNC_WRITE_SIZE);
+
+		if (n != SYNC_WRITE_SIZE) {
+			writer_rc = -EIO;
+			break;
+		}
+
+		syncing = true;
+		k_timer_start(&probe_timer, K_USEC(PROBE_DELAY_US), K_NO_WAIT);
+		writer_rc = fs_sync(&sync_file);
+		syncing = false;
+		k_timer_stop(&probe_timer);
+	}
+
+	writer_done = true;
+	k_sem_give(&probe_sem);
+}
+
+static int list_dir(void)
+{
+	struct fs_dirent entry;
+	struct fs_dir_t dir;
+	int rc;
+
+	fs_dir_t_init(&dir);
+	rc = fs_opendir(&dir, MNT_POINT);
+	if (rc != 0) {
+		return rc;
+	}
+
+	do {
+		rc = fs_readdir(&dir, &entry);
+	} while ((rc == 0) && (entry.name[0] != '\0'));
+
+	(void)fs_closedir(&dir);
+
+	return rc;
+}
+
+/* Stat or list the volume each time the timer fires during a sync */
+static void sync_reader(void *p1, void *p2, void *p3)
+{
+	struct fs_dirent entry;
+	struct probe_stats *probe;
+	uint32_t start, us;
+	bool list = false;
+
+	while (reader_rc == 0) {
+		k_sem_take(&probe_sem, K_FOREVER);
+		if (writer_done) {
+			break;
+		}
+
+		/* The sync ended before the timer fired */
+		if (!syncing) {
+			continue;
+		}
+
+		start = k_cycle_get_32();
+		if (list) {
+			reader_rc = list_dir();
+			probe = &readdir_probe;
+		} else {
+			reader_rc = fs_stat(ASSET_PATH, &entry);
+			probe = &stat_probe;
+		}
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+		list = !list;
+
+		probe->ops++;
+		probe->total_us += us;
+		probe->max_us = MAX(probe->max_us, us);
+	}
+}
+
+static void print_probe(const char *name, const struct probe_stats *probe)
+{
+	printk("%-7s %u ops, avg %u us, max %u us\n", name, probe->ops,
+	       (uint32_t)(probe->total_us / MAX(probe->ops, 1)),
+	       probe->max_us);
+}
+
+K_THREAD_STACK_DEFINE(writer_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(reader_stack, STACK_SIZE);
+static struct k_thread writer_thread;
+static struct k_thread reader_thread;
+
+void main(void)
+{
+	const struct flash_area *fap;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fap);
+	if (rc == 0) {
+		rc = flash_area_erase(fap, 0, fap->fa_size);
+		flash_area_close(fap);
+	}
+
+	if (rc == 0) {
+		rc = fs_mount(&lfs_mnt);
+	}
+
+	for (int i = 0; i < sizeof(write_buf); i++) {
+		write_buf[i] = (uint8_t)i;
+	}
+
+	if (rc == 0) {
+		rc = write_file(ASSET_PATH, write_buf, ASSET_SIZE, 1);
+	}
+
+	if (rc != 0) {
+		printk("setup failed (%d)\n", rc);
+		return;
+	}
+
+	k_thread_create(&reader_thread, reader_stack, STACK_SIZE, reader,
+			NULL, NULL, NULL, READER_PRIO, 0, K_NO_WAIT);
+	k_thread_create(&writer_thread, writer_stack, STACK_SIZE, writer,
+			NULL, NULL, NULL, WRITER_PRIO, 0, K_NO_WAIT);
+
+	k_thread_join(&writer_thread, K_FOREVER);
+	k_thread_join(&reader_thread, K_FOREVER);
+
+	if ((writer_rc != 0) || (reader_rc != 0) || (reader_ops == 0)) {
+		printk("run failed, writer %d, reader %d\n", writer_rc,
+		       reader_rc);
+		return;
+	}
+
+	printk("writer  %u KiB/s\n",
+	       (uint32_t)((uint64_t)N_ROUNDS * WRITES_PER_ROUND * WRITE_SIZE *
+			  USEC_PER_SEC / 1024U / MAX(writer_us, 1)));
+	printk("reader  %u ops, avg %u us, max %u us\n", reader_ops,
+	       (uint32_t)(reader_total_us / reader_ops), reader_max_us);
+
+	fs_file_t_init(&sync_file);
+	rc = fs_open(&sync_file, LOG_PATH, FS_O_WRITE | FS_O_APPEND);
+	if (rc != 0) {
+		printk("open failed (%d)\n", rc);
+		return;
+	}
+
+	writer_done = false;
+	k_thread_create(&reader_thread, reader_stack, STACK_SIZE, sync_reader,
+			NULL, NULL, NULL, READER_PRIO, 0, K_NO_WAIT);
+	k_thread_create(&writer_thread, writer_stack, STACK_SIZE, sync_writer,
+			NULL, NULL, NULL, WRITER_PRIO, 0, K_NO_WAIT);
+
+	k_thread_join(&writer_thread, K_FOREVER);
+	k_thread_join(&reader_thread, K_FOREVER);
+	(void)fs_close(&sync_file);
+
+	if ((writer_rc != 0) || (reader_rc != 0)) {
+		printk("sync run failed, writer %d, reader %d\n", writer_rc,
+		       reader_rc);
+		return;
+	}
+
+	print_probe("stat", &stat_probe);
+	print_probe("readdir", &readdir_probe);
+	printk("fin\n");
+}
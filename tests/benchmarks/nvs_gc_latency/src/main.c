@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/storage/flash_map.h>
+
+/* NVS write latency benchmark. A thread periodically writes small entries,
+ * rewriting the same few ids so that sectors keep being garbage collected.
+ * Without incremental gc the write that fills a sector also copies the
+ * oldest sector and erases it. With CONFIG_NVS_GC_INCREMENTAL a lower
+ * priority work item collects the oldest sector ahead of time with
+ * nvs_gc_step(), and the erase does not hold up the writes.
+ */
+
+#define SECTOR_COUNT 4
+#define N_IDS 8
+#define N_WRITES 400
+#define ENTRY_SIZE 32
+#define WRITE_PERIOD_MS 2
+#define GC_BUDGET_US 500
+
+#define STACK_SIZE 2048
+#define WRITER_PRIO K_PRIO_PREEMPT(7)
+#define GC_PRIO K_PRIO_PREEMPT(8)
+
+static struct nvs_fs fs;
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+K_THREAD_STACK_DEFINE(gc_stack, STACK_SIZE);
+static struct k_work_q gc_workq;
+static struct k_work gc_work;
+static int gc_rc;
+
+static void gc_work_handler(struct k_work *work)
+{
+	int rc = nvs_gc_step(&fs, GC_BUDGET_US);
+
+	if (rc > 0) {
+		k_work_submit_to_queue(&gc_workq, work);
+	} else if (rc < 0) {
+		gc_rc = rc;
+	}
+}
+#endif
+
+static int setup(void)
+{
+	const struct flash_area *fap;
+	struct flash_pages_info info;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fap);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = flash_area_erase(fap, 0, fap->fa_size);
+	fs.flash_device = flash_area_get_device(fap);
+	fs.offset = fap->fa_off;
+	flash_area_close(fap);
+	if (rc != 0) {
+		return rc;
+	}
+
+	rc = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (rc != 0) {
+		return rc;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = SECTOR_COUNT;
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	k_work_queue_start(&gc_workq, gc_stack, K_THREAD_STACK_SIZEOF(gc_stack),
+			   GC_PRIO, NULL);
+	k_work_init(&gc_work, gc_work_handler);
+#endif
+
+	return nvs_mount(&fs);
+}
+
+void main(void)
+{
+	uint8_t buf[ENTRY_SIZE];
+	uint32_t start, us, max_us = 0U;
+	uint64_t total_us = 0U;
+	ssize_t len;
+	int rc;
+
+	k_thread_priority_set(k_current_get(), WRITER_PRIO);
+
+	rc = setup();
+	if (rc != 0) {
+		printk("setup failed (%d)\n", rc);
+		return;
+	}
+
+	for (int i = 0; i < N_WRITES; i++) {
+		k_sleep(K_MSEC(WRITE_PERIOD_MS));
+
+		memset(buf, i, sizeof(buf));
+
+		start = k_cycle_get_32();
+		len = nvs_write(&fs, i % N_IDS, buf, sizeof(buf));
+		us = k_cyc_to_us_floor32(k_cycle_get_32() - start);
+
+		if (len != sizeof(buf)) {
+			printk("write failed (%d)\n", (int)len);
+			return;
+		}
+
+		total_us += us;
+		max_us = MAX(max_us, us);
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		k_work_submit_to_queue(&gc_workq, &gc_work);
+#endif
+	}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	if (gc_rc != 0) {
+		printk("gc failed (%d)\n", gc_rc);
+		return;
+	}
+#endif
+
+	printk("write max %u us, avg %u us\n", max_us,
+	       (uint32_t)(total_us / N_WRITES));
+	printk("fin\n");
+}
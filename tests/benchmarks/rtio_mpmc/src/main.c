@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/rtio/rtio_spsc.h>
+#include <zephyr/rtio/rtio_mpmc.h>
+
+/* Queue contention benchmark. Producer threads each push N_ITEMS values
+ * through a bounded queue while consumer threads pop them, for several
+ * producer and consumer counts. Threads spread over the CPUs and yield when
+ * the queue is full or empty. The lock-free MPMC ring is compared with the
+ * SPSC ring guarded by a spinlock on both sides, which is how several
+ * contexts have to share an SPSC ring.
+ */
+
+#define QUEUE_SIZE 64
+#define N_ITEMS 16384
+#define MAX_THREADS 4
+#define STACK_SIZE 1024
+#define THREAD_PRIO K_PRIO_PREEMPT(5)
+
+struct queue_ops {
+	const char *name;
+	bool (*put)(uint32_t val);
+	bool (*get)(uint32_t *val);
+};
+
+RTIO_MPMC_DEFINE(mpmc, uint32_t, QUEUE_SIZE);
+
+static bool mpmc_put(uint32_t val)
+{
+	uint32_t *item = rtio_mpmc_acquire(&mpmc);
+
+	if (item == NULL) {
+		return false;
+	}
+
+	*item = val;
+	rtio_mpmc_produce(&mpmc, item);
+
+	return true;
+}
+
+static bool mpmc_get(uint32_t *val)
+{
+	uint32_t *item = rtio_mpmc_consume(&mpmc);
+
+	if (item == NULL) {
+		return false;
+	}
+
+	*val = *item;
+	rtio_mpmc_release(&mpmc, item);
+
+	return true;
+}
+
+RTIO_SPSC_DEFINE(spsc, uint32_t, QUEUE_SIZE);
+static struct k_spinlock put_lock;
+static struct k_spinlock get_lock;
+
+static bool locked_put(uint32_t val)
+{
+	k_spinlock_key_t key = k_spin_lock(&put_lock);
+	uint32_t *item = rtio_spsc_acquire(&spsc);
+
+	if (item != NULL) {
+		*item = val;
+		rtio_spsc_produce(&spsc);
+	}
+
+	k_spin_unlock(&put_lock, key);
+
+	return item != NULL;
+}
+
+static bool locked_get(uint32_t *val)
+{
+	k_spinlock_key_t key = k_spin_lock(&get_lock);
+	uint32_t *item = rtio_spsc_consume(&spsc);
+
+	if (item != NULL) {
+		*val = *item;
+		rtio_spsc_release(&spsc);
+	}
+
+	k_spin_unlock(&get_lock, key);
+
+	return item != NULL;
+}
+
+static const struct queue_ops queues[] = {
+	{ "mpmc", mpmc_put, mpmc_get },
+	{ "locked", locked_put, locked_get },
+};
+
+static const struct queue_ops *ops;
+static atomic_t remaining;
+static atomic_t sum;
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	for (uint32_t i = 1; i <= N_ITEMS; i++) {
+		while (!ops->put(i)) {
+			k_yield();
+		}
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	uint32_t val;
+
+	while (atomic_get(&remaining) > 0) {
+		if (!ops->get(&val)) {
+			k_yield();
+			continue;
+		}
+
+		atomic_add(&sum, val);
+		atomic_dec(&remaining);
+	}
+}
+
+K_THREAD_STACK_ARRAY_DEFINE(stacks, 2 * MAX_THREADS, STACK_SIZE);
+static struct k_thread threads[2 * MAX_THREADS];
+
+static int bench(const struct queue_ops *q, int producers, int consumers)
+{
+	int n = producers + consumers;
+	uint32_t start, cycles;
+	uint64_t us;
+
+	ops = q;
+	atomic_set(&remaining, producers * N_ITEMS);
+	atomic_set(&sum, 0);
+
+	start = k_cycle_get_32();
+
+	/* Interleave producers and consumers so both spread over the CPUs */
+	for (int i = 0; i < n; i++) {
+		bool produce = (i % 2 == 0) ? (i / 2 < producers) : (i / 2 >= consumers);
+
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE,
+				produce ? producer : consumer, NULL, NULL, NULL,
+				THREAD_PRIO, 0, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < n; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	if (atomic_get(&sum) != (atomic_val_t)producers * N_ITEMS * (N_ITEMS + 1) / 2) {
+		printk("%dx%d %s lost values\n", producers, consumers, q->name);
+		return -EIO;
+	}
+
+	printk("%dx%d %-6s %u ops/s\n", producers, consumers, q->name,
+	       (uint32_t)((uint64_t)producers * N_ITEMS * USEC_PER_SEC / us));
+
+	return 0;
+}
+
+void main(void)
+{
+	static const int counts[][2] = { { 1, 1 }, { 1, 4 }, { 4, 1 }, { 2, 2 }, { 4, 4 } };
+
+	for (int i = 0; i < ARRAY_SIZE(counts); i++) {
+		for (int j = 0; j < ARRAY_SIZE(queues); j++) {
+			if (bench(&queues[j], counts[i][0], counts[i][1]) != 0) {
+				return;
+			}
+		}
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <string.h>
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+#include <zephyr/rtio/rtio_executor_concurrent.h>
+
+/* RTIO streaming overhead benchmark. An event iodev holds the read request
+ * it is given and completes it with a sample when the benchmark signals an
+ * event, the way a sensor data ready interrupt would. For each executor
+ * samples are read:
+ * - resubmit: a read request is prepared and submitted for every sample,
+ * - multishot: a single RTIO_SQE_MULTISHOT read request stays armed.
+ * The time spent per sample covers the event, the executor and consuming
+ * the completion.
+ */
+
+#define SAMPLE_SIZE 4
+#define N_SAMPLES 8192
+
+struct event_iodev {
+	struct rtio_iodev iodev;
+	const struct rtio_sqe *sqe;
+	struct rtio *r;
+	uint32_t count;
+};
+
+static void event_iodev_submit(const struct rtio_sqe *sqe, struct rtio *r)
+{
+	struct event_iodev *ev = (struct event_iodev *)sqe->iodev;
+
+	ev->sqe = sqe;
+	ev->r = r;
+}
+
+static const struct rtio_iodev_api event_iodev_api = {
+	.submit = event_iodev_submit,
+};
+
+static struct event_iodev ev = {
+	.iodev = {
+		.api = &event_iodev_api,
+	},
+};
+
+/* Complete the pending request with a sample */
+static int event(void)
+{
+	const struct rtio_sqe *sqe = ev.sqe;
+	uint32_t buf_len;
+	uint8_t *buf;
+	int rc;
+
+	if (sqe == NULL) {
+		return -EIO;
+	}
+
+	ev.sqe = NULL;
+
+	rc = rtio_sqe_rx_buf(ev.r, sqe, SAMPLE_SIZE, SAMPLE_SIZE, &buf, &buf_len);
+	if (rc != 0) {
+		rtio_sqe_err(ev.r, sqe, rc);
+		return rc;
+	}
+
+	memcpy(buf, &ev.count, SAMPLE_SIZE);
+	ev.count++;
+	rtio_sqe_ok(ev.r, sqe, 0);
+
+	return 0;
+}
+
+static int consume(struct rtio *r)
+{
+	struct rtio_cqe *cqe = rtio_cqe_consume(r);
+	int rc;
+
+	if (cqe == NULL) {
+		return -EIO;
+	}
+
+	rc = cqe->result;
+	rtio_spsc_release(r->cq);
+
+	return rc;
+}
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(simple_exec);
+RTIO_DEFINE(r_simple, (struct rtio_executor *)&simple_exec, 4, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(concurrent_exec, 1);
+RTIO_DEFINE(r_concurrent, (struct rtio_executor *)&concurrent_exec, 4, 4);
+
+static uint8_t sample[SAMPLE_SIZE];
+
+static struct rtio_sqe *prep_read(struct rtio *r, uint16_t flags)
+{
+	struct rtio_sqe *sqe = rtio_spsc_acquire(r->sq);
+
+	rtio_sqe_prep_read(sqe, &ev.iodev, RTIO_PRIO_NORM, sample,
+			   sizeof(sample), NULL);
+	sqe->flags = flags;
+
+	return sqe;
+}
+
+static int run_resubmit(struct rtio *r)
+{
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < N_SAMPLES); i++) {
+		(void)prep_read(r, 0);
+		rc = rtio_submit(r, 0);
+		if (rc == 0) {
+			rc = event();
+		}
+		if (rc == 0) {
+			rc = consume(r);
+		}
+	}
+
+	return rc;
+}
+
+static int run_multishot(struct rtio *r)
+{
+	int rc = 0;
+
+	for (int i = 0; (rc == 0) && (i < N_SAMPLES); i++) {
+		rc = event();
+		if (rc == 0) {
+			rc = consume(r);
+		}
+	}
+
+	return rc;
+}
+
+static int bench(const char *name, struct rtio *r, bool multishot)
+{
+	struct rtio_sqe *sqe = NULL;
+	uint32_t start, cycles;
+	int rc = 0;
+
+	if (multishot) {
+		sqe = prep_read(r, RTIO_SQE_MULTISHOT);
+		rc = rtio_submit(r, 0);
+	}
+
+	start = k_cycle_get_32();
+	if (rc == 0) {
+		rc = multishot ? run_multishot(r) : run_resubmit(r);
+	}
+	cycles = k_cycle_get_32() - start;
+
+	if (sqe != NULL) {
+		/* Retire the request with a last sample */
+		rtio_sqe_multishot_stop(sqe);
+		if (rc == 0) {
+			rc = event();
+		}
+		if (rc == 0) {
+			rc = consume(r);
+		}
+	}
+
+	if (rc != 0) {
+		printk("%s %s failed (%d)\n", name,
+		       multishot ? "multishot" : "resubmit", rc);
+		return rc;
+	}
+
+	printk("%-10s %-9s %u ns/sample\n", name,
+	       multishot ? "multishot" : "resubmit",
+	       (uint32_t)(k_cyc_to_ns_floor64(cycles) / N_SAMPLES));
+
+	return 0;
+}
+
+void main(void)
+{
+	if ((bench("simple", &r_simple, false) != 0) ||
+	    (bench("simple", &r_simple, true) != 0) ||
+	    (bench("concurrent", &r_concurrent, false) != 0) ||
+	    (bench("concurrent", &r_concurrent, true) != 0)) {
+		return;
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <stdlib.h>
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/settings/settings.h>
+#include <zephyr/storage/flash_map.h>
+
+/* Settings load benchmark. Every name is saved several times with a
+ * different value, so the backend holds a log in which most records are
+ * superseded by a newer copy, then the whole log is loaded repeatedly. The
+ * reported time covers walking the storage, skipping the stale records and
+ * handing the newest ones to the handler. The flash simulator adds a delay
+ * to every access, like a real flash part would.
+ */
+
+#define N_NAMES 128
+#define N_ROUNDS 4
+#define N_RUNS 4
+
+static uint32_t loaded;
+static uint32_t stale;
+
+static int bench_set(const char *name, size_t len, settings_read_cb read_cb,
+		     void *cb_arg)
+{
+	uint32_t val;
+	int idx;
+
+	if (read_cb(cb_arg, &val, sizeof(val)) != sizeof(val)) {
+		return -EINVAL;
+	}
+
+	idx = atoi(name);
+	if (val != (uint32_t)(idx + (N_ROUNDS - 1) * N_NAMES)) {
+		stale++;
+	}
+
+	loaded++;
+
+	return 0;
+}
+
+SETTINGS_STATIC_HANDLER_DEFINE(bench, "bench", NULL, bench_set, NULL, NULL);
+
+static int fill(void)
+{
+	char name[SETTINGS_MAX_NAME_LEN];
+	uint32_t val;
+	int rc;
+
+	for (int round = 0; round < N_ROUNDS; round++) {
+		for (int i = 0; i < N_NAMES; i++) {
+			snprintk(name, sizeof(name), "bench/%d", i);
+			val = i + round * N_NAMES;
+
+			rc = settings_save_one(name, &val, sizeof(val));
+			if (rc != 0) {
+				return rc;
+			}
+		}
+	}
+
+	return 0;
+}
+
+void main(void)
+{
+	const struct flash_area *fap;
+	uint32_t start, cycles;
+	uint64_t us = 0;
+	int rc;
+
+	rc = flash_area_open(FLASH_AREA_ID(storage), &fap);
+	if (rc == 0) {
+		rc = flash_area_erase(fap, 0, fap->fa_size);
+		flash_area_close(fap);
+	}
+
+	if (rc == 0) {
+		rc = settings_subsys_init();
+	}
+
+	if (rc == 0) {
+		rc = fill();
+	}
+
+	if (rc != 0) {
+		printk("setup failed (%d)\n", rc);
+		return;
+	}
+
+	for (int i = 0; i < N_RUNS; i++) {
+		loaded = 0;
+		stale = 0;
+
+		start = k_cycle_get_32();
+		rc = settings_load();
+		cycles = k_cycle_get_32() - start;
+
+		if (rc != 0 || loaded != N_NAMES || stale != 0) {
+			printk("load failed (%d), %u loaded, %u stale\n", rc,
+			       loaded, stale);
+			return;
+		}
+
+		us += k_cyc_to_us_floor64(cycles);
+	}
+
+	printk("loaded %u/%u records\n", loaded, N_NAMES * N_ROUNDS);
+	printk("load    %u us\n", (uint32_t)(us / N_RUNS));
+	printk("fin\n");
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/zephyr.h>
+#include <zephyr/sys/printk.h>
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+/* Command dispatch throughput benchmark. A large set of root commands and
+ * a large section-registered subcommand set are created, and commands
+ * picked across those sets are executed repeatedly through the dummy
+ * backend, which is how the shell is driven by automated tooling. The
+ * reported rate covers command line parsing, command lookup at every
+ * level and the (empty) handler call.
+ */
+
+#define N_ROOT_CMDS 200
+#define N_SUB_CMDS 200
+#define N_RUNS 2000
+
+static int cmd_bench(const struct shell *sh, size_t argc, char **argv)
+{
+	ARG_UNUSED(sh);
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	return 0;
+}
+
+#define BENCH_ROOT_CMD(i, _) \
+	SHELL_CMD_REGISTER(UTIL_CAT(bench_, i), NULL, "Benchmark command.", \
+			   cmd_bench)
+
+LISTIFY(N_ROOT_CMDS, BENCH_ROOT_CMD, (;));
+
+SHELL_SUBCMD_SET_CREATE(sub_bench_section, (bench_section));
+
+#define BENCH_SUB_CMD(i, _) \
+	SHELL_SUBCMD_ADD((bench_section), UTIL_CAT(sub_, i), NULL, \
+			 "Benchmark subcommand.", cmd_bench, 1, 0)
+
+LISTIFY(N_SUB_CMDS, BENCH_SUB_CMD, (;));
+
+SHELL_CMD_REGISTER(bench_section, &sub_bench_section,
+		   "Benchmark subcommand set.", NULL);
+
+static uint32_t run(const struct shell *sh, const char *fmt, int n_cmds)
+{
+	char cmd[32];
+	uint32_t start, cycles;
+	uint64_t us;
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < N_RUNS; i++) {
+		snprintk(cmd, sizeof(cmd), fmt, (i * 7) % n_cmds);
+		if (shell_execute_cmd(sh, cmd) != 0) {
+			printk("%s failed\n", cmd);
+			return 0;
+		}
+	}
+
+	cycles = k_cycle_get_32() - start;
+
+	/* Guard against a zero duration on a simulated clock */
+	us = MAX(k_cyc_to_us_floor64(cycles), 1);
+
+	return (uint32_t)((uint64_t)N_RUNS * USEC_PER_SEC / us);
+}
+
+void main(void)
+{
+	const struct shell *sh = shell_backend_dummy_get_ptr();
+
+	/* Let the shell thread finish its initialization */
+	k_sleep(K_MSEC(100));
+
+	printk("root    %u cmds/s\n", run(sh, "bench_%d", N_ROOT_CMDS));
+	printk("section %u cmds/s\n",
+	       run(sh, "bench_section sub_%d", N_SUB_CMDS));
+	printk("fin\n");
+}
@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/byteorder.h>
+
+#include "common.h"
+
+CREATE_FLAG(flag_is_connected);
+CREATE_FLAG(flag_discover_complete);
+CREATE_FLAG(flag_write_complete);
+CREATE_FLAG(flag_subscribed);
+CREATE_FLAG(flag_received_all);
+
+/* Multiple Handle Value Notifications bit of the Client Supported Features */
+#define CF_NOTIFY_MULTI BIT(2)
+
+static struct bt_conn *g_conn;
+static uint16_t chrc_handles[CHRC_COUNT];
+static uint16_t cf_handle;
+
+static struct bt_gatt_subscribe_params sub_params[CHRC_COUNT];
+/* Number of rounds received for each characteristic */
+static uint16_t num_rounds[CHRC_COUNT];
+static size_t num_notifications;
+static int64_t first_notification;
+static int64_t last_notification;
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	if (err != 0) {
+		FAIL("Failed to connect to %s (%u)\n", addr, err);
+		return;
+	}
+
+	printk("Connected to %s\n", addr);
+
+	SET_FLAG(flag_is_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	if (conn != g_conn) {
+		return;
+	}
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	printk("Disconnected: %s (reason 0x%02x)\n", addr, reason);
+
+	bt_conn_unref(g_conn);
+
+	g_conn = NULL;
+	UNSET_FLAG(flag_is_connected);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+void device_found(const bt_addr_le_t *addr, int8_t rssi, uint8_t type, struct net_buf_simple *ad)
+{
+	char addr_str[BT_ADDR_LE_STR_LEN];
+	int err;
+
+	if (g_conn != NULL) {
+		return;
+	}
+
+	/* We're only interested in connectable events */
+	if (type != BT_HCI_ADV_IND && type != BT_HCI_ADV_DIRECT_IND) {
+		return;
+	}
+
+	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+	printk("Device found: %s (RSSI %d)\n", addr_str, rssi);
+
+	printk("Stopping scan\n");
+	err = bt_le_scan_stop();
+	if (err != 0) {
+		FAIL("Could not stop scan: %d");
+		return;
+	}
+
+	err = bt_conn_le_create(addr, BT_CONN_LE_CREATE_CONN, BT_LE_CONN_PARAM_DEFAULT, &g_conn);
+	if (err != 0) {
+		FAIL("Could not connect to peer: %d", err);
+	}
+}
+
+static uint8_t discover_func(struct bt_conn *conn, const struct bt_gatt_attr *attr,
+			     struct bt_gatt_discover_params *params)
+{
+	const struct bt_gatt_chrc *chrc;
+
+	if (attr == NULL) {
+		for (int i = 0; i < CHRC_COUNT; i++) {
+			if (chrc_handles[i] == 0) {
+				FAIL("Did not discover chrc %d\n", i);
+			}
+		}
+
+		if (cf_handle == 0) {
+			FAIL("Did not discover Client Supported Features\n");
+		}
+
+		(void)memset(params, 0, sizeof(*params));
+
+		SET_FLAG(flag_discover_complete);
+
+		return BT_GATT_ITER_STOP;
+	}
+
+	chrc = (struct bt_gatt_chrc *)attr->user_data;
+
+	if (bt_uuid_cmp(chrc->uuid, BT_UUID_GATT_CLIENT_FEATURES) == 0) {
+		printk("Found Client Supported Features\n");
+		cf_handle = chrc->value_handle;
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	for (int i = 0; i < CHRC_COUNT; i++) {
+		if (bt_uuid_cmp(chrc->uuid, TEST_CHRC_UUID(i)) == 0) {
+			printk("Found chrc %d\n", i);
+			chrc_handles[i] = chrc->value_handle;
+			break;
+		}
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void gatt_discover(void)
+{
+	static struct bt_gatt_discover_params discover_params;
+	int err;
+
+	printk("Discovering characteristics\n");
+
+	discover_params.uuid = NULL;
+	discover_params.func = discover_func;
+	discover_params.start_handle = BT_ATT_FIRST_ATTRIBUTE_HANDLE;
+	discover_params.end_handle = BT_ATT_LAST_ATTRIBUTE_HANDLE;
+	discover_params.type = BT_GATT_DISCOVER_CHARACTERISTIC;
+
+	err = bt_gatt_discover(g_conn, &discover_params);
+	if (err != 0) {
+		FAIL("Discover failed(err %d)\n", err);
+	}
+
+	WAIT_FOR_FLAG(flag_discover_complete);
+	printk("Discover complete\n");
+}
+
+static void write_cb(struct bt_conn *conn, uint8_t err, struct bt_gatt_write_params *params)
+{
+	if (err != BT_ATT_ERR_SUCCESS) {
+		FAIL("Write failed: 0x%02X\n", err);
+	}
+
+	SET_FLAG(flag_write_complete);
+}
+
+static void enable_notify_multi(void)
+{
+	static const uint8_t cf = CF_NOTIFY_MULTI;
+	static struct bt_gatt_write_params write_params = {
+		.func = write_cb,
+		.offset = 0,
+		.data = &cf,
+		.length = sizeof(cf),
+	};
+	int err;
+
+	write_params.handle = cf_handle;
+
+	err = bt_gatt_write(g_conn, &write_params);
+	if (err != 0) {
+		FAIL("Failed to write Client Supported Features (err %d)\n", err);
+	}
+
+	WAIT_FOR_FLAG(flag_write_complete);
+	printk("Multiple Handle Value Notifications enabled\n");
+}
+
+static uint8_t test_notify(struct bt_conn *conn, struct bt_gatt_subscribe_params *params,
+			   const void *data, uint16_t length)
+{
+	size_t i = params - sub_params;
+	uint16_t round;
+
+	if (data == NULL || length < sizeof(round)) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	round = sys_get_le16(data);
+
+	/* Values of a round which was resent by the server */
+	if (round < num_rounds[i]) {
+		return BT_GATT_ITER_CONTINUE;
+	}
+
+	if (round != num_rounds[i]) {
+		FAIL("Chrc %zu: unexpected round %u (expected %u)\n", i, round, num_rounds[i]);
+	}
+
+	if (num_notifications == 0) {
+		first_notification = k_uptime_get();
+	}
+
+	num_rounds[i] = round + 1;
+	num_notifications++;
+
+	if (num_notifications == NOTIFICATION_COUNT) {
+		last_notification = k_uptime_get();
+		SET_FLAG(flag_received_all);
+	}
+
+	return BT_GATT_ITER_CONTINUE;
+}
+
+static void test_subscribed(struct bt_conn *conn, uint8_t err, struct bt_gatt_write_params *params)
+{
+	if (err) {
+		FAIL("Subscribe failed (err %d)\n", err);
+	}
+
+	SET_FLAG(flag_subscribed);
+}
+
+static void gatt_subscribe(void)
+{
+	int err;
+
+	for (int i = 0; i < CHRC_COUNT; i++) {
+		UNSET_FLAG(flag_subscribed);
+
+		sub_params[i].notify = test_notify;
+		sub_params[i].write = test_subscribed;
+		sub_params[i].value = BT_GATT_CCC_NOTIFY;
+		sub_params[i].value_handle = chrc_handles[i];
+		/* The CCC descriptor directly follows the value */
+		sub_params[i].ccc_handle = chrc_handles[i] + 1;
+
+		err = bt_gatt_subscribe(g_conn, &sub_params[i]);
+		if (err < 0) {
+			FAIL("Failed to subscribe\n");
+		}
+
+		WAIT_FOR_FLAG(flag_subscribed);
+	}
+
+	printk("Subscribed\n");
+}
+
+static void test_main_common(bool notify_multi)
+{
+	int64_t elapsed;
+	int err;
+
+	err = bt_enable(NULL);
+	if (err != 0) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+	}
+
+	err = bt_le_scan_start(BT_LE_SCAN_PASSIVE, device_found);
+	if (err != 0) {
+		FAIL("Scanning failed to start (err %d)\n", err);
+	}
+
+	printk("Scanning successfully started\n");
+
+	WAIT_FOR_FLAG(flag_is_connected);
+
+	gatt_discover();
+
+	if (notify_multi) {
+		enable_notify_multi();
+	}
+
+	gatt_subscribe();
+
+	WAIT_FOR_FLAG(flag_received_all);
+
+	elapsed = MAX(last_notification - first_notification, 1);
+
+	printk("%s: %u notifications in %u ms, %u notifications/s\n",
+	       notify_multi ? "multiple" : "single", NOTIFICATION_COUNT, (uint32_t)elapsed,
+	       (uint32_t)(NOTIFICATION_COUNT * MSEC_PER_SEC / elapsed));
+
+	PASS("GATT client Passed\n");
+}
+
+static void test_main(void)
+{
+	test_main_common(false);
+}
+
+static void test_main_multi(void)
+{
+	test_main_common(true);
+}
+
+static const struct bst_test_instance test_vcs[] = {
+	{
+		.test_id = "gatt_client",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main,
+	},
+	{
+		.test_id = "gatt_client_notify_multi",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main_multi,
+	},
+	BSTEST_END_MARKER,
+};
+
+struct bst_test_list *test_gatt_client_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_vcs);
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr/sys/byteorder.h>
+
+#include "common.h"
+
+extern enum bst_result_t bst_result;
+
+CREATE_FLAG(flag_is_connected);
+static atomic_t num_subscribed;
+
+static struct bt_conn *g_conn;
+
+/* Each value starts with the number of the round it was sent in */
+static uint8_t chrc_data[CHRC_COUNT][CHRC_SIZE];
+
+static void connected(struct bt_conn *conn, uint8_t err)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	if (err != 0) {
+		FAIL("Failed to connect to %s (%u)\n", addr, err);
+		return;
+	}
+
+	printk("Connected to %s\n", addr);
+
+	g_conn = bt_conn_ref(conn);
+	SET_FLAG(flag_is_connected);
+}
+
+static void disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	char addr[BT_ADDR_LE_STR_LEN];
+
+	if (conn != g_conn) {
+		return;
+	}
+
+	bt_addr_le_to_str(bt_conn_get_dst(conn), addr, sizeof(addr));
+
+	printk("Disconnected: %s (reason 0x%02x)\n", addr, reason);
+
+	bt_conn_unref(g_conn);
+
+	g_conn = NULL;
+	UNSET_FLAG(flag_is_connected);
+}
+
+BT_CONN_CB_DEFINE(conn_callbacks) = {
+	.connected = connected,
+	.disconnected = disconnected,
+};
+
+static void subscribe(const struct bt_gatt_attr *attr, uint16_t value)
+{
+	if (value == BT_GATT_CCC_NOTIFY) {
+		atomic_inc(&num_subscribed);
+	}
+}
+
+#define TEST_CHRC(i, _)                                                                            \
+	BT_GATT_CHARACTERISTIC(TEST_CHRC_UUID(i), BT_GATT_CHRC_NOTIFY, BT_GATT_PERM_NONE, NULL,    \
+			       NULL, NULL),                                                        \
+	BT_GATT_CCC(subscribe, BT_GATT_PERM_READ | BT_GATT_PERM_WRITE)
+
+BT_GATT_SERVICE_DEFINE(test_svc, BT_GATT_PRIMARY_SERVICE(TEST_SERVICE_UUID),
+		       LISTIFY(CHRC_COUNT, TEST_CHRC, (,)));
+
+/* Service declaration first, then declaration, value and CCC of each chrc */
+#define CHRC_VALUE_ATTR(i) (&attr_test_svc[2 + 3 * (i)])
+
+static void notify_round(uint16_t round)
+{
+	struct bt_gatt_notify_params params[CHRC_COUNT];
+	int err;
+
+	(void)memset(params, 0, sizeof(params));
+
+	for (int i = 0; i < CHRC_COUNT; i++) {
+		sys_put_le16(round, chrc_data[i]);
+
+		params[i].attr = CHRC_VALUE_ATTR(i);
+		params[i].data = chrc_data[i];
+		params[i].len = CHRC_SIZE;
+	}
+
+	/* A round which failed part way is sent again, the client ignores the
+	 * values it has already received.
+	 */
+	do {
+		err = bt_gatt_notify_multiple(g_conn, CHRC_COUNT, params);
+
+		if (err == -ENOMEM) {
+			k_sleep(K_MSEC(1));
+		} else if (err) {
+			FAIL("Notify failed (err %d)\n", err);
+		}
+	} while (err == -ENOMEM);
+}
+
+static void test_main(void)
+{
+	int err;
+	const struct bt_data ad[] = {
+		BT_DATA_BYTES(BT_DATA_FLAGS, (BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR)),
+	};
+
+	for (int i = 0; i < CHRC_COUNT; i++) {
+		(void)memset(chrc_data[i], i, CHRC_SIZE);
+	}
+
+	err = bt_enable(NULL);
+	if (err != 0) {
+		FAIL("Bluetooth init failed (err %d)\n", err);
+		return;
+	}
+
+	printk("Bluetooth initialized\n");
+
+	err = bt_le_adv_start(BT_LE_ADV_CONN_NAME, ad, ARRAY_SIZE(ad), NULL, 0);
+	if (err != 0) {
+		FAIL("Advertising failed to start (err %d)\n", err);
+		return;
+	}
+
+	printk("Advertising successfully started\n");
+
+	WAIT_FOR_FLAG(flag_is_connected);
+
+	while (atomic_get(&num_subscribed) < CHRC_COUNT) {
+		k_sleep(K_MSEC(10));
+	}
+
+	printk("Client subscribed, sending %u notifications\n", NOTIFICATION_COUNT);
+
+	for (uint16_t round = 0; round < ROUND_COUNT; round++) {
+		notify_round(round);
+	}
+
+	PASS("GATT server passed\n");
+}
+
+static const struct bst_test_instance test_gatt_server[] = {
+	{
+		.test_id = "gatt_server",
+		.test_post_init_f = test_init,
+		.test_tick_f = test_tick,
+		.test_main_f = test_main,
+	},
+	BSTEST_END_MARKER,
+};
+
+struct bst_test_list *test_gatt_server_install(struct bst_test_list *tests)
+{
+	return bst_add_tests(tests, test_gatt_server);
+}
@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+# Copyright 2022 The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+# Notification rate: same as notify_single.sh, but the client enables Multiple
+# Handle Value Notifications so each round is packed into as few PDUs as the
+# ATT MTU allows. The client reports notifications/s.
+simulation_id="notify_mult_multiple" \
+    client_id="gatt_client_notify_multi" \
+    $(dirname "${BASH_SOURCE[0]}")/_run_test.sh
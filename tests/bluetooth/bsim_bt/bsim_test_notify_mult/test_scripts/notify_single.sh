@@ -0,0 +1,10 @@
+#!/usr/bin/env bash
+# Copyright 2022 The Zephyr Project Contributors
+# SPDX-License-Identifier: Apache-2.0
+
+# Notification rate: the GATT server notifies a few characteristics per round
+# to a client which does not support Multiple Handle Value Notifications, so
+# each value is sent in its own PDU. The client reports notifications/s.
+simulation_id="notify_mult_single" \
+    client_id="gatt_client" \
+    $(dirname "${BASH_SOURCE[0]}")/_run_test.sh
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zephyr/bluetooth/mesh.h>
+
+#include "mesh/net.h"
+#include "mesh/access.h"
+
+#define ELEM_ADDR 0x0001
+#define CID_A     0x1000
+#define CID_B     0x2000
+
+#define OP_A      BT_MESH_MODEL_OP_3(0x01, CID_A)
+/* Same opcode number for both companies, each handled by its own model */
+#define OP_A_2    BT_MESH_MODEL_OP_3(0x02, CID_A)
+#define OP_B_2    BT_MESH_MODEL_OP_3(0x02, CID_B)
+
+static int comp_err;
+static uint32_t handled_a;
+static uint32_t handled_b;
+
+static int handler_a(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf)
+{
+	handled_a++;
+
+	return 0;
+}
+
+static int handler_b(struct bt_mesh_model *model, struct bt_mesh_msg_ctx *ctx,
+		     struct net_buf_simple *buf)
+{
+	handled_b++;
+
+	return 0;
+}
+
+static const struct bt_mesh_model_op ops_a[] = {
+	{ OP_A, BT_MESH_LEN_MIN(0), handler_a },
+	{ OP_A_2, BT_MESH_LEN_MIN(0), handler_a },
+	BT_MESH_MODEL_OP_END,
+};
+
+static const struct bt_mesh_model_op ops_b[] = {
+	{ OP_B_2, BT_MESH_LEN_MIN(0), handler_b },
+	BT_MESH_MODEL_OP_END,
+};
+
+static struct bt_mesh_model vnd_models[] = {
+	BT_MESH_MODEL_VND(CID_A, 0x0001, ops_a, NULL, NULL),
+	BT_MESH_MODEL_VND(CID_B, 0x0001, ops_b, NULL, NULL),
+};
+
+static struct bt_mesh_elem elements[] = {
+	BT_MESH_ELEM(0, BT_MESH_MODEL_NONE, vnd_models),
+};
+
+static const struct bt_mesh_comp comp = {
+	.cid = BT_COMP_ID_LF,
+	.elem = elements,
+	.elem_count = ARRAY_SIZE(elements),
+};
+
+static void deliver(uint32_t opcode)
+{
+	struct bt_mesh_net_rx rx = {
+		.ctx = {
+			.app_idx = 0,
+			.addr = 0x0100,
+			.recv_dst = ELEM_ADDR,
+		},
+	};
+	uint8_t data[3] = { opcode >> 16, opcode & 0xff, (opcode >> 8) & 0xff };
+	struct net_buf_simple buf;
+
+	net_buf_simple_init_with_data(&buf, data, sizeof(data));
+	bt_mesh_model_recv(&rx, &buf);
+}
+
+static void *access_setup(void)
+{
+	/* Every model only handles opcodes of its own company, so the
+	 * composition registers with and without CID_FORCE.
+	 */
+	comp_err = bt_mesh_comp_register(&comp);
+	if (comp_err) {
+		return NULL;
+	}
+
+	bt_mesh_comp_provision(ELEM_ADDR);
+
+	/* Bind every model to the AppKey the messages are sent with */
+	for (size_t i = 0; i < ARRAY_SIZE(vnd_models); i++) {
+		vnd_models[i].keys[0] = 0;
+	}
+
+	return NULL;
+}
+
+static void access_before(void *f)
+{
+	ARG_UNUSED(f);
+
+	zassert_ok(comp_err, "Composition not registered (err %d)", comp_err);
+
+	handled_a = 0;
+	handled_b = 0;
+}
+
+ZTEST(mesh_access, test_own_company)
+{
+	deliver(OP_A);
+
+	zassert_equal(handled_a, 1, "Model A handled %u messages", handled_a);
+	zassert_equal(handled_b, 0, "Model B handled %u messages", handled_b);
+}
+
+ZTEST(mesh_access, test_same_opcode_other_company)
+{
+	deliver(OP_B_2);
+
+	zassert_equal(handled_a, 0, "Model A handled %u messages", handled_a);
+	zassert_equal(handled_b, 1, "Model B handled %u messages", handled_b);
+
+	deliver(OP_A_2);
+
+	zassert_equal(handled_a, 1, "Model A handled %u messages", handled_a);
+	zassert_equal(handled_b, 1, "Model B handled %u messages", handled_b);
+}
+
+ZTEST_SUITE(mesh_access, NULL, access_setup, access_before, NULL, NULL);
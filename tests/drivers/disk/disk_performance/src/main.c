@@ -37,6 +37,8 @@
 #define SEQ_ITERATIONS 10
 /* Number of random reads to get an IOPS calculation */
 #define RANDOM_ITERATIONS SEQ_BLOCK_COUNT
+/* Number of sectors read over and over, like a file system table */
+#define TABLE_SECTORS 4
 
 static uint32_t chosen_sectors[RANDOM_ITERATIONS];
 
@@ -156,6 +158,9 @@ static uint64_t write_helper(uint32_t num_blocks)
 		start_time = timing_counter_get();
 
 		rc = disk_access_write(disk_pdrv, test_buf, 0, num_blocks);
+		zassert_equal(rc, 0, "disk write failed");
+		/* Include the write back of cached sectors */
+		rc = disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL);
 
 		end_time = timing_counter_get();
 
@@ -279,8 +284,10 @@ static void test_random_write(void)
 		rc = disk_access_write(disk_pdrv, &test_buf[i * SECTOR_SIZE],
 			chosen_sectors[i], 1);
 	}
-	end_time = timing_counter_get();
 	zassert_equal(rc, 0, "Random write failed");
+	rc = disk_access_ioctl(disk_pdrv, DISK_IOCTL_CTRL_SYNC, NULL);
+	end_time = timing_counter_get();
+	zassert_equal(rc, 0, "Disk sync failed");
 	cycles = timing_cycles_get(&start_time, &end_time);
 	total_ns = timing_cycles_to_ns(cycles);
 	/* Stop timing system */
@@ -299,6 +306,52 @@ static void test_random_write(void)
 	}
 }
 
+/*
+ * Reads single sectors spread over the disk, each followed by a lookup in
+ * a small table at the start of the disk, as a FAT file system does.
+ */
+static void test_repeated_read(void)
+{
+	timing_t start_time, end_time;
+	uint64_t cycles, total_ns;
+	uint32_t sector;
+	int rc;
+
+	if (!disk_init_done) {
+		zassert_unreachable("Disk is not initialized");
+	}
+
+	for (int i = 0; i < RANDOM_ITERATIONS; i++) {
+		sector = sys_rand32_get() / ((UINT32_MAX / disk_sector_count) + 1);
+		chosen_sectors[i] = sector;
+	}
+
+	/* Start the timing system */
+	timing_init();
+	timing_start();
+
+	start_time = timing_counter_get();
+	for (int i = 0; i < RANDOM_ITERATIONS; i++) {
+		rc = disk_access_read(disk_pdrv, test_buf, i % TABLE_SECTORS, 1);
+		if (rc == 0) {
+			rc = disk_access_read(disk_pdrv, test_buf,
+					      chosen_sectors[i], 1);
+		}
+	}
+	end_time = timing_counter_get();
+	zassert_equal(rc, 0, "Repeated read failed");
+	cycles = timing_cycles_get(&start_time, &end_time);
+	total_ns = timing_cycles_to_ns(cycles);
+	/* Stop timing system */
+	timing_stop();
+
+	TC_PRINT("512 Byte IOPS over %d reads with table lookups: %"PRIu64" IOPS\n",
+		RANDOM_ITERATIONS,
+		((uint64_t)(((uint64_t)RANDOM_ITERATIONS * 2)*
+		((uint64_t)NSEC_PER_SEC)))
+		/ total_ns);
+}
+
 
 
 void test_main(void)
@@ -308,7 +361,8 @@ void test_main(void)
 		ztest_unit_test(test_sequential_read),
 		ztest_unit_test(test_sequential_write),
 		ztest_unit_test(test_random_read),
-		ztest_unit_test(test_random_write)
+		ztest_unit_test(test_random_write),
+		ztest_unit_test(test_repeated_read)
 	);
 
 	ztest_run_test_suite(disk_performance_test);
@@ -0,0 +1,264 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACK_SIZE)
+#define WAIT_US    1000
+
+#define PIPE_XFER  4
+
+K_SEM_DEFINE(sem_s, 0, 1);
+K_MUTEX_DEFINE(mutex_s);
+K_MSGQ_DEFINE(msgq_s, sizeof(uint32_t), 1, 4);
+K_QUEUE_DEFINE(queue_s);
+K_PIPE_DEFINE(pipe_s, 8, 4);
+K_THREAD_STACK_DEFINE(helper_stack, STACK_SIZE);
+
+static struct k_thread helper_thread;
+
+static void sem_taker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_sem_take(&sem_s, K_FOREVER), 0, "sem not taken");
+}
+
+static void mutex_locker(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_mutex_lock(&mutex_s, K_FOREVER), 0, "mutex not locked");
+	zassert_equal(k_mutex_unlock(&mutex_s), 0, "mutex not unlocked");
+}
+
+static void msgq_getter(void *p1, void *p2, void *p3)
+{
+	uint32_t msg;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_msgq_get(&msgq_s, &msg, K_FOREVER), 0,
+		      "message not received");
+}
+
+static void queue_getter(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_not_null(k_queue_get(&queue_s, K_FOREVER), "no data received");
+}
+
+static void pipe_reader(void *p1, void *p2, void *p3)
+{
+	uint8_t buf[PIPE_XFER];
+	size_t read;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	zassert_equal(k_pipe_get(&pipe_s, buf, sizeof(buf), &read, sizeof(buf),
+				 K_FOREVER), 0, "pipe not read");
+	zassert_equal(read, sizeof(buf), "read %zu bytes", read);
+}
+
+/* Start a higher priority helper, which pends on the object right away */
+static void helper_start(k_thread_entry_t entry)
+{
+	k_thread_create(&helper_thread, helper_stack, STACK_SIZE, entry,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()) - 1,
+			0, K_NO_WAIT);
+}
+
+ZTEST(obj_stats, test_obj_stats_sem)
+{
+	struct k_obj_stats stats;
+
+	k_sem_stats_reset(&sem_s);
+
+	helper_start(sem_taker);
+
+	k_sem_stats_get(&sem_s, &stats);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+	zassert_equal(stats.waiters, 1, "waiters %u", stats.waiters);
+	zassert_equal(stats.acquisitions, 0, "acquisitions %u",
+		      stats.acquisitions);
+
+	k_busy_wait(WAIT_US);
+	k_sem_give(&sem_s);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	k_sem_stats_get(&sem_s, &stats);
+	zassert_equal(stats.acquisitions, 1, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.waiters, 0, "waiters %u", stats.waiters);
+	zassert_equal(stats.max_waiters, 1, "max waiters %u",
+		      stats.max_waiters);
+	zassert_true(stats.wait_max > 0, "no wait time recorded");
+	zassert_equal(stats.wait_total, stats.wait_max, "wrong wait total");
+
+	/* Uncontended take */
+	k_sem_give(&sem_s);
+	zassert_equal(k_sem_take(&sem_s, K_NO_WAIT), 0, "sem not taken");
+
+	k_sem_stats_get(&sem_s, &stats);
+	zassert_equal(stats.acquisitions, 2, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+
+	k_sem_stats_reset(&sem_s);
+	k_sem_stats_get(&sem_s, &stats);
+	zassert_equal(stats.acquisitions, 0, "stats not reset");
+	zassert_equal(stats.wait_total, 0, "stats not reset");
+}
+
+ZTEST(obj_stats, test_obj_stats_mutex)
+{
+	struct k_obj_stats stats;
+
+	k_mutex_stats_reset(&mutex_s);
+
+	zassert_equal(k_mutex_lock(&mutex_s, K_NO_WAIT), 0, "mutex not locked");
+	helper_start(mutex_locker);
+
+	k_mutex_stats_get(&mutex_s, &stats);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+	zassert_equal(stats.waiters, 1, "waiters %u", stats.waiters);
+
+	zassert_equal(k_mutex_unlock(&mutex_s), 0, "mutex not unlocked");
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	k_mutex_stats_get(&mutex_s, &stats);
+	zassert_equal(stats.acquisitions, 2, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.waiters, 0, "waiters %u", stats.waiters);
+}
+
+ZTEST(obj_stats, test_obj_stats_msgq)
+{
+	struct k_obj_stats stats;
+	uint32_t msg = 0;
+
+	k_msgq_stats_reset(&msgq_s);
+
+	helper_start(msgq_getter);
+
+	k_msgq_stats_get(&msgq_s, &stats);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+	zassert_equal(stats.waiters, 1, "waiters %u", stats.waiters);
+	zassert_equal(stats.acquisitions, 0, "acquisitions %u",
+		      stats.acquisitions);
+
+	/* The message is handed to the waiting thread */
+	zassert_equal(k_msgq_put(&msgq_s, &msg, K_NO_WAIT), 0, "put failed");
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	k_msgq_stats_get(&msgq_s, &stats);
+	zassert_equal(stats.acquisitions, 1, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.waiters, 0, "waiters %u", stats.waiters);
+
+	/* Uncontended get, a failed one is not counted */
+	zassert_equal(k_msgq_put(&msgq_s, &msg, K_NO_WAIT), 0, "put failed");
+	zassert_equal(k_msgq_get(&msgq_s, &msg, K_NO_WAIT), 0, "get failed");
+	zassert_equal(k_msgq_get(&msgq_s, &msg, K_NO_WAIT), -ENOMSG,
+		      "get from empty msgq");
+
+	k_msgq_stats_get(&msgq_s, &stats);
+	zassert_equal(stats.acquisitions, 2, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+}
+
+ZTEST(obj_stats, test_obj_stats_queue)
+{
+	static struct {
+		void *reserved;
+		uint32_t data;
+	} items[2];
+	struct k_obj_stats stats;
+
+	k_queue_stats_reset(&queue_s);
+
+	helper_start(queue_getter);
+
+	k_queue_stats_get(&queue_s, &stats);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+	zassert_equal(stats.waiters, 1, "waiters %u", stats.waiters);
+
+	/* The data is handed to the waiting thread */
+	k_queue_append(&queue_s, &items[0]);
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	k_queue_stats_get(&queue_s, &stats);
+	zassert_equal(stats.acquisitions, 1, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.waiters, 0, "waiters %u", stats.waiters);
+
+	/* Uncontended get, a failed one is not counted */
+	k_queue_append(&queue_s, &items[1]);
+	zassert_equal_ptr(k_queue_get(&queue_s, K_NO_WAIT), &items[1],
+			  "wrong data");
+	zassert_is_null(k_queue_get(&queue_s, K_NO_WAIT), "get from empty queue");
+
+	k_queue_stats_get(&queue_s, &stats);
+	zassert_equal(stats.acquisitions, 2, "acquisitions %u",
+		      stats.acquisitions);
+	zassert_equal(stats.contended, 1, "contended %u", stats.contended);
+}
+
+ZTEST(obj_stats, test_obj_stats_pipe)
+{
+	uint8_t buf[PIPE_XFER] = { 0 };
+	struct k_obj_stats readers, writers;
+	size_t bytes;
+
+	k_pipe_stats_reset(&pipe_s);
+
+	helper_start(pipe_reader);
+
+	k_pipe_stats_get(&pipe_s, &readers, &writers);
+	zassert_equal(readers.contended, 1, "contended %u", readers.contended);
+	zassert_equal(readers.waiters, 1, "waiters %u", readers.waiters);
+	zassert_equal(readers.acquisitions, 0, "acquisitions %u",
+		      readers.acquisitions);
+
+	/* The data is copied straight to the waiting reader */
+	zassert_equal(k_pipe_put(&pipe_s, buf, sizeof(buf), &bytes, sizeof(buf),
+				 K_NO_WAIT), 0, "put failed");
+	k_thread_join(&helper_thread, K_FOREVER);
+
+	k_pipe_stats_get(&pipe_s, &readers, &writers);
+	zassert_equal(readers.acquisitions, 1, "acquisitions %u",
+		      readers.acquisitions);
+	zassert_equal(readers.waiters, 0, "waiters %u", readers.waiters);
+	zassert_equal(writers.acquisitions, 1, "acquisitions %u",
+		      writers.acquisitions);
+	zassert_equal(writers.contended, 0, "contended %u", writers.contended);
+
+	/* Gets failing right away or after pending are not counted */
+	zassert_equal(k_pipe_get(&pipe_s, buf, sizeof(buf), &bytes, sizeof(buf),
+				 K_NO_WAIT), -EIO, "get from empty pipe");
+	zassert_equal(k_pipe_get(&pipe_s, buf, sizeof(buf), &bytes, sizeof(buf),
+				 K_MSEC(1)), -EAGAIN, "get from empty pipe");
+
+	k_pipe_stats_get(&pipe_s, &readers, &writers);
+	zassert_equal(readers.acquisitions, 1, "acquisitions %u",
+		      readers.acquisitions);
+	zassert_equal(readers.contended, 2, "contended %u", readers.contended);
+	zassert_equal(readers.waiters, 0, "waiters %u", readers.waiters);
+}
+
+ZTEST_SUITE(obj_stats, NULL, NULL, NULL, NULL, NULL);
@@ -539,6 +539,62 @@ void test_thread_stats_usage(void)
 	k_thread_abort(tid);
 }
 
+#ifdef CONFIG_SCHED_THREAD_HISTOGRAMS
+static uint32_t hist_samples(const uint32_t *hist)
+{
+	uint32_t  total = 0;
+
+	for (int i = 0; i < CONFIG_SCHED_THREAD_HISTOGRAM_BUCKETS; i++) {
+		total += hist[i];
+	}
+
+	return total;
+}
+
+/**
+ * @brief Test the k_thread_sched_hist_get/reset APIs
+ *
+ * 1. Reset the main thread's histograms.
+ * 2. Sleep for a tick a few times.
+ *    - Each sleep ends an execution window and each wakeup records
+ *      a ready -> running latency sample.
+ * 3. Reset the histograms again.
+ *    - All buckets are cleared.
+ */
+void test_thread_sched_hist(void)
+{
+	struct k_thread_sched_hist  hist;
+	int  i;
+
+	zassert_equal(k_thread_sched_hist_get(NULL, &hist), -EINVAL, NULL);
+	zassert_equal(k_thread_sched_hist_get(_current, NULL), -EINVAL, NULL);
+
+	k_thread_sched_hist_reset(_current);
+
+	for (i = 0; i < 5; i++) {
+		k_sleep(K_TICKS(1));
+	}
+
+	k_thread_sched_hist_get(_current, &hist);
+
+	zassert_true(hist_samples(hist.wait) >= 5, NULL);
+	zassert_true(hist_samples(hist.run) >= 5, NULL);
+	zassert_true(hist.run_max > 0, NULL);
+
+	k_thread_sched_hist_reset(_current);
+	k_thread_sched_hist_get(_current, &hist);
+
+	zassert_equal(hist_samples(hist.wait), 0, NULL);
+	zassert_equal(hist_samples(hist.run), 0, NULL);
+	zassert_equal(hist.wait_max, 0, NULL);
+	zassert_equal(hist.run_max, 0, NULL);
+}
+#else
+void test_thread_sched_hist(void)
+{
+}
+#endif
+
 /**
  * @brief - main entry point for thread runtime statistics (usage) test
  */
@@ -548,7 +604,8 @@ void test_main(void)
 		 ztest_1cpu_unit_test(test_all_stats_usage),
 		 ztest_1cpu_unit_test(test_thread_stats_enable_disable),
 		 ztest_1cpu_unit_test(test_sys_stats_enable_disable),
-		 ztest_1cpu_unit_test(test_thread_stats_usage)
+		 ztest_1cpu_unit_test(test_thread_stats_usage),
+		 ztest_1cpu_unit_test(test_thread_sched_hist)
 		 );
 	ztest_run_test_suite(usage_api);
 }
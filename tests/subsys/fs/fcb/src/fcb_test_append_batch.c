@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "fcb_test.h"
+
+void test_fcb_append_batch(void)
+{
+	int rc;
+	struct fcb *fcb;
+	struct fcb_batch batch;
+	uint8_t batch_buf[512];
+	uint8_t test_data[128];
+	int i;
+	int j;
+	int var_cnt;
+
+	fcb = &test_fcb;
+
+	fcb_batch_init(&batch, batch_buf, sizeof(batch_buf));
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		for (j = 0; j < i; j++) {
+			test_data[j] = fcb_test_append_data(i, j);
+		}
+		rc = fcb_batch_add(fcb, &batch, test_data, i);
+		if (rc == -ENOMEM) {
+			rc = fcb_batch_commit(fcb, &batch);
+			zassert_true(rc == 0, "fcb_batch_commit call failure");
+			zassert_true(batch.fb_len == 0 && batch.fb_cnt == 0,
+				     "batch not emptied by commit");
+			rc = fcb_batch_add(fcb, &batch, test_data, i);
+		}
+		zassert_true(rc == 0, "fcb_batch_add call failure");
+	}
+	rc = fcb_batch_commit(fcb, &batch);
+	zassert_true(rc == 0, "fcb_batch_commit call failure");
+
+	/* Entries are read back like the ones from fcb_append() */
+	var_cnt = 0;
+	rc = fcb_walk(fcb, 0, fcb_test_data_walk_cb, &var_cnt);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(var_cnt == sizeof(test_data),
+		     "fetched data size not match to wrote data size");
+}
+
+void test_fcb_append_batch_fill(void)
+{
+	int rc;
+	struct fcb *fcb;
+	struct fcb_batch batch;
+	uint8_t batch_buf[1024];
+	uint8_t test_data[128];
+	int elem_cnts[2] = {0, 0};
+	struct append_arg aa = {
+		.elem_cnts = elem_cnts
+	};
+	int added;
+	int i;
+
+	fcb = &test_fcb;
+
+	for (i = 0; i < sizeof(test_data); i++) {
+		test_data[i] = fcb_test_append_data(sizeof(test_data), i);
+	}
+
+	fcb_batch_init(&batch, batch_buf, sizeof(batch_buf));
+
+	/* Fill both sectors, entries spill over to the second one */
+	added = 0;
+	while (1) {
+		while (fcb_batch_add(fcb, &batch, test_data,
+				     sizeof(test_data)) == 0) {
+			added++;
+		}
+		rc = fcb_batch_commit(fcb, &batch);
+		if (rc == -ENOSPC) {
+			break;
+		}
+		zassert_true(rc == 0, "fcb_batch_commit call failure");
+	}
+	zassert_true(batch.fb_cnt > 0, "entries left in batch expected");
+
+	rc = fcb_walk(fcb, NULL, fcb_test_cnt_elems_cb, &aa);
+	zassert_true(rc == 0, "fcb_walk call failure");
+	zassert_true(elem_cnts[0] > 0 && elem_cnts[0] == elem_cnts[1],
+		     "unexpected element counts per sector");
+	zassert_true(elem_cnts[0] + elem_cnts[1] + batch.fb_cnt == added,
+		     "entries lost by fcb_batch_commit");
+
+	/* Make room, the rest of the batch can be committed */
+	rc = fcb_rotate(fcb);
+	zassert_true(rc == 0, "fcb_rotate call failure");
+	rc = fcb_batch_commit(fcb, &batch);
+	zassert_true(rc == 0, "fcb_batch_commit call failure");
+	zassert_true(batch.fb_cnt == 0, "batch not emptied by commit");
+}
@@ -840,6 +840,196 @@ void test_nvs_cache_gc(void)
 #endif
 }
 
+/*
+ * Test that incremental gc empties the oldest sector ahead of time and that
+ * the write which later moves on to it does not erase it again
+ */
+void test_nvs_gc_incremental(void)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	ssize_t len;
+	uint8_t buf[32];
+	uint32_t *flash_erase_stat;
+	uint32_t addr;
+
+	const uint16_t max_id = 10;
+	/* Ids written only in sector 0, they must be moved by the gc */
+	const uint16_t old_id = 100;
+	const uint16_t old_ids = 5;
+	/* 51st write starts sector 2 */
+	const uint16_t max_writes = 51 - old_ids;
+
+	stats_walk(sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	fs.sector_count = 4;
+
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	for (uint16_t i = 0; i < old_ids; i++) {
+		memset(buf, old_id + i, sizeof(buf));
+		len = nvs_write(&fs, old_id + i, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+	}
+
+	write_content(max_id, 0, max_writes, &fs);
+
+	/* sector sequence: closed, closed, write, empty */
+	zassert_equal(fs.ate_wra >> ADDR_SECT_SHIFT, 2,
+		     "unexpected write sector");
+
+	/* A single entry at a time */
+	do {
+		err = nvs_gc_step(&fs, 0);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (err > 0);
+
+	/* sector sequence: empty, closed, write, empty */
+	zassert_equal(fs.ate_wra >> ADDR_SECT_SHIFT, 2,
+		     "unexpected write sector");
+
+	for (addr = 0; addr < fs.sector_size; addr += sizeof(buf)) {
+		err = flash_read(fs.flash_device, fs.offset + addr, buf,
+				 sizeof(buf));
+		zassert_true(err == 0, "flash_read failed: %d", err);
+		for (uint16_t i = 0; i < ARRAY_SIZE(buf); i++) {
+			zassert_equal(buf[i], fs.flash_parameters->erase_value,
+				      "sector 0 not erased");
+		}
+	}
+
+	/* Nothing left to do */
+	err = nvs_gc_step(&fs, 0);
+	zassert_true(err == 0, "unexpected nvs_gc_step result: %d", err);
+
+	check_content(max_id, &fs);
+	for (uint16_t i = 0; i < old_ids; i++) {
+		len = nvs_read(&fs, old_id + i, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf),
+			     "nvs_read unexpected failure: %d", len);
+		zassert_equal(buf[0], (uint8_t)(old_id + i),
+			      "unexpected data for moved entry");
+	}
+
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	zassert_equal(fs.ate_wra >> ADDR_SECT_SHIFT, 2,
+		     "unexpected write sector");
+	check_content(max_id, &fs);
+
+	/* Moving on to sector 3 gc's sector 0 which is already empty */
+	*flash_erase_stat = 0;
+	for (uint16_t i = max_writes; (fs.ate_wra >> ADDR_SECT_SHIFT) != 3;
+	     i++) {
+		write_content(max_id, i, i + 1, &fs);
+	}
+	zassert_equal(*flash_erase_stat, 0, "unexpected sector erase");
+
+	check_content(max_id, &fs);
+	for (uint16_t i = 0; i < old_ids; i++) {
+		len = nvs_read(&fs, old_id + i, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf),
+			     "nvs_read unexpected failure: %d", len);
+	}
+#endif
+}
+
+/*
+ * Test that an erase of incremental gc which is interrupted by a power loss is
+ * redone when mounting, so that the entries left in the sector are not taken
+ * for valid ones
+ */
+void test_nvs_gc_incremental_erase_power_loss(void)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	ssize_t len;
+	uint8_t buf[32];
+	uint32_t *flash_erase_stat;
+	uint32_t *flash_max_erase_calls;
+	uint32_t addr;
+	bool erased;
+	uint16_t cnt;
+
+	const uint16_t max_id = 10;
+	/* Id written in sector 0 and deleted in sector 1 */
+	const uint16_t deleted_id = 100;
+
+	stats_walk(sim_thresholds, flash_sim_max_erase_calls_find,
+		   &flash_max_erase_calls);
+	stats_walk(sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	fs.sector_count = 4;
+
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+
+	memset(buf, deleted_id, sizeof(buf));
+	len = nvs_write(&fs, deleted_id, buf, sizeof(buf));
+	zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+
+	for (cnt = 0; (fs.ate_wra >> ADDR_SECT_SHIFT) != 1; cnt++) {
+		write_content(max_id, cnt, cnt + 1, &fs);
+	}
+
+	err = nvs_delete(&fs, deleted_id);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+
+	for (; (fs.ate_wra >> ADDR_SECT_SHIFT) != 2; cnt++) {
+		write_content(max_id, cnt, cnt + 1, &fs);
+	}
+
+	/* sector sequence: closed, closed, write, empty */
+	while (fs.gc_state != NVS_GC_ERASE) {
+		err = nvs_gc_step(&fs, 0);
+		zassert_true(err > 0, "unexpected nvs_gc_step result: %d", err);
+	}
+	zassert_equal(fs.gc_sector, 0, "unexpected sector collected");
+
+	/* Simulate power down during the erase of sector 0 */
+	*flash_max_erase_calls = *flash_erase_stat + 1;
+	(void)nvs_gc_step(&fs, 0);
+	*flash_max_erase_calls = 0;
+
+	*flash_erase_stat = 0;
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	zassert_equal(*flash_erase_stat, 1, "erase of sector 0 not redone");
+	zassert_equal(fs.ate_wra >> ADDR_SECT_SHIFT, 2,
+		     "unexpected write sector");
+
+	erased = true;
+	for (addr = 0; addr < fs.sector_size; addr += sizeof(buf)) {
+		err = flash_read(fs.flash_device, fs.offset + addr, buf,
+				 sizeof(buf));
+		zassert_true(err == 0, "flash_read failed: %d", err);
+		for (uint16_t i = 0; i < ARRAY_SIZE(buf); i++) {
+			erased &= (buf[i] == fs.flash_parameters->erase_value);
+		}
+	}
+	zassert_true(erased, "sector 0 not erased");
+
+	check_content(max_id, &fs);
+
+	/* Moving on to sector 0 collects sector 1, which holds the delete */
+	for (; (fs.ate_wra >> ADDR_SECT_SHIFT) != 0; cnt++) {
+		write_content(max_id, cnt, cnt + 1, &fs);
+	}
+
+	check_content(max_id, &fs);
+	len = nvs_read(&fs, deleted_id, buf, sizeof(buf));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't found the entry: %d",
+		     len);
+
+	/* A mount with nothing to redo erases nothing */
+	*flash_erase_stat = 0;
+	err = nvs_mount(&fs);
+	zassert_true(err == 0,  "nvs_mount call failure: %d", err);
+	zassert_equal(*flash_erase_stat, 0, "unexpected sector erase");
+#endif
+}
+
 void test_main(void)
 {
 	__ASSERT_NO_MSG(device_is_ready(flash_dev));
@@ -871,7 +1061,12 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_cache_collission, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_cache_gc, setup, teardown)
+				 test_nvs_cache_gc, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_gc_incremental, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_gc_incremental_erase_power_loss,
+				 setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <zephyr/profiling/profiler.h>
+
+#define HOT_SPOT_MAX_SIZE 512
+
+static uint32_t hot_spot_hits;
+
+static void __noinline hot_spot(void)
+{
+	k_busy_wait(100 * USEC_PER_MSEC);
+}
+
+static void count_hot_spot(const uintptr_t *pcs, size_t depth,
+			   uint32_t count, void *user_data)
+{
+	uintptr_t start = (uintptr_t)hot_spot;
+
+	ARG_UNUSED(user_data);
+
+	for (size_t i = 0; i < depth; i++) {
+		if ((pcs[i] >= start) && (pcs[i] < start + HOT_SPOT_MAX_SIZE)) {
+			hot_spot_hits += count;
+			return;
+		}
+	}
+}
+
+static void profiler_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	profiler_reset();
+	hot_spot_hits = 0;
+}
+
+ZTEST(profiler, test_start_stop)
+{
+	zassert_equal(profiler_start(0), -EINVAL, NULL);
+	zassert_equal(profiler_stop(), -EALREADY, NULL);
+	zassert_equal(profiler_start(100), 0, NULL);
+	zassert_equal(profiler_start(100), -EALREADY, NULL);
+	zassert_equal(profiler_stop(), 0, NULL);
+}
+
+/**
+ * @brief Busy loop with the profiler running and check that the samples
+ * point at the busy function.
+ */
+ZTEST(profiler, test_hot_spot)
+{
+	struct profiler_stats stats;
+
+	zassert_equal(profiler_start(CONFIG_SYS_CLOCK_TICKS_PER_SEC), 0, NULL);
+	hot_spot();
+	zassert_equal(profiler_stop(), 0, NULL);
+
+	profiler_stats_get(&stats);
+	profiler_foreach(count_hot_spot, NULL);
+
+	TC_PRINT("samples %u dropped %u missed %u buckets %u hot spot %u\n",
+		 stats.samples, stats.dropped, stats.missed, stats.buckets,
+		 hot_spot_hits);
+
+	zassert_true(stats.samples > 0, "no samples collected");
+	zassert_true(stats.buckets > 0, NULL);
+	zassert_true(hot_spot_hits > stats.samples / 2,
+		     "samples do not point at the busy function");
+
+	profiler_reset();
+	profiler_stats_get(&stats);
+	zassert_equal(stats.samples, 0, NULL);
+	zassert_equal(stats.buckets, 0, NULL);
+}
+
+ZTEST_SUITE(profiler, NULL, NULL, profiler_before, NULL, NULL);
@@ -9,6 +9,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/sys/atomic.h>
 #include <zephyr/rtio/rtio_spsc.h>
+#include <zephyr/rtio/rtio_mpmc.h>
 #include <zephyr/rtio/rtio.h>
 #include <zephyr/rtio/rtio_executor_simple.h>
 #include <zephyr/rtio/rtio_executor_concurrent.h>
@@ -231,6 +232,186 @@ ZTEST(rtio_spsc, test_spsc_threaded)
 	k_thread_join(tinfo[0].tid, K_FOREVER);
 }
 
+/**
+ * @brief Produce and Consume in a mpmc of size 2, including holding
+ * several elements at once
+ *
+ * @see rtio_mpmc_acquire(), rtio_mpmc_produce(), rtio_mpmc_consume(), rtio_mpmc_release()
+ *
+ * @ingroup rtio_tests
+ */
+ZTEST(rtio_mpmc, test_produce_consume_size2)
+{
+	RTIO_MPMC_DEFINE(ezmpmc, uint32_t, 2);
+
+	uint32_t *acq = rtio_mpmc_acquire(&ezmpmc);
+	uint32_t *acq2 = rtio_mpmc_acquire(&ezmpmc);
+
+	zassert_not_null(acq, "Acquire should succeed");
+	zassert_not_null(acq2, "Acquire should succeed");
+	zassert_is_null(rtio_mpmc_acquire(&ezmpmc), "Acquire should fail");
+
+	*acq = 1;
+	*acq2 = 2;
+
+	/* The second element waits for the first one */
+	rtio_mpmc_produce(&ezmpmc, acq2);
+	zassert_is_null(rtio_mpmc_consume(&ezmpmc), "Consume should fail");
+
+	rtio_mpmc_produce(&ezmpmc, acq);
+	zassert_equal(rtio_mpmc_consumable(&ezmpmc), 2, "Consumables should be 2");
+
+	uint32_t *cons = rtio_mpmc_consume(&ezmpmc);
+	uint32_t *cons2 = rtio_mpmc_consume(&ezmpmc);
+
+	zassert_not_null(cons, "Consume should not fail");
+	zassert_not_null(cons2, "Consume should not fail");
+	zassert_equal(*cons, 1, "Consume value should be in order");
+	zassert_equal(*cons2, 2, "Consume value should be in order");
+	zassert_is_null(rtio_mpmc_consume(&ezmpmc), "Consume should fail");
+	zassert_equal(rtio_mpmc_consumable(&ezmpmc), 0, "Consumables should be 0");
+
+	/* Slots are free again once released, in any order */
+	rtio_mpmc_release(&ezmpmc, cons2);
+	zassert_is_null(rtio_mpmc_acquire(&ezmpmc), "Acquire should fail");
+
+	rtio_mpmc_release(&ezmpmc, cons);
+	zassert_not_null(rtio_mpmc_acquire(&ezmpmc), "Acquire should succeed");
+	zassert_not_null(rtio_mpmc_acquire(&ezmpmc), "Acquire should succeed");
+}
+
+/**
+ * @brief Produce and Consume 3 items at a time in a mpmc of size 4 to validate masking
+ * and wrap around reads/writes.
+ */
+ZTEST(rtio_mpmc, test_produce_consume_wrap_around)
+{
+	RTIO_MPMC_DEFINE(ezmpmc, uint32_t, 4);
+
+	for (int i = 0; i < 10; i++) {
+		for (int j = 0; j < 3; j++) {
+			uint32_t *entry = rtio_mpmc_acquire(&ezmpmc);
+
+			zassert_not_null(entry, "Acquire should succeed");
+			*entry = i * 3 + j;
+			rtio_mpmc_produce(&ezmpmc, entry);
+		}
+		zassert_equal(rtio_mpmc_consumable(&ezmpmc), 3, "Consumables should be 3");
+
+		for (int k = 0; k < 3; k++) {
+			uint32_t *entry = rtio_mpmc_consume(&ezmpmc);
+
+			zassert_not_null(entry, "Consume should succeed");
+			zassert_equal(*entry, i * 3 + k, "Consume value should equal i*3+k");
+			rtio_mpmc_release(&ezmpmc, entry);
+		}
+
+		zassert_equal(rtio_mpmc_consumable(&ezmpmc), 0, "Consumables should be 0");
+	}
+}
+
+/**
+ * @brief Ensure that integer wraps continue to work.
+ *
+ * Done by moving the positions, and the turns of their slots, to
+ * UINTPTR_MAX - 2 and writing and reading enough to ensure integer wraps
+ * occur.
+ */
+ZTEST(rtio_mpmc, test_int_wrap_around)
+{
+	RTIO_MPMC_DEFINE(ezmpmc, uint32_t, 4);
+	ezmpmc._mpmc.in = ATOMIC_INIT(UINTPTR_MAX - 2);
+	ezmpmc._mpmc.out = ATOMIC_INIT(UINTPTR_MAX - 2);
+	for (int i = 1; i < 4; i++) {
+		ezmpmc._turns[i] = ATOMIC_INIT(UINTPTR_MAX - 3);
+	}
+
+	for (int j = 0; j < 3; j++) {
+		uint32_t *entry = rtio_mpmc_acquire(&ezmpmc);
+
+		zassert_not_null(entry, "Acquire should succeed");
+		*entry = j;
+		rtio_mpmc_produce(&ezmpmc, entry);
+	}
+
+	zassert_equal(atomic_get(&ezmpmc._mpmc.in), UINTPTR_MAX + 1, "Mpmc in should wrap");
+
+	for (int k = 0; k < 3; k++) {
+		uint32_t *entry = rtio_mpmc_consume(&ezmpmc);
+
+		zassert_not_null(entry, "Consume should succeed");
+		zassert_equal(*entry, k, "Consume value should equal k");
+		rtio_mpmc_release(&ezmpmc, entry);
+	}
+
+	zassert_equal(atomic_get(&ezmpmc._mpmc.out), UINTPTR_MAX + 1, "Mpmc out should wrap");
+}
+
+#define MPMC_THREADS_NUM 4
+
+RTIO_MPMC_DEFINE(mpmc, uint32_t, 4);
+static atomic_t mpmc_consumed;
+static atomic_t mpmc_sum;
+
+static void mpmc_consume(void *p1, void *p2, void *p3)
+{
+	uint32_t *val;
+
+	while (atomic_get(&mpmc_consumed) < SMP_ITERATIONS * MPMC_THREADS_NUM / 2) {
+		val = rtio_mpmc_consume(&mpmc);
+		if (val == NULL) {
+			k_yield();
+			continue;
+		}
+		atomic_add(&mpmc_sum, *val);
+		rtio_mpmc_release(&mpmc, val);
+		atomic_inc(&mpmc_consumed);
+	}
+}
+
+static void mpmc_produce(void *p1, void *p2, void *p3)
+{
+	uint32_t *val;
+
+	for (int i = 1; i <= SMP_ITERATIONS; i++) {
+		val = rtio_mpmc_acquire(&mpmc);
+		while (val == NULL) {
+			k_yield();
+			val = rtio_mpmc_acquire(&mpmc);
+		}
+		*val = i;
+		rtio_mpmc_produce(&mpmc, val);
+	}
+}
+
+static struct k_thread mpmc_thread[MPMC_THREADS_NUM];
+static K_THREAD_STACK_ARRAY_DEFINE(mpmc_stack, MPMC_THREADS_NUM, STACK_SIZE);
+
+/**
+ * @brief Test that several producers and consumers are thread safe
+ *
+ * Every produced value is consumed exactly once. This can and should be
+ * validated on SMP machines.
+ */
+ZTEST(rtio_mpmc, test_mpmc_threaded)
+{
+	for (int i = 0; i < MPMC_THREADS_NUM; i++) {
+		k_thread_create(&mpmc_thread[i], mpmc_stack[i], STACK_SIZE,
+				(i % 2) ? mpmc_produce : mpmc_consume,
+				NULL, NULL, NULL, K_PRIO_PREEMPT(5),
+				K_INHERIT_PERMS, K_NO_WAIT);
+	}
+
+	for (int i = 0; i < MPMC_THREADS_NUM; i++) {
+		k_thread_join(&mpmc_thread[i], K_FOREVER);
+	}
+
+	zassert_equal(atomic_get(&mpmc_sum),
+		      MPMC_THREADS_NUM / 2 * SMP_ITERATIONS * (SMP_ITERATIONS + 1) / 2,
+		      "Every value should be consumed once");
+	zassert_equal(rtio_mpmc_consumable(&mpmc), 0, "Consumables should be 0");
+}
+
 
 RTIO_EXECUTOR_SIMPLE_DEFINE(simple_exec_simp);
 RTIO_DEFINE(r_simple_simp, (struct rtio_executor *)&simple_exec_simp, 4, 4);
@@ -339,6 +520,92 @@ ZTEST(rtio_api, test_rtio_chain)
 }
 
 
+RTIO_EXECUTOR_SIMPLE_DEFINE(chain_fail_exec_simp);
+RTIO_DEFINE(r_chain_fail_simp, (struct rtio_executor *)&chain_fail_exec_simp, 4, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(chain_fail_exec_con, 2);
+RTIO_DEFINE(r_chain_fail_con, (struct rtio_executor *)&chain_fail_exec_con, 4, 4);
+
+struct rtio_iodev_test iodev_test_chain_fail[2];
+
+/**
+ * @brief Test a failed request chained to a transaction
+ *
+ * Ensures every request after the failed one is canceled, including the last
+ * request of the transaction ending the chain, and that the next chain in the
+ * queue still runs.
+ */
+void test_rtio_chain_fail_(struct rtio *r)
+{
+	int res;
+	uintptr_t userdata[4] = {0, 1, 2, 3};
+	int expected[4] = {-ENOTSUP, -ECANCELED, -ECANCELED, 0};
+	bool seen[4] = { 0 };
+	uint8_t buf[1];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	/* Failing head of the chain */
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_transceive(sqe, (struct rtio_iodev *)&iodev_test_chain_fail[0], 0,
+				 buf, buf, sizeof(buf), (void *)userdata[0]);
+	sqe->flags = RTIO_SQE_CHAINED;
+
+	/* Transaction ending the chain */
+	for (int i = 1; i < 3; i++) {
+		sqe = rtio_spsc_acquire(r->sq);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_chain_fail[0],
+				  (void *)userdata[i]);
+		sqe->flags = RTIO_SQE_TRANSACTION;
+	}
+	sqe->flags = 0;
+
+	/* Next chain */
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_chain_fail[1],
+			  (void *)userdata[3]);
+
+	res = rtio_submit(r, 4);
+	zassert_ok(res, "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 4; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+
+		while (cqe == NULL) {
+			k_sleep(K_MSEC(1));
+			cqe = rtio_spsc_consume(r->cq);
+		}
+
+		uintptr_t idx = (uintptr_t)cqe->userdata;
+
+		zassert_true(idx < 4, "Unexpected userdata");
+		zassert_false(seen[idx], "Expected a single completion per request");
+		zassert_equal(cqe->result, expected[idx], "Unexpected result %d for %d",
+			      cqe->result, (int)idx);
+		seen[idx] = true;
+		rtio_spsc_release(r->cq);
+	}
+
+	k_sleep(K_MSEC(50));
+	zassert_equal(rtio_spsc_consumable(r->cq), 0, "Expected no more completions");
+}
+
+ZTEST(rtio_api, test_rtio_chain_fail)
+{
+	for (int i = 0; i < 2; i++) {
+		rtio_iodev_test_init(&iodev_test_chain_fail[i]);
+	}
+
+	TC_PRINT("rtio chain fail simple\n");
+	test_rtio_chain_fail_(&r_chain_fail_simp);
+	TC_PRINT("rtio chain fail concurrent\n");
+	test_rtio_chain_fail_(&r_chain_fail_con);
+}
+
+
 RTIO_EXECUTOR_SIMPLE_DEFINE(multi_exec_simp);
 RTIO_DEFINE(r_multi_simp, (struct rtio_executor *)&multi_exec_simp, 4, 4);
 
@@ -414,6 +681,302 @@ ZTEST(rtio_api, test_rtio_multiple_chains)
 	test_rtio_multiple_chains_(&r_multi_con);
 }
 
+#define MEMPOOL_BLK_SIZE (RTIO_IODEV_TEST_RX_LEN / 2)
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(mempool_exec_simp);
+RTIO_DEFINE_WITH_MEMPOOL(r_mempool_simp, (struct rtio_executor *)&mempool_exec_simp, 4, 4,
+			 4, MEMPOOL_BLK_SIZE, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(mempool_exec_con, 1);
+RTIO_DEFINE_WITH_MEMPOOL(r_mempool_con, (struct rtio_executor *)&mempool_exec_con, 4, 4,
+			 4, MEMPOOL_BLK_SIZE, 4);
+
+struct rtio_iodev_test iodev_test_mempool;
+
+static struct rtio_cqe *test_rtio_mempool_read(struct rtio *r, uintptr_t userdata)
+{
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_read_with_pool(sqe, (struct rtio_iodev *)&iodev_test_mempool,
+				     RTIO_PRIO_NORM, (void *)userdata);
+
+	zassert_ok(rtio_submit(r, 1), "Should return ok from rtio_execute");
+
+	cqe = rtio_spsc_consume(r->cq);
+	zassert_not_null(cqe, "Expected a valid cqe");
+	zassert_equal(cqe->userdata, (void *)userdata, "Expected userdata back");
+
+	return cqe;
+}
+
+/**
+ * @brief Test read requests taking their buffer from the memory pool
+ *
+ * The memory pool holds two buffers, a third read fails until one of them
+ * is given back.
+ */
+void test_rtio_mempool_(struct rtio *r)
+{
+	uint8_t *bufs[2];
+	uint32_t buf_lens[2];
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < 2; i++) {
+		cqe = test_rtio_mempool_read(r, i);
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_not_null(cqe->buf, "Expected a memory pool buffer");
+		zassert_equal(cqe->buf_len, RTIO_IODEV_TEST_RX_LEN, "Unexpected length");
+		for (int j = 0; j < RTIO_IODEV_TEST_RX_LEN; j++) {
+			zassert_equal(cqe->buf[j], j, "Unexpected data");
+		}
+		bufs[i] = cqe->buf;
+		buf_lens[i] = cqe->buf_len;
+		rtio_spsc_release(r->cq);
+	}
+
+	zassert_not_equal(bufs[0], bufs[1], "Expected distinct buffers");
+
+	cqe = test_rtio_mempool_read(r, 2);
+	zassert_equal(cqe->result, -ENOMEM, "Memory pool should be exhausted");
+	zassert_is_null(cqe->buf, "Expected no buffer");
+	rtio_spsc_release(r->cq);
+
+	rtio_release_buffer(r, bufs[0], buf_lens[0]);
+
+	cqe = test_rtio_mempool_read(r, 3);
+	zassert_ok(cqe->result, "Result should be ok");
+	zassert_equal_ptr(cqe->buf, bufs[0], "Expected the given back buffer");
+	rtio_release_buffer(r, cqe->buf, cqe->buf_len);
+	rtio_spsc_release(r->cq);
+
+	rtio_release_buffer(r, bufs[1], buf_lens[1]);
+}
+
+ZTEST(rtio_api, test_rtio_mempool)
+{
+	rtio_iodev_test_init(&iodev_test_mempool);
+
+	TC_PRINT("rtio mempool simple\n");
+	test_rtio_mempool_(&r_mempool_simp);
+	TC_PRINT("rtio mempool concurrent\n");
+	test_rtio_mempool_(&r_mempool_con);
+}
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(multishot_exec_simp);
+RTIO_DEFINE(r_multishot_simp, (struct rtio_executor *)&multishot_exec_simp, 4, 4);
+
+RTIO_EXECUTOR_CONCURRENT_DEFINE(multishot_exec_con, 1);
+RTIO_DEFINE(r_multishot_con, (struct rtio_executor *)&multishot_exec_con, 4, 4);
+
+struct rtio_iodev_test iodev_test_multishot;
+struct rtio_periodic periodic_test;
+
+/* Consume every pending completion, returns their count */
+static int test_rtio_drain_(struct rtio *r, void *userdata)
+{
+	struct rtio_cqe *cqe;
+	int count = 0;
+
+	while ((cqe = rtio_spsc_consume(r->cq)) != NULL) {
+		zassert_equal_ptr(cqe->userdata, userdata, "Expected userdata back");
+		rtio_spsc_release(r->cq);
+		count++;
+	}
+
+	return count;
+}
+
+/* Wait for and consume a successful completion */
+static void test_rtio_consume_ok_(struct rtio *r, void *userdata)
+{
+	struct rtio_cqe *cqe = rtio_spsc_consume(r->cq);
+
+	while (cqe == NULL) {
+		k_sleep(K_MSEC(1));
+		cqe = rtio_spsc_consume(r->cq);
+	}
+
+	zassert_ok(cqe->result, "Result should be ok");
+	zassert_equal_ptr(cqe->userdata, userdata, "Expected userdata back");
+	rtio_spsc_release(r->cq);
+}
+
+/**
+ * @brief Test a multishot request completing several times
+ *
+ * The request stays armed until stopped, then completes one last time.
+ */
+void test_rtio_multishot_(struct rtio *r)
+{
+	int userdata = 0;
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_multishot, &userdata);
+	sqe->flags = RTIO_SQE_MULTISHOT;
+
+	zassert_ok(rtio_submit(r, 3), "Should return ok from rtio_execute");
+
+	for (int i = 0; i < 3; i++) {
+		test_rtio_consume_ok_(r, &userdata);
+	}
+
+	rtio_sqe_multishot_stop(sqe);
+	k_sleep(K_MSEC(50));
+	zassert_true(test_rtio_drain_(r, &userdata) >= 1, "Expected a last completion");
+
+	k_sleep(K_MSEC(50));
+	zassert_equal(test_rtio_drain_(r, &userdata), 0, "Expected the request retired");
+}
+
+ZTEST(rtio_api, test_rtio_multishot)
+{
+	rtio_iodev_test_init(&iodev_test_multishot);
+
+	TC_PRINT("rtio multishot simple\n");
+	test_rtio_multishot_(&r_multishot_simp);
+	TC_PRINT("rtio multishot concurrent\n");
+	test_rtio_multishot_(&r_multishot_con);
+}
+
+/**
+ * @brief Test a request submitted periodically by a timer
+ *
+ * Completions carry the userdata the request was prepared with.
+ */
+void test_rtio_periodic_(struct rtio *r)
+{
+	int userdata = 0;
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_multishot, &userdata);
+	sqe->flags = 0;
+
+	/* Longer than the 10 ms the test iodev takes to complete */
+	zassert_ok(rtio_periodic_start(&periodic_test, r, sqe, K_MSEC(30)),
+		   "Should return ok from rtio_periodic_start");
+
+	for (int i = 0; i < 3; i++) {
+		test_rtio_consume_ok_(r, &userdata);
+	}
+
+	rtio_periodic_stop(&periodic_test);
+	k_sleep(K_MSEC(50));
+	(void)test_rtio_drain_(r, &userdata);
+
+	k_sleep(K_MSEC(50));
+	zassert_equal(test_rtio_drain_(r, &userdata), 0, "Expected the request retired");
+	zassert_equal(periodic_test.overruns, 0, "Expected no overruns");
+}
+
+ZTEST(rtio_api, test_rtio_periodic)
+{
+	rtio_iodev_test_init(&iodev_test_multishot);
+
+	TC_PRINT("rtio periodic simple\n");
+	test_rtio_periodic_(&r_multishot_simp);
+	TC_PRINT("rtio periodic concurrent\n");
+	test_rtio_periodic_(&r_multishot_con);
+}
+
+/**
+ * @brief Test a failed periodic request
+ *
+ * The request is retired with its failure, its timer stops and stopping it
+ * afterwards does nothing.
+ */
+void test_rtio_periodic_fail_(struct rtio *r)
+{
+	int userdata = 0;
+	uint8_t buf[1];
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	sqe = rtio_spsc_acquire(r->sq);
+	zassert_not_null(sqe, "Expected a valid sqe");
+	rtio_sqe_prep_transceive(sqe, (struct rtio_iodev *)&iodev_test_multishot, 0,
+				 buf, buf, sizeof(buf), &userdata);
+	sqe->flags = 0;
+
+	zassert_ok(rtio_periodic_start(&periodic_test, r, sqe, K_MSEC(30)),
+		   "Should return ok from rtio_periodic_start");
+
+	cqe = rtio_spsc_consume(r->cq);
+	while (cqe == NULL) {
+		k_sleep(K_MSEC(1));
+		cqe = rtio_spsc_consume(r->cq);
+	}
+	zassert_equal(cqe->result, -ENOTSUP, "Expected the request to fail");
+	zassert_equal_ptr(cqe->userdata, &userdata, "Expected userdata back");
+	rtio_spsc_release(r->cq);
+
+	k_sleep(K_MSEC(100));
+	zassert_equal(periodic_test.overruns, 0, "Expected the timer stopped");
+
+	rtio_periodic_stop(&periodic_test);
+	k_sleep(K_MSEC(50));
+	zassert_equal(test_rtio_drain_(r, &userdata), 0, "Expected the request retired");
+}
+
+ZTEST(rtio_api, test_rtio_periodic_fail)
+{
+	rtio_iodev_test_init(&iodev_test_multishot);
+
+	TC_PRINT("rtio periodic fail simple\n");
+	test_rtio_periodic_fail_(&r_multishot_simp);
+	TC_PRINT("rtio periodic fail concurrent\n");
+	test_rtio_periodic_fail_(&r_multishot_con);
+}
+
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(mpmc_exec_simp);
+RTIO_DEFINE(r_mpmc_simp, (struct rtio_executor *)&mpmc_exec_simp, 4, 4);
+
+RTIO_MPMC_SQ_DEFINE(mpmc_sq, 4);
+
+struct rtio_iodev_test iodev_test_mpmc;
+
+/**
+ * @brief Test requests prepared in a multiple producer submission queue
+ */
+ZTEST(rtio_api, test_rtio_mpmc_sq)
+{
+	struct rtio_mpmc_sq *mq = (struct rtio_mpmc_sq *)&mpmc_sq;
+	struct rtio *r = &r_mpmc_simp;
+	struct rtio_sqe *sqe;
+	struct rtio_cqe *cqe;
+
+	rtio_iodev_test_init(&iodev_test_mpmc);
+
+	for (uintptr_t i = 0; i < 3; i++) {
+		sqe = rtio_mpmc_acquire(mq);
+		zassert_not_null(sqe, "Expected a valid sqe");
+		rtio_sqe_prep_nop(sqe, (struct rtio_iodev *)&iodev_test_mpmc, (void *)i);
+		sqe->flags = 0;
+		rtio_mpmc_produce(mq, sqe);
+	}
+
+	zassert_equal(rtio_sqe_move_from_mpmc(r, mq), 3, "Expected 3 requests moved");
+	zassert_equal(rtio_mpmc_consumable(mq), 0, "Expected an empty queue");
+
+	zassert_ok(rtio_submit(r, 3), "Should return ok from rtio_execute");
+
+	for (uintptr_t i = 0; i < 3; i++) {
+		cqe = rtio_spsc_consume(r->cq);
+		zassert_not_null(cqe, "Expected a valid cqe");
+		zassert_ok(cqe->result, "Result should be ok");
+		zassert_equal_ptr(cqe->userdata, (void *)i, "Expected in order completions");
+		rtio_spsc_release(r->cq);
+	}
+}
+
 
 ZTEST_SUITE(rtio_spsc, NULL, NULL, NULL, NULL, NULL);
+ZTEST_SUITE(rtio_mpmc, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(rtio_api, NULL, NULL, NULL, NULL, NULL);
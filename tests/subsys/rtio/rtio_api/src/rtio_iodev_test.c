@@ -19,6 +19,31 @@ static void rtio_iodev_timer_fn(struct k_timer *tm)
 	iodev->r = NULL;
 	iodev->sqe = NULL;
 
+	/* Transceive is not supported, used to fail a request */
+	if (sqe->op == RTIO_OP_TXRX) {
+		printk("sqe err callback, not supported\n");
+		rtio_sqe_err(r, sqe, -ENOTSUP);
+		return;
+	}
+
+	if (sqe->op == RTIO_OP_RX) {
+		uint8_t *buf;
+		uint32_t buf_len;
+		int rc;
+
+		rc = rtio_sqe_rx_buf(r, sqe, RTIO_IODEV_TEST_RX_LEN,
+				     RTIO_IODEV_TEST_RX_LEN, &buf, &buf_len);
+		if (rc != 0) {
+			printk("sqe err callback, no buffer\n");
+			rtio_sqe_err(r, sqe, rc);
+			return;
+		}
+
+		for (int i = 0; i < RTIO_IODEV_TEST_RX_LEN; i++) {
+			buf[i] = i;
+		}
+	}
+
 	/* Complete the request with Ok and a result */
 	printk("sqe ok callback\n");
 	rtio_sqe_ok(r, sqe, 0);
@@ -10,6 +10,11 @@
 #ifndef RTIO_IODEV_TEST_H_
 #define RTIO_IODEV_TEST_H_
 
+/*
+ * @brief Number of bytes read by a read request, each set to its index
+ */
+#define RTIO_IODEV_TEST_RX_LEN 16
+
 /*
  * @brief A simple asynchronous testable iodev
  */
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <errno.h>
+#include <ztest.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/i2c.h>
+#include <zephyr/drivers/spi.h>
+#include <zephyr/rtio/rtio.h>
+#include <zephyr/rtio/rtio_executor_simple.h>
+
+/* Register of the emulated EEPROM used by the tests */
+#define EEPROM_REG 0x10
+
+/* BMI160 chip ID register, its read flag and expected value */
+#define BMI160_REG_CHIPID 0x00
+#define BMI160_REG_READ BIT(7)
+#define BMI160_CHIP_ID 0xD1
+
+RTIO_EXECUTOR_SIMPLE_DEFINE(simple_exec);
+RTIO_DEFINE(r_bus, (struct rtio_executor *)&simple_exec, 4, 4);
+
+I2C_DT_IODEV_DEFINE(eeprom_iodev, DT_NODELABEL(i2c_eeprom));
+SPI_DT_IODEV_DEFINE(bmi_iodev, DT_NODELABEL(bmi_spi),
+		    SPI_OP_MODE_MASTER | SPI_WORD_SET(8), 0);
+
+static void check_completions(int count, int result)
+{
+	struct rtio_cqe *cqe;
+
+	for (int i = 0; i < count; i++) {
+		cqe = rtio_cqe_consume(&r_bus);
+		zassert_not_null(cqe, "Expected completion %d", i);
+		zassert_equal(cqe->result, result, "Unexpected result %d",
+			      cqe->result);
+		zassert_equal_ptr(cqe->userdata, (void *)(uintptr_t)i,
+				  "Completions out of order");
+		rtio_spsc_release(r_bus.cq);
+	}
+
+	zassert_is_null(rtio_cqe_consume(&r_bus), "Unexpected completion");
+}
+
+/*
+ * @brief Write a register of an I2C target, then read it back with a
+ * write-then-read transaction
+ */
+ZTEST(rtio_bus, test_i2c_write_read)
+{
+	struct rtio_iodev *iodev = &eeprom_iodev.iodev;
+	uint8_t wr[] = { EEPROM_REG, 0x12, 0x34, 0x56, 0x78 };
+	uint8_t reg = EEPROM_REG;
+	uint8_t rd[4] = { 0 };
+	struct rtio_sqe *sqe;
+
+	zassert_true(device_is_ready(eeprom_iodev.spec.bus), "Bus not ready");
+
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, wr, sizeof(wr),
+			    (void *)0);
+	sqe->flags = 0;
+
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, &reg, 1, (void *)1);
+	sqe->flags = RTIO_SQE_TRANSACTION;
+
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, rd, sizeof(rd),
+			   (void *)2);
+	sqe->flags = 0;
+
+	zassert_ok(rtio_submit(&r_bus, 3), "Submit failed");
+
+	check_completions(3, 0);
+	zassert_mem_equal(rd, &wr[1], sizeof(rd), "Read back wrong data");
+}
+
+/*
+ * @brief A transaction with a request the bus does not support fails as a
+ * whole
+ */
+ZTEST(rtio_bus, test_i2c_transaction_fail)
+{
+	struct rtio_iodev *iodev = &eeprom_iodev.iodev;
+	uint8_t reg = EEPROM_REG;
+	uint8_t rd[1];
+	struct rtio_sqe *sqe;
+
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, &reg, 1, (void *)0);
+	sqe->flags = RTIO_SQE_TRANSACTION;
+
+	/* Full duplex transfers do not exist on I2C */
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_transceive(sqe, iodev, RTIO_PRIO_NORM, &reg, rd, 1,
+				 (void *)1);
+	sqe->flags = 0;
+
+	zassert_ok(rtio_submit(&r_bus, 2), "Submit failed");
+
+	check_completions(2, -ENOTSUP);
+}
+
+/*
+ * @brief Read a register of a SPI peripheral with a write-then-read
+ * transaction, keeping the chip select asserted
+ */
+ZTEST(rtio_bus, test_spi_write_read)
+{
+	struct rtio_iodev *iodev = &bmi_iodev.iodev;
+	uint8_t reg = BMI160_REG_CHIPID | BMI160_REG_READ;
+	uint8_t rd = 0;
+	struct rtio_sqe *sqe;
+
+	zassert_true(device_is_ready(bmi_iodev.spec.bus), "Bus not ready");
+
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_write(sqe, iodev, RTIO_PRIO_NORM, &reg, 1, (void *)0);
+	sqe->flags = RTIO_SQE_TRANSACTION;
+
+	sqe = rtio_spsc_acquire(r_bus.sq);
+	rtio_sqe_prep_read(sqe, iodev, RTIO_PRIO_NORM, &rd, 1, (void *)1);
+	sqe->flags = 0;
+
+	zassert_ok(rtio_submit(&r_bus, 2), "Submit failed");
+
+	check_completions(2, 0);
+	zassert_equal(rd, BMI160_CHIP_ID, "Wrong chip ID 0x%02x", rd);
+}
+
+ZTEST_SUITE(rtio_bus, NULL, NULL, NULL, NULL, NULL);
@@ -162,6 +162,57 @@ static void test_support_rtn(void)
 
 }
 
+SETTINGS_STATIC_HANDLER_DEFINE(lk, "lk", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lk_a, "lk/a", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lk_a_b, "lk/a/b", NULL, NULL, NULL, NULL);
+SETTINGS_STATIC_HANDLER_DEFINE(lk_x, "lk-x", NULL, NULL, NULL, NULL);
+
+/*
+ * Test that the longest handler name matching a key is found, with next
+ * pointing past it, whether handlers are looked up linearly or through the
+ * sorted handler table.
+ */
+static void test_static_lookup(void)
+{
+	struct settings_handler_static *ch;
+	const char *key;
+	const char *next;
+	int rc;
+
+	rc = settings_subsys_init();
+	zassert_true(rc == 0, "subsys init failed");
+
+	key = "lk/a/b/c=";
+	ch = settings_parse_and_lookup(key, &next);
+	zassert_equal_ptr(ch, &settings_handler_lk_a_b, "wrong handler");
+	zassert_equal_ptr(next, key + 7, "wrong next");
+
+	key = "lk/a/c";
+	ch = settings_parse_and_lookup(key, &next);
+	zassert_equal_ptr(ch, &settings_handler_lk_a, "wrong handler");
+	zassert_equal_ptr(next, key + 5, "wrong next");
+
+	key = "lk/a=";
+	ch = settings_parse_and_lookup(key, &next);
+	zassert_equal_ptr(ch, &settings_handler_lk_a, "wrong handler");
+	zassert_is_null(next, "wrong next");
+
+	key = "lk-x/y";
+	ch = settings_parse_and_lookup(key, &next);
+	zassert_equal_ptr(ch, &settings_handler_lk_x, "wrong handler");
+	zassert_equal_ptr(next, key + 5, "wrong next");
+
+	key = "lk/ab";
+	ch = settings_parse_and_lookup(key, &next);
+	zassert_equal_ptr(ch, &settings_handler_lk, "wrong handler");
+	zassert_equal_ptr(next, key + 3, "wrong next");
+
+	key = "lkz/a";
+	ch = settings_parse_and_lookup(key, &next);
+	zassert_is_null(ch, "unexpected handler");
+	zassert_is_null(next, "wrong next");
+}
+
 struct stored_data {
 	uint8_t val1;
 	uint8_t val2;
@@ -618,6 +669,7 @@ void test_main(void)
 	ztest_test_suite(settings_test_suite,
 			 ztest_unit_test(test_clear_settings),
 			 ztest_unit_test(test_support_rtn),
+			 ztest_unit_test(test_static_lookup),
 			 ztest_unit_test(test_register_and_loading),
 			 ztest_unit_test(test_direct_loading),
 			 ztest_unit_test(test_direct_loading_filter)
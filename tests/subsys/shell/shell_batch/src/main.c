@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2022 The Zephyr Project Contributors
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Shell batch mode test suite
+ *
+ */
+
+#include <zephyr/zephyr.h>
+#include <ztest.h>
+
+#include <zephyr/shell/shell.h>
+#include <zephyr/shell/shell_dummy.h>
+
+/* Time given to the shell thread to process pushed input */
+#define PROCESS_TIME_MS 100
+
+static int cmd_test_ok(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "done");
+
+	return 0;
+}
+
+SHELL_CMD_REGISTER(test_ok, NULL, NULL, cmd_test_ok);
+
+static int cmd_test_err(const struct shell *shell, size_t argc, char **argv)
+{
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_error(shell, "failed");
+
+	return -EIO;
+}
+
+SHELL_CMD_REGISTER(test_err, NULL, NULL, cmd_test_err);
+
+/**
+ * Function pushes input to the shell and returns all the output it produced.
+ */
+static const char *batch_run(const char *input)
+{
+	const struct shell *shell = shell_backend_dummy_get_ptr();
+	size_t size;
+
+	shell_backend_dummy_clear_output(shell);
+
+	zassert_equal(shell_backend_dummy_push_input(shell, input,
+						     strlen(input)),
+		      strlen(input), "Input not accepted");
+	k_msleep(PROCESS_TIME_MS);
+
+	return shell_backend_dummy_get_output(shell, &size);
+}
+
+static void test_batch_expect(const char *input, const char *expected)
+{
+	const char *out = batch_run(input);
+
+	zassert_equal(strcmp(out, expected), 0,
+		      "Expected \"%s\", got \"%s\"", expected, out);
+}
+
+static void test_batch_ok(void)
+{
+	/* Neither the command line nor a prompt is echoed */
+	test_batch_expect("test_ok\n", "done\r\nOK\r\n");
+}
+
+static void test_batch_err(void)
+{
+	/* Error output is not colored */
+	test_batch_expect("test_err\n", "failed\r\nERR -5\r\n");
+}
+
+static void test_batch_lines(void)
+{
+	test_batch_expect("test_ok\r\ntest_err\r\n\r\ntest_ok\r\n",
+			  "done\r\nOK\r\nfailed\r\nERR -5\r\ndone\r\nOK\r\n");
+}
+
+static void test_batch_too_long(void)
+{
+	char line[CONFIG_SHELL_CMD_BUFF_SIZE + 2];
+
+	memset(line, 'a', sizeof(line) - 2);
+	line[sizeof(line) - 2] = '\n';
+	line[sizeof(line) - 1] = '\0';
+
+	test_batch_expect(line, "ERR -7\r\n");
+
+	/* The next line is executed normally */
+	test_batch_expect("test_ok\n", "done\r\nOK\r\n");
+}
+
+static void test_batch_off(void)
+{
+	const char *out;
+
+	out = batch_run("shell batch off\n");
+	zassert_equal(strncmp(out, "OK\r\n", 4), 0,
+		      "Unexpected output \"%s\"", out);
+
+	/* Out of batch mode the command line is echoed again */
+	out = batch_run("test_ok\n");
+	zassert_not_null(strstr(out, "test_ok"), "No echo in \"%s\"", out);
+	zassert_not_null(strstr(out, "done"), "No output in \"%s\"", out);
+	zassert_is_null(strstr(out, "OK"), "Status line in \"%s\"", out);
+}
+
+void test_main(void)
+{
+	const struct shell *shell = shell_backend_dummy_get_ptr();
+
+	/* Let the shell thread finish its initialization */
+	k_msleep(PROCESS_TIME_MS);
+
+	zassert_equal(shell_batch_mode_set(shell, true), 0,
+		      "Batch mode already enabled");
+
+	ztest_test_suite(shell_batch_test_suite,
+			ztest_unit_test(test_batch_ok),
+			ztest_unit_test(test_batch_err),
+			ztest_unit_test(test_batch_lines),
+			ztest_unit_test(test_batch_too_long),
+			ztest_unit_test(test_batch_off)
+			);
+
+	ztest_run_test_suite(shell_batch_test_suite);
+}
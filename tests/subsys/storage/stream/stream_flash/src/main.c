@@ -463,6 +463,235 @@ static void test_stream_flash_buffered_write_whole_page(void)
 }
 #endif
 
+#ifdef CONFIG_STREAM_FLASH_BACKGROUND
+static uint8_t bg_buf[BUF_LEN * CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS];
+
+static void test_stream_flash_background_write(void)
+{
+	int rc;
+	size_t len = page_size * 2 + 128;
+
+	init_target();
+
+	rc = stream_flash_init_background(&ctx, fdev, bg_buf, sizeof(bg_buf),
+					  FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Odd sized writes, so slots fill up in the middle of a write */
+	for (size_t i = 0; i < len; i += 100) {
+		rc = stream_flash_buffered_write(&ctx, write_buf,
+						 MIN(100, len - i), false);
+		zassert_equal(rc, 0, "expected success");
+	}
+
+	rc = stream_flash_buffered_write(&ctx, NULL, 0, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), len,
+		      "all bytes should be written after flush");
+
+	VERIFY_WRITTEN(0, len);
+	VERIFY_ERASED(len, page_size - 128);
+
+	/* Slots must not be larger than a page */
+	rc = stream_flash_init_background(&ctx, fdev, bg_buf,
+			page_size * 2 * CONFIG_STREAM_FLASH_BACKGROUND_BUFFERS,
+			FLASH_BASE, 0, NULL);
+	zassert_true(rc < 0, "expected failure");
+}
+
+static void test_stream_flash_background_error(void)
+{
+	int rc;
+
+	init_target();
+
+	struct device fake_dev = *ctx.fdev;
+	struct flash_driver_api fake_api = *(struct flash_driver_api *)ctx.fdev->api;
+
+	fake_api.write = bad_write;
+	fake_dev.api = &fake_api;
+
+	rc = stream_flash_init_background(&ctx, &fake_dev, bg_buf,
+					  sizeof(bg_buf), FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Queueing the first slot does not wait for it to be written */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_true(rc == 0 || rc == -EINVAL, "unexpected result %d", rc);
+
+	/* The failed background write is reported by the flush */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 16, true);
+	zassert_equal(rc, -EINVAL, "expected failure from background write");
+	zassert_equal(stream_flash_bytes_written(&ctx), 0,
+		      "Expected bytes_written not modified");
+
+	/* And by any later write */
+	rc = stream_flash_buffered_write(&ctx, write_buf, 16, false);
+	zassert_equal(rc, -EINVAL, "expected failure from background write");
+}
+
+static void test_stream_flash_background_reinit(void)
+{
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_init_background(&ctx, fdev, bg_buf, sizeof(bg_buf),
+					  FLASH_BASE, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The test thread is cooperative, the slot is not written yet */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The queued slot is dropped */
+	rc = stream_flash_init_background(&ctx, fdev, bg_buf, sizeof(bg_buf),
+					  FLASH_BASE + page_size, 0, NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_buffered_write(&ctx, write_buf, 16, true);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stream_flash_bytes_written(&ctx), 16,
+		      "expected only the new data written");
+
+	VERIFY_ERASED(0, page_size);
+	VERIFY_WRITTEN(page_size, 16);
+}
+#else
+static void test_stream_flash_background_write(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_background_error(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_background_reinit(void)
+{
+	ztest_test_skip();
+}
+#endif
+
+#ifdef CONFIG_STREAM_FLASH_PRE_ERASE
+static void wait_pre_erase(struct stream_flash_pre_erase_stats *stats)
+{
+	int rc;
+
+	for (int i = 0; i < 1000; i++) {
+		rc = stream_flash_pre_erase_stats_get(&ctx, stats);
+		zassert_equal(rc, 0, "expected success");
+		if (!stats->active) {
+			return;
+		}
+		k_msleep(1);
+	}
+
+	zassert_unreachable("pre-erase did not complete");
+}
+
+static void test_stream_flash_pre_erase(void)
+{
+	struct stream_flash_pre_erase_stats stats;
+	size_t size = page_size * MAX_NUM_PAGES;
+	int rc;
+
+	init_target();
+
+	/* Dirty the area first */
+	rc = flash_write(fdev, FLASH_BASE, write_buf, size);
+	zassert_equal(rc, 0, "should succeed");
+
+	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, size,
+			       NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_pre_erase_start(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	/* The test thread is cooperative, the pre-erase did not run yet */
+	rc = stream_flash_pre_erase_start(&ctx);
+	zassert_equal(rc, -EALREADY, "expected pre-erase to be running");
+
+	wait_pre_erase(&stats);
+	zassert_equal(stats.error, 0, "expected no error");
+	zassert_equal(stats.total, size, "expected whole area");
+	zassert_equal(stats.erased, size, "expected whole area erased");
+	VERIFY_ERASED(0, size);
+
+	/* Writes to pages erased ahead do not erase them again */
+	rc = stream_flash_buffered_write(&ctx, write_buf, page_size * 2, true);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_pre_erase_stats_get(&ctx, &stats);
+	zassert_equal(rc, 0, "expected success");
+	zassert_equal(stats.hits, 2, "expected both pages erased ahead");
+	zassert_equal(stats.misses, 0, "expected no erase by the writes");
+
+	VERIFY_WRITTEN(0, page_size * 2);
+	VERIFY_ERASED(page_size * 2, page_size * 2);
+}
+
+static void test_stream_flash_pre_erase_stop(void)
+{
+	struct stream_flash_pre_erase_stats stats;
+	size_t size = page_size * MAX_NUM_PAGES;
+	int rc;
+
+	init_target();
+
+	rc = stream_flash_init(&ctx, fdev, buf, BUF_LEN, FLASH_BASE, size,
+			       NULL);
+	zassert_equal(rc, 0, "expected success");
+
+	/* Start past the first page, which holds data */
+	rc = stream_flash_buffered_write(&ctx, write_buf, BUF_LEN, false);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_pre_erase_start(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_pre_erase_stop(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	rc = stream_flash_pre_erase_stats_get(&ctx, &stats);
+	zassert_equal(rc, 0, "expected success");
+	zassert_false(stats.active, "expected pre-erase to be stopped");
+	zassert_equal(stats.total, size - page_size,
+		      "expected the page holding data to be left out");
+	zassert_equal(stats.erased, 0, "expected nothing erased");
+
+	/* Writes erase the pages themselves once stopped */
+	rc = stream_flash_buffered_write(&ctx, write_buf,
+					 page_size * 2 - BUF_LEN, true);
+	zassert_equal(rc, 0, "expected success");
+	VERIFY_WRITTEN(0, page_size * 2);
+
+	/* Starting again picks up after the written pages */
+	rc = stream_flash_pre_erase_start(&ctx);
+	zassert_equal(rc, 0, "expected success");
+
+	wait_pre_erase(&stats);
+	zassert_equal(stats.error, 0, "expected no error");
+	zassert_equal(stats.total, size - page_size * 2,
+		      "expected the pages holding data to be left out");
+	zassert_equal(stats.erased, stats.total, "expected the rest erased");
+	VERIFY_WRITTEN(0, page_size * 2);
+	VERIFY_ERASED(page_size * 2, size - page_size * 2);
+}
+#else
+static void test_stream_flash_pre_erase(void)
+{
+	ztest_test_skip();
+}
+
+static void test_stream_flash_pre_erase_stop(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 static size_t write_and_save_progress(size_t bytes, const char *save_key)
 {
 	int rc;
@@ -665,6 +894,11 @@ void test_main(void)
 	     ztest_unit_test(test_stream_flash_buffered_write_whole_page),
 	     ztest_unit_test(test_stream_flash_erase_page),
 	     ztest_unit_test(test_stream_flash_bytes_written),
+	     ztest_unit_test(test_stream_flash_background_write),
+	     ztest_unit_test(test_stream_flash_background_error),
+	     ztest_unit_test(test_stream_flash_background_reinit),
+	     ztest_unit_test(test_stream_flash_pre_erase),
+	     ztest_unit_test(test_stream_flash_pre_erase_stop),
 	     ztest_unit_test(test_stream_flash_progress_api),
 	     ztest_unit_test(test_stream_flash_progress_resume),
 	     ztest_unit_test(test_stream_flash_progress_clear)